@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ChannelInterleaver.h"
+
+/* Depth 16 interleavers over 64 KiB frames. */
+template <typename T>
+void BlockInterleaver_Interleave(benchmark::State& state) {
+    using TestInterleaver = Thiemar::ChannelInterleaver::BlockInterleaver<16u,
+        std::is_same<T, bool>::value ? 32768u : 4096u, T>;
+
+    /* Set up test buffers. */
+    std::vector<uint8_t> test_in(TestInterleaver::size());
+    std::vector<uint8_t> test_out(TestInterleaver::size());
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        TestInterleaver::interleave(test_in.data(), test_out.data());
+        benchmark::DoNotOptimize(test_out.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * TestInterleaver::size());
+}
+
+BENCHMARK_TEMPLATE(BlockInterleaver_Interleave, uint8_t);
+BENCHMARK_TEMPLATE(BlockInterleaver_Interleave, bool);
+
+void ConvolutionalInterleaver_Interleave(benchmark::State& state) {
+    Thiemar::ChannelInterleaver::ConvolutionalInterleaver<16u, 256u> interleaver;
+
+    /* Set up test buffers. */
+    std::vector<uint8_t> test_in(65536u);
+    std::vector<uint8_t> test_out(test_in.size());
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        interleaver.process(test_in.data(), test_in.size(), test_out.data());
+        benchmark::DoNotOptimize(test_out.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * test_in.size());
+}
+
+BENCHMARK(ConvolutionalInterleaver_Interleave);
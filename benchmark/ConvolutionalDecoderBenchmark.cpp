@@ -131,3 +131,169 @@ void PuncturedConvolutionalDecoder_Decode(benchmark::State& state) {
 }
 
 BENCHMARK(PuncturedConvolutionalDecoder_Decode);
+
+/* Throughput of the hard-decision decoder as the constraint length grows. */
+template <std::size_t ConstraintLength, typename Poly1, typename Poly2>
+void ConvolutionalDecoder_DecodeConstraintLength(benchmark::State& state) {
+    using Encoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+        ConstraintLength,
+        Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+        Poly1,
+        Poly2
+    >;
+    using Decoder = Thiemar::Convolutional::PuncturedHardDecisionViterbiDecoder<
+        ConstraintLength,
+        64u,
+        Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+        Poly1,
+        Poly2
+    >;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+    std::array<uint8_t, Decoder::calculate_output_length(
+        Encoder::calculate_output_length(test_in.size()))> test_decoded = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = Encoder::encode(test_in);
+
+    while(state.KeepRunning()) {
+        test_decoded = Decoder::decode(test_out);
+    }
+}
+
+BENCHMARK_TEMPLATE(ConvolutionalDecoder_DecodeConstraintLength, 7u,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11, Thiemar::Convolutional::Polynomials::n_2_k_7_g12);
+BENCHMARK_TEMPLATE(ConvolutionalDecoder_DecodeConstraintLength, 8u,
+    Thiemar::Convolutional::Polynomials::n_2_k_8_g11, Thiemar::Convolutional::Polynomials::n_2_k_8_g12);
+BENCHMARK_TEMPLATE(ConvolutionalDecoder_DecodeConstraintLength, 9u,
+    Thiemar::Convolutional::Polynomials::n_2_k_9_g11, Thiemar::Convolutional::Polynomials::n_2_k_9_g12);
+BENCHMARK_TEMPLATE(ConvolutionalDecoder_DecodeConstraintLength, 10u,
+    Thiemar::Convolutional::Polynomials::n_2_k_10_g11, Thiemar::Convolutional::Polynomials::n_2_k_10_g12);
+BENCHMARK_TEMPLATE(ConvolutionalDecoder_DecodeConstraintLength, 11u,
+    Thiemar::Convolutional::Polynomials::n_2_k_11_g11, Thiemar::Convolutional::Polynomials::n_2_k_11_g12);
+
+using TestBCJRDecoder = Thiemar::Convolutional::PuncturedBCJRDecoder<
+    7u,
+    32u,
+    Thiemar::Convolutional::BCJR::MaxLogMAP,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+    Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+    Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+>;
+
+void BCJRDecoder_Decode(benchmark::State& state) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+    std::array<float, TestBCJRDecoder::calculate_input_length(test_in.size())> test_llr = {};
+    std::array<float, test_in.size() * 8u> test_decoded = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoder::encode(test_in);
+    for (std::size_t i = 0u; i < test_out.size() * 8u; i++) {
+        test_llr[i] = (test_out[i / 8u] & (0x80u >> (i % 8u))) ? -1.0f : 1.0f;
+    }
+
+    while(state.KeepRunning()) {
+        test_decoded = TestBCJRDecoder::decode<test_in.size()>(test_llr);
+    }
+}
+
+BENCHMARK(BCJRDecoder_Decode);
+
+template <typename PuncturingMatrix>
+using TestSoftDecoder = Thiemar::Convolutional::PuncturedSoftDecisionViterbiDecoder<
+    7u,
+    112u,
+    PuncturingMatrix,
+    Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+    Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+>;
+
+template <typename PuncturingMatrix>
+void SoftDecisionDecoder_Decode(benchmark::State& state) {
+    using Encoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+        7u,
+        PuncturingMatrix,
+        Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+        Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+    >;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+    std::array<int8_t, Encoder::calculate_output_length(test_in.size()) * 8u> test_llr = {};
+    std::array<uint8_t, TestSoftDecoder<PuncturingMatrix>::calculate_output_length(test_llr.size())> test_decoded = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = Encoder::encode(test_in);
+    for (std::size_t i = 0u; i < test_llr.size(); i++) {
+        test_llr[i] = (test_out[i / 8u] & (0x80u >> (i % 8u))) ? -64 : 64;
+    }
+
+    while(state.KeepRunning()) {
+        test_decoded = TestSoftDecoder<PuncturingMatrix>::decode(test_llr);
+    }
+}
+
+BENCHMARK_TEMPLATE(SoftDecisionDecoder_Decode, Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2);
+BENCHMARK_TEMPLATE(SoftDecisionDecoder_Decode, Thiemar::Convolutional::PuncturingMatrices::n_2_rate_7_8);
+
+template <std::size_t ListSize>
+using TestListDecoder = Thiemar::Convolutional::PuncturedListViterbiDecoder<
+    7u,
+    ListSize,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_2_3,
+    Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+    Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+>;
+
+template <std::size_t ListSize>
+void ListViterbiDecoder_Decode(benchmark::State& state) {
+    using Encoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+        7u,
+        Thiemar::Convolutional::PuncturingMatrices::n_2_rate_2_3,
+        Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+        Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+    >;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 40u> test_in = {};
+    std::array<int8_t, TestListDecoder<ListSize>::calculate_input_length(test_in.size())> test_llr = {};
+    std::array<uint8_t, test_in.size()> test_decoded = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = Encoder::encode(test_in);
+    for (std::size_t i = 0u; i < test_llr.size(); i++) {
+        test_llr[i] = (test_out[i / 8u] & (0x80u >> (i % 8u))) ? -64 : 64;
+    }
+
+    /* No candidate passes the check, so every path in the list is traced back. */
+    while(state.KeepRunning()) {
+        test_decoded = TestListDecoder<ListSize>::template decode<test_in.size()>(test_llr,
+            [](const auto &) { return false; });
+    }
+}
+
+BENCHMARK_TEMPLATE(ListViterbiDecoder_Decode, 1u);
+BENCHMARK_TEMPLATE(ListViterbiDecoder_Decode, 4u);
+BENCHMARK_TEMPLATE(ListViterbiDecoder_Decode, 8u);
@@ -100,3 +100,131 @@ void FECMagicPuncturedConvolutionalEncoder_Encode(benchmark::State& state) {
 }
 
 BENCHMARK(FECMagicPuncturedConvolutionalEncoder_Encode);
+
+/*
+Compare the table-driven encoder with the reference and fecmagic encoders
+for each of the standard puncturing matrices.
+*/
+template <typename PuncturingMatrix>
+struct FECMagicPuncturingMatrix;
+
+template <bool... Bits>
+struct FECMagicPuncturingMatrix<Thiemar::BinarySequence<Bits...>> {
+    using type = fecmagic::Sequence<uint8_t, Bits...>;
+};
+
+template <typename PuncturingMatrix>
+using TestEncoder_n_2 = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    PuncturingMatrix,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+template <typename PuncturingMatrix>
+using TestTableEncoder_n_2 = Thiemar::Convolutional::PuncturedTableConvolutionalEncoder<
+    7u,
+    PuncturingMatrix,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+template <typename PuncturingMatrix>
+using FECMagicEncoder_n_2 = fecmagic::PuncturedConvolutionalEncoder<
+    typename FECMagicPuncturingMatrix<PuncturingMatrix>::type, 7, uint8_t, 0b1100111, 0b1011101>;
+
+using TestEncoder_n_3 = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_3_rate_1_3,
+    Thiemar::Convolutional::Polynomials::n_3_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_3_k_7_g12,
+    Thiemar::Convolutional::Polynomials::n_3_k_7_g13
+>;
+
+using TestTableEncoder_n_3 = Thiemar::Convolutional::PuncturedTableConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_3_rate_1_3,
+    Thiemar::Convolutional::Polynomials::n_3_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_3_k_7_g12,
+    Thiemar::Convolutional::Polynomials::n_3_k_7_g13
+>;
+
+using FECMagicEncoder_n_3 = fecmagic::PuncturedConvolutionalEncoder<
+    FECMagicPuncturingMatrix<Thiemar::Convolutional::PuncturingMatrices::n_3_rate_1_3>::type,
+    7, uint8_t, 0b1001111, 0b1010111, 0b1101101>;
+
+template <typename Encoder>
+void ConvolutionalEncoder_EncodeMatrix(benchmark::State& state) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+    std::array<uint8_t, Encoder::calculate_output_length(test_in.size())> test_out = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < sizeof(test_in); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        test_out = Encoder::encode(test_in);
+        benchmark::DoNotOptimize(test_out);
+    }
+}
+
+template <typename FECMagicEncoder, typename Encoder>
+void FECMagicConvolutionalEncoder_EncodeMatrix(benchmark::State& state) {
+    FECMagicEncoder fecmagic_enc;
+
+    /* Set up test buffers. */
+    uint8_t test_in[1024u] = {};
+    uint8_t test_out[Encoder::calculate_output_length(sizeof(test_in))] = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < sizeof(test_in); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        fecmagic_enc.reset(test_out);
+        fecmagic_enc.encode(test_in, sizeof(test_in));
+        fecmagic_enc.flush();
+    }
+}
+
+using Rate_1_2 = Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2;
+using Rate_2_3 = Thiemar::Convolutional::PuncturingMatrices::n_2_rate_2_3;
+using Rate_3_4 = Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4;
+using Rate_5_6 = Thiemar::Convolutional::PuncturingMatrices::n_2_rate_5_6;
+using Rate_7_8 = Thiemar::Convolutional::PuncturingMatrices::n_2_rate_7_8;
+
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestEncoder_n_2<Rate_1_2>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestTableEncoder_n_2<Rate_1_2>);
+BENCHMARK_TEMPLATE2(FECMagicConvolutionalEncoder_EncodeMatrix, FECMagicEncoder_n_2<Rate_1_2>, TestEncoder_n_2<Rate_1_2>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestEncoder_n_2<Rate_2_3>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestTableEncoder_n_2<Rate_2_3>);
+BENCHMARK_TEMPLATE2(FECMagicConvolutionalEncoder_EncodeMatrix, FECMagicEncoder_n_2<Rate_2_3>, TestEncoder_n_2<Rate_2_3>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestEncoder_n_2<Rate_3_4>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestTableEncoder_n_2<Rate_3_4>);
+BENCHMARK_TEMPLATE2(FECMagicConvolutionalEncoder_EncodeMatrix, FECMagicEncoder_n_2<Rate_3_4>, TestEncoder_n_2<Rate_3_4>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestEncoder_n_2<Rate_5_6>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestTableEncoder_n_2<Rate_5_6>);
+BENCHMARK_TEMPLATE2(FECMagicConvolutionalEncoder_EncodeMatrix, FECMagicEncoder_n_2<Rate_5_6>, TestEncoder_n_2<Rate_5_6>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestEncoder_n_2<Rate_7_8>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestTableEncoder_n_2<Rate_7_8>);
+BENCHMARK_TEMPLATE2(FECMagicConvolutionalEncoder_EncodeMatrix, FECMagicEncoder_n_2<Rate_7_8>, TestEncoder_n_2<Rate_7_8>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestEncoder_n_3);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestTableEncoder_n_3);
+BENCHMARK_TEMPLATE2(FECMagicConvolutionalEncoder_EncodeMatrix, FECMagicEncoder_n_3, TestEncoder_n_3);
+
+template <typename PuncturingMatrix>
+using TestRecursiveSystematicEncoder = Thiemar::Convolutional::PuncturedRecursiveSystematicEncoder<
+    7u,
+    PuncturingMatrix,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestRecursiveSystematicEncoder<Rate_1_2>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestRecursiveSystematicEncoder<Rate_3_4>);
+BENCHMARK_TEMPLATE(ConvolutionalEncoder_EncodeMatrix, TestRecursiveSystematicEncoder<Rate_7_8>);
@@ -0,0 +1,67 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ErasureCode.h"
+#include "FEC/ReedSolomon.h"
+
+#define DATA_SHARDS 10u
+#define PARITY_SHARDS 4u
+
+using TestCoder = Thiemar::ErasureCode::CauchyErasureCoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, DATA_SHARDS, PARITY_SHARDS>;
+
+static std::vector<std::vector<uint8_t>> make_shards(std::size_t len) {
+    std::vector<std::vector<uint8_t>> shards(DATA_SHARDS + PARITY_SHARDS, std::vector<uint8_t>(len));
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < DATA_SHARDS; i++) {
+        for (std::size_t j = 0u; j < len; j++) {
+            shards[i][j] = std::rand() & 0xffu;
+        }
+    }
+
+    return shards;
+}
+
+void ErasureCode_Encode(benchmark::State& state) {
+    auto shards = make_shards(state.range(0));
+    std::vector<uint8_t *> pointers;
+    for (auto &shard : shards) {
+        pointers.push_back(shard.data());
+    }
+
+    while(state.KeepRunning()) {
+        TestCoder::encode(pointers.data(), &pointers[DATA_SHARDS], state.range(0));
+        benchmark::DoNotOptimize(pointers[DATA_SHARDS]);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * DATA_SHARDS);
+}
+
+BENCHMARK(ErasureCode_Encode)->Arg(1024)->Arg(65536)->Arg(1048576);
+
+/* Recover the first PARITY_SHARDS data shards, with the inverse matrix cached after the first iteration. */
+void ErasureCode_Reconstruct(benchmark::State& state) {
+    auto shards = make_shards(state.range(0));
+    std::vector<uint8_t *> pointers;
+    for (auto &shard : shards) {
+        pointers.push_back(shard.data());
+    }
+
+    TestCoder::encode(pointers.data(), &pointers[DATA_SHARDS], state.range(0));
+
+    TestCoder coder;
+    bool present[DATA_SHARDS + PARITY_SHARDS];
+    std::fill_n(present, DATA_SHARDS + PARITY_SHARDS, true);
+    std::fill_n(present, PARITY_SHARDS, false);
+
+    while(state.KeepRunning()) {
+        coder.reconstruct(pointers.data(), present, state.range(0));
+        benchmark::DoNotOptimize(pointers[0u]);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * DATA_SHARDS);
+}
+
+BENCHMARK(ErasureCode_Reconstruct)->Arg(1024)->Arg(65536)->Arg(1048576);
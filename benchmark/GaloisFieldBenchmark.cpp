@@ -0,0 +1,111 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/GaloisField.h"
+#include "FEC/CarrylessGaloisField.h"
+#include "FEC/ReedSolomon.h"
+
+using GF256 = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+using GF1024 = Thiemar::GaloisField<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>>;
+using GF65536 = Thiemar::GaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+
+/* Table-free fields, using carry-less multiplication. */
+using CarrylessGF256 = Thiemar::CarrylessGaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+using CarrylessGF65536 = Thiemar::CarrylessGaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+using CarrylessGF2_32 = Thiemar::CarrylessGaloisField<32u, Thiemar::CarrylessPolynomials::m_32>;
+using CarrylessGF2_64 = Thiemar::CarrylessGaloisField<64u, Thiemar::CarrylessPolynomials::m_64>;
+
+template <typename TestGaloisField>
+std::vector<typename TestGaloisField::gf_t> make_region(std::size_t len, std::size_t m) {
+    std::vector<typename TestGaloisField::gf_t> region(len);
+
+    for (std::size_t i = 0u; i < region.size(); i++) {
+        uint64_t r = 0u;
+        for (std::size_t b = 0u; b < m; b += 16u) {
+            r = (r << 16u) ^ (std::rand() & 0xffffu);
+        }
+
+        region[i] = (m < 64u) ? (r & (((uint64_t)1u << m) - 1u)) : r;
+    }
+
+    return region;
+}
+
+/* Element-wise multiply-add using log/antilog lookups, for comparison with the region operation. */
+template <typename TestGaloisField, std::size_t M>
+void GaloisField_MultiplyAdd(benchmark::State& state) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    auto src = make_region<TestGaloisField>(state.range(0), M);
+    auto dst = make_region<TestGaloisField>(state.range(0), M);
+
+    while(state.KeepRunning()) {
+        for (std::size_t i = 0u; i < src.size(); i++) {
+            dst[i] ^= TestGaloisField::multiply(src[i], 142u);
+        }
+
+        benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * src.size() * sizeof(src[0]));
+}
+
+template <typename TestGaloisField, std::size_t M>
+void GaloisField_MulAddRegion(benchmark::State& state) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    auto src = make_region<TestGaloisField>(state.range(0), M);
+    auto dst = make_region<TestGaloisField>(state.range(0), M);
+
+    while(state.KeepRunning()) {
+        TestGaloisField::mul_add_region(dst.data(), src.data(), 142u, src.size());
+        benchmark::DoNotOptimize(dst.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * src.size() * sizeof(src[0]));
+}
+
+template <typename TestGaloisField, std::size_t M>
+void GaloisField_Dot(benchmark::State& state) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    auto x = make_region<TestGaloisField>(state.range(0), M);
+    auto y = make_region<TestGaloisField>(state.range(0), M);
+
+    while(state.KeepRunning()) {
+        benchmark::DoNotOptimize(TestGaloisField::dot(x.data(), y.data(), x.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * x.size() * sizeof(x[0]));
+}
+
+/* Horner evaluation of a polynomial with one coefficient per element. */
+template <typename TestGaloisField, std::size_t M>
+void GaloisField_Evaluate(benchmark::State& state) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    auto poly = make_region<TestGaloisField>(state.range(0), M);
+
+    while(state.KeepRunning()) {
+        benchmark::DoNotOptimize(TestGaloisField::evaluate(poly.data(), poly.size(), 142u));
+    }
+
+    state.SetBytesProcessed(state.iterations() * poly.size() * sizeof(poly[0]));
+}
+
+BENCHMARK_TEMPLATE(GaloisField_MultiplyAdd, GF256, 8u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, GF256, 8u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MultiplyAdd, GF1024, 10u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, GF1024, 10u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MultiplyAdd, GF65536, 16u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, GF65536, 16u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MultiplyAdd, CarrylessGF256, 8u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, CarrylessGF256, 8u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MultiplyAdd, CarrylessGF65536, 16u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, CarrylessGF65536, 16u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, CarrylessGF2_32, 32u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_MulAddRegion, CarrylessGF2_64, 64u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_Dot, GF256, 8u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_Evaluate, GF256, 8u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_Dot, GF65536, 16u)->Arg(256)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(GaloisField_Evaluate, GF65536, 16u)->Arg(256)->Arg(4096)->Arg(65536);
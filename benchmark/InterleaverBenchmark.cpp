@@ -0,0 +1,125 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include "FEC/Convolutional.h"
+
+using namespace Thiemar::Convolutional;
+
+/*
+Compare the generic shift/mask interleaver with the BMI2 backend, using the
+same block size as the convolutional encoder for each puncturing matrix.
+*/
+template <typename PuncturingMatrix, std::size_t NumPoly>
+constexpr std::size_t interleaver_block_size() {
+    std::size_t puncturing_row_len = PuncturingMatrix::size() / NumPoly;
+    return sizeof(Thiemar::bool_vec_t) > puncturing_row_len ?
+        (sizeof(Thiemar::bool_vec_t) / puncturing_row_len) * puncturing_row_len : puncturing_row_len;
+}
+
+template <typename PuncturingMatrix, std::size_t NumPoly>
+using BenchmarkInterleaver = Interleaver<PuncturingMatrix, NumPoly,
+    interleaver_block_size<PuncturingMatrix, NumPoly>()>;
+
+template <typename TestInterleaver>
+std::array<Thiemar::bool_vec_t, TestInterleaver::in_buf_len()> make_interleaver_input() {
+    std::array<Thiemar::bool_vec_t, TestInterleaver::in_buf_len()> in;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < in.size(); i++) {
+        in[i] = ((Thiemar::bool_vec_t)std::rand() << 40u) ^ ((Thiemar::bool_vec_t)std::rand() << 20u) ^ std::rand();
+    }
+
+    return in;
+}
+
+template <typename PuncturingMatrix, std::size_t NumPoly>
+void Interleaver_Interleave(benchmark::State& state) {
+    using TestInterleaver = BenchmarkInterleaver<PuncturingMatrix, NumPoly>;
+    auto in = make_interleaver_input<TestInterleaver>();
+
+    while(state.KeepRunning()) {
+        auto out = TestInterleaver::interleave_generic(in);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(in);
+    }
+
+    state.SetBytesProcessed(state.iterations() * TestInterleaver::out_buf_len());
+}
+
+template <typename PuncturingMatrix, std::size_t NumPoly>
+void Interleaver_Deinterleave(benchmark::State& state) {
+    using TestInterleaver = BenchmarkInterleaver<PuncturingMatrix, NumPoly>;
+    auto in = TestInterleaver::interleave_generic(make_interleaver_input<TestInterleaver>());
+
+    while(state.KeepRunning()) {
+        auto out = TestInterleaver::deinterleave_generic(in);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(in);
+    }
+
+    state.SetBytesProcessed(state.iterations() * TestInterleaver::out_buf_len());
+}
+
+BENCHMARK_TEMPLATE(Interleaver_Interleave, PuncturingMatrices::n_2_rate_1_2, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Interleave, PuncturingMatrices::n_2_rate_2_3, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Interleave, PuncturingMatrices::n_2_rate_3_4, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Interleave, PuncturingMatrices::n_2_rate_5_6, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Interleave, PuncturingMatrices::n_2_rate_7_8, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Interleave, PuncturingMatrices::n_3_rate_1_3, 3u);
+BENCHMARK_TEMPLATE(Interleaver_Deinterleave, PuncturingMatrices::n_2_rate_1_2, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Deinterleave, PuncturingMatrices::n_2_rate_2_3, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Deinterleave, PuncturingMatrices::n_2_rate_3_4, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Deinterleave, PuncturingMatrices::n_2_rate_5_6, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Deinterleave, PuncturingMatrices::n_2_rate_7_8, 2u);
+BENCHMARK_TEMPLATE(Interleaver_Deinterleave, PuncturingMatrices::n_3_rate_1_3, 3u);
+
+#if defined(USE_SIMD_X86)
+template <typename PuncturingMatrix, std::size_t NumPoly>
+void Interleaver_InterleaveBMI2(benchmark::State& state) {
+    using TestInterleaver = BenchmarkInterleaver<PuncturingMatrix, NumPoly>;
+    auto in = make_interleaver_input<TestInterleaver>();
+
+    if (!Thiemar::Detail::cpu_supports_bmi2()) {
+        state.SkipWithError("BMI2 not supported");
+    }
+
+    while(state.KeepRunning()) {
+        auto out = TestInterleaver::interleave_bmi2(in);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(in);
+    }
+
+    state.SetBytesProcessed(state.iterations() * TestInterleaver::out_buf_len());
+}
+
+template <typename PuncturingMatrix, std::size_t NumPoly>
+void Interleaver_DeinterleaveBMI2(benchmark::State& state) {
+    using TestInterleaver = BenchmarkInterleaver<PuncturingMatrix, NumPoly>;
+    auto in = TestInterleaver::interleave_generic(make_interleaver_input<TestInterleaver>());
+
+    if (!Thiemar::Detail::cpu_supports_bmi2()) {
+        state.SkipWithError("BMI2 not supported");
+    }
+
+    while(state.KeepRunning()) {
+        auto out = TestInterleaver::deinterleave_bmi2(in);
+        benchmark::DoNotOptimize(out);
+        benchmark::DoNotOptimize(in);
+    }
+
+    state.SetBytesProcessed(state.iterations() * TestInterleaver::out_buf_len());
+}
+
+BENCHMARK_TEMPLATE(Interleaver_InterleaveBMI2, PuncturingMatrices::n_2_rate_1_2, 2u);
+BENCHMARK_TEMPLATE(Interleaver_InterleaveBMI2, PuncturingMatrices::n_2_rate_2_3, 2u);
+BENCHMARK_TEMPLATE(Interleaver_InterleaveBMI2, PuncturingMatrices::n_2_rate_3_4, 2u);
+BENCHMARK_TEMPLATE(Interleaver_InterleaveBMI2, PuncturingMatrices::n_2_rate_5_6, 2u);
+BENCHMARK_TEMPLATE(Interleaver_InterleaveBMI2, PuncturingMatrices::n_2_rate_7_8, 2u);
+BENCHMARK_TEMPLATE(Interleaver_InterleaveBMI2, PuncturingMatrices::n_3_rate_1_3, 3u);
+BENCHMARK_TEMPLATE(Interleaver_DeinterleaveBMI2, PuncturingMatrices::n_2_rate_1_2, 2u);
+BENCHMARK_TEMPLATE(Interleaver_DeinterleaveBMI2, PuncturingMatrices::n_2_rate_2_3, 2u);
+BENCHMARK_TEMPLATE(Interleaver_DeinterleaveBMI2, PuncturingMatrices::n_2_rate_3_4, 2u);
+BENCHMARK_TEMPLATE(Interleaver_DeinterleaveBMI2, PuncturingMatrices::n_2_rate_5_6, 2u);
+BENCHMARK_TEMPLATE(Interleaver_DeinterleaveBMI2, PuncturingMatrices::n_2_rate_7_8, 2u);
+BENCHMARK_TEMPLATE(Interleaver_DeinterleaveBMI2, PuncturingMatrices::n_3_rate_1_3, 3u);
+#endif
@@ -1,5 +1,6 @@
 #include <benchmark/benchmark.h>
 #include <cstdlib>
+#include <vector>
 #include "FEC/ReedSolomon.h"
 
 /* Benchmark against ezpwd implementation. */
@@ -29,6 +30,46 @@ void ReedSolomonEncoder_Encode(benchmark::State& state) {
 
 BENCHMARK(ReedSolomonEncoder_Encode);
 
+/* Encoder with the parity length chosen at run time. */
+void ReedSolomonCodec_Encode(benchmark::State& state) {
+    Thiemar::ReedSolomon::ReedSolomonCodec<8u, Thiemar::ReedSolomon::Polynomials::m_8_285> codec(
+        MESSAGE_PARITY_LENGTH);
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        benchmark::DoNotOptimize(codec.encode(buf.data(), MESSAGE_DATA_LENGTH));
+    }
+}
+
+BENCHMARK(ReedSolomonCodec_Encode);
+
+/* Encode frames of 16-bit symbols, longer than a GF(2^8) codeword. */
+void ReedSolomonEncoder_EncodeLargeField(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, MESSAGE_PARITY_LENGTH>;
+    std::vector<uint16_t> buf(state.range(0) + MESSAGE_PARITY_LENGTH);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < (std::size_t)state.range(0); i++) {
+        buf[i] = std::rand() & 0xffffu;
+    }
+
+    while(state.KeepRunning()) {
+        TestEncoder::encode(buf.data(), state.range(0), &buf[state.range(0)]);
+    }
+
+    state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(uint16_t));
+}
+
+BENCHMARK(ReedSolomonEncoder_EncodeLargeField)->Arg(223)->Arg(4096)->Arg(65503);
+
 void EZPWD_ReedSolomonEncoder_Encode(benchmark::State& state) {
     ezpwd::RS<255u, 255u-MESSAGE_PARITY_LENGTH> rs;
     std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> rs_container;
@@ -63,3 +104,323 @@ void MersinvaldReedSolomonEncoder_Encode(benchmark::State& state) {
 }
 
 BENCHMARK(MersinvaldReedSolomonEncoder_Encode);
+
+/* Change one message symbol and update the parity, rather than re-encoding the codeword. */
+void ReedSolomonEncoder_Update(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+
+    std::size_t offset = 0u;
+    while(state.KeepRunning()) {
+        TestEncoder::update<MESSAGE_DATA_LENGTH>(buf, offset, buf[offset], buf[offset] + 1u);
+        offset = (offset + 97u) % MESSAGE_DATA_LENGTH;
+        benchmark::DoNotOptimize(buf);
+    }
+}
+
+BENCHMARK(ReedSolomonEncoder_Update);
+
+/* As above, over GF(2^16) with a full length codeword, so most changes are far from the end. */
+void ReedSolomonEncoder_UpdateLargeField(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, MESSAGE_PARITY_LENGTH>;
+    constexpr std::size_t len = 65535u - MESSAGE_PARITY_LENGTH;
+    std::vector<uint16_t> buf(len + MESSAGE_PARITY_LENGTH);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < len; i++) {
+        buf[i] = std::rand() & 0xffffu;
+    }
+
+    TestEncoder::encode(buf.data(), len, &buf[len]);
+
+    std::size_t offset = 0u;
+    while(state.KeepRunning()) {
+        TestEncoder::update(buf.data(), len, offset, buf[offset], buf[offset] + 1u);
+        offset = (offset + 9973u) % len;
+        benchmark::DoNotOptimize(buf.data());
+    }
+}
+
+BENCHMARK(ReedSolomonEncoder_UpdateLargeField);
+
+template <std::size_t Depth>
+void ReedSolomonEncoder_EncodeInterleaved(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::InterleavedReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH, Depth>;
+    std::array<uint8_t, (MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH) * Depth> frame = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH * Depth; i++) {
+        frame[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        TestEncoder::template encode<MESSAGE_DATA_LENGTH>(frame);
+        benchmark::DoNotOptimize(frame);
+    }
+
+    state.SetBytesProcessed(state.iterations() * MESSAGE_DATA_LENGTH * Depth);
+}
+
+BENCHMARK_TEMPLATE(ReedSolomonEncoder_EncodeInterleaved, 1u);
+BENCHMARK_TEMPLATE(ReedSolomonEncoder_EncodeInterleaved, 5u);
+BENCHMARK_TEMPLATE(ReedSolomonEncoder_EncodeInterleaved, 16u);
+BENCHMARK_TEMPLATE(ReedSolomonEncoder_EncodeInterleaved, 32u);
+
+/* Corrupt 'n' evenly spaced symbols of the codeword. */
+template <std::size_t N>
+static void add_errors(uint8_t (&buf)[N], std::size_t n) {
+    for (std::size_t i = 0u; i < n; i++) {
+        buf[(i * N) / n] ^= 0x5au;
+    }
+}
+
+/* Decode with 0, t/2 and t symbol errors. */
+void ReedSolomonDecoder_Decode(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+    uint8_t received[MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH];
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+    std::copy(buf.begin(), buf.end(), received);
+    add_errors(received, state.range(0));
+
+    while(state.KeepRunning()) {
+        std::copy_n(received, buf.size(), buf.begin());
+        benchmark::DoNotOptimize(TestDecoder::decode<MESSAGE_DATA_LENGTH>(buf));
+    }
+}
+
+BENCHMARK(ReedSolomonDecoder_Decode)->Arg(0)->Arg(MESSAGE_PARITY_LENGTH / 4u)->Arg(MESSAGE_PARITY_LENGTH / 2u);
+
+/* As above, with the carry-less field backend, which has no log, antilog or root tables. */
+void ReedSolomonDecoder_DecodeCarryless(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH,
+        Thiemar::GaloisFieldBackends::Carryless>;
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+    uint8_t received[MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH];
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+    std::copy(buf.begin(), buf.end(), received);
+    add_errors(received, state.range(0));
+
+    while(state.KeepRunning()) {
+        std::copy_n(received, buf.size(), buf.begin());
+        benchmark::DoNotOptimize(TestDecoder::decode<MESSAGE_DATA_LENGTH>(buf));
+    }
+}
+
+BENCHMARK(ReedSolomonDecoder_DecodeCarryless)->Arg(0)->Arg(MESSAGE_PARITY_LENGTH / 4u)->Arg(MESSAGE_PARITY_LENGTH / 2u);
+
+/* Check an error-free codeword, which is all of the work for most received codewords. */
+void ReedSolomonDecoder_IsValidCodeword(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+
+    while(state.KeepRunning()) {
+        benchmark::DoNotOptimize(TestDecoder::is_valid_codeword(buf.data(), buf.size()));
+    }
+}
+
+BENCHMARK(ReedSolomonDecoder_IsValidCodeword);
+
+/* Decode frames of 16-bit symbols with 0 and t/2 symbol errors. */
+void ReedSolomonDecoder_DecodeLargeField(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, MESSAGE_PARITY_LENGTH>;
+    using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<
+        16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, MESSAGE_PARITY_LENGTH>;
+    std::size_t len = 4096u;
+    std::vector<uint16_t> buf(len + MESSAGE_PARITY_LENGTH);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < len; i++) {
+        buf[i] = std::rand() & 0xffffu;
+    }
+
+    TestEncoder::encode(buf.data(), len, &buf[len]);
+    std::vector<uint16_t> received = buf;
+    for (std::size_t i = 0u; i < (std::size_t)state.range(0); i++) {
+        received[(i * received.size()) / state.range(0)] ^= 0x5a5au;
+    }
+
+    while(state.KeepRunning()) {
+        std::copy(received.begin(), received.end(), buf.begin());
+        benchmark::DoNotOptimize(TestDecoder::decode(buf.data(), buf.size()));
+    }
+
+    state.SetBytesProcessed(state.iterations() * len * sizeof(uint16_t));
+}
+
+BENCHMARK(ReedSolomonDecoder_DecodeLargeField)->Arg(0)->Arg(MESSAGE_PARITY_LENGTH / 4u);
+
+void ReedSolomonCodec_Decode(benchmark::State& state) {
+    Thiemar::ReedSolomon::ReedSolomonCodec<8u, Thiemar::ReedSolomon::Polynomials::m_8_285> codec(
+        MESSAGE_PARITY_LENGTH);
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+    uint8_t received[MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH];
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    codec.encode(buf.data(), MESSAGE_DATA_LENGTH);
+    std::copy(buf.begin(), buf.end(), received);
+    add_errors(received, state.range(0));
+
+    while(state.KeepRunning()) {
+        std::copy_n(received, buf.size(), buf.begin());
+        benchmark::DoNotOptimize(codec.decode(buf.data(), buf.size()));
+    }
+}
+
+BENCHMARK(ReedSolomonCodec_Decode)->Arg(0)->Arg(MESSAGE_PARITY_LENGTH / 4u)->Arg(MESSAGE_PARITY_LENGTH / 2u);
+
+/* Decode with t and 2t erased symbols, and no other errors. */
+void ReedSolomonDecoder_DecodeErasures(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> buf = {};
+    uint8_t received[MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH];
+    std::size_t erasures[MESSAGE_PARITY_LENGTH];
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+    std::copy(buf.begin(), buf.end(), received);
+    add_errors(received, state.range(0));
+    for (std::size_t i = 0u; i < (std::size_t)state.range(0); i++) {
+        erasures[i] = (i * buf.size()) / state.range(0);
+    }
+
+    while(state.KeepRunning()) {
+        std::copy_n(received, buf.size(), buf.begin());
+        benchmark::DoNotOptimize(TestDecoder::decode<MESSAGE_DATA_LENGTH>(buf, erasures, state.range(0)));
+    }
+}
+
+BENCHMARK(ReedSolomonDecoder_DecodeErasures)->Arg(MESSAGE_PARITY_LENGTH / 2u)->Arg(MESSAGE_PARITY_LENGTH);
+
+/* Decode an error-free interleaved frame, which only needs the syndrome check. */
+template <std::size_t Depth>
+void ReedSolomonDecoder_DecodeInterleaved(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::InterleavedReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH, Depth>;
+    using TestDecoder = Thiemar::ReedSolomon::InterleavedReedSolomonDecoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH, Depth>;
+    std::array<uint8_t, (MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH) * Depth> frame = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH * Depth; i++) {
+        frame[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::template encode<MESSAGE_DATA_LENGTH>(frame);
+
+    while(state.KeepRunning()) {
+        benchmark::DoNotOptimize(TestDecoder::template decode<MESSAGE_DATA_LENGTH>(frame));
+    }
+
+    state.SetBytesProcessed(state.iterations() * MESSAGE_DATA_LENGTH * Depth);
+}
+
+BENCHMARK_TEMPLATE(ReedSolomonDecoder_DecodeInterleaved, 1u);
+BENCHMARK_TEMPLATE(ReedSolomonDecoder_DecodeInterleaved, 5u);
+BENCHMARK_TEMPLATE(ReedSolomonDecoder_DecodeInterleaved, 16u);
+BENCHMARK_TEMPLATE(ReedSolomonDecoder_DecodeInterleaved, 32u);
+
+void EZPWD_ReedSolomonDecoder_Decode(benchmark::State& state) {
+    ezpwd::RS<255u, 255u-MESSAGE_PARITY_LENGTH> rs;
+    std::array<uint8_t, MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH> rs_container;
+    uint8_t received[MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH];
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        rs_container[i] = std::rand() & 0xffu;
+    }
+
+    rs.encode(rs_container);
+    std::copy(rs_container.begin(), rs_container.end(), received);
+    add_errors(received, state.range(0));
+
+    while(state.KeepRunning()) {
+        std::copy_n(received, rs_container.size(), rs_container.begin());
+        benchmark::DoNotOptimize(rs.decode(rs_container));
+    }
+}
+
+BENCHMARK(EZPWD_ReedSolomonDecoder_Decode)->Arg(0)->Arg(MESSAGE_PARITY_LENGTH / 4u)->Arg(MESSAGE_PARITY_LENGTH / 2u);
+
+void MersinvaldReedSolomonDecoder_Decode(benchmark::State& state) {
+    RS::ReedSolomon<MESSAGE_DATA_LENGTH, MESSAGE_PARITY_LENGTH> rs;
+    uint8_t message[MESSAGE_DATA_LENGTH] = {};
+    uint8_t encoded[MESSAGE_DATA_LENGTH+MESSAGE_PARITY_LENGTH] = {};
+    uint8_t repaired[MESSAGE_DATA_LENGTH] = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        message[i] = std::rand() & 0xffu;
+    }
+
+    rs.Encode(message, encoded);
+    add_errors(encoded, state.range(0));
+
+    while(state.KeepRunning()) {
+        benchmark::DoNotOptimize(rs.Decode(encoded, repaired));
+    }
+}
+
+BENCHMARK(MersinvaldReedSolomonDecoder_Decode)->Arg(0)->Arg(MESSAGE_PARITY_LENGTH / 4u)->Arg(MESSAGE_PARITY_LENGTH / 2u);
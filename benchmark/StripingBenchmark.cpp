@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ErasureCode.h"
+#include "FEC/ReedSolomon.h"
+#include "FEC/Striping.h"
+
+#define MESSAGE_PARITY_LENGTH 32u
+#define MESSAGE_DATA_LENGTH 223u
+#define DATA_SHARDS 10u
+#define PARITY_SHARDS 4u
+
+/*
+Throughput of striped encoding against the number of threads, for inputs
+of 1 MiB to 1 GiB. The first argument is the input size in MiB and the
+second is the number of threads.
+*/
+static void striping_arguments(benchmark::internal::Benchmark *b) {
+    for (int size : { 1, 16, 256, 1024 }) {
+        for (int threads : { 1, 2, 4, 8 }) {
+            b->Args({ size, threads });
+        }
+    }
+}
+
+static std::vector<uint8_t> make_input(std::size_t len) {
+    std::vector<uint8_t> data(len);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < data.size(); i++) {
+        data[i] = std::rand() & 0xffu;
+    }
+
+    return data;
+}
+
+void Striping_EncodeCodewords(benchmark::State& state) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+    std::size_t len = (std::size_t)state.range(0) << 20u;
+    auto data = make_input(len);
+    std::vector<uint8_t> parity(((len + MESSAGE_DATA_LENGTH - 1u) / MESSAGE_DATA_LENGTH) * MESSAGE_PARITY_LENGTH);
+    Thiemar::Striping::StripedEncoder striper(state.range(1));
+
+    while(state.KeepRunning()) {
+        striper.encode_codewords<TestEncoder, MESSAGE_DATA_LENGTH>(data.data(), data.size(), parity.data());
+        benchmark::DoNotOptimize(parity.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * len);
+}
+
+BENCHMARK(Striping_EncodeCodewords)->Apply(striping_arguments)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+void Striping_EncodeShards(benchmark::State& state) {
+    using TestCoder = Thiemar::ErasureCode::CauchyErasureCoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, DATA_SHARDS, PARITY_SHARDS>;
+    std::size_t len = ((std::size_t)state.range(0) << 20u) / DATA_SHARDS;
+    auto data = make_input(len * DATA_SHARDS);
+    std::vector<uint8_t> parity(len * PARITY_SHARDS);
+    Thiemar::Striping::StripedEncoder striper(state.range(1));
+
+    std::array<const uint8_t *, DATA_SHARDS> data_ptrs;
+    std::array<uint8_t *, PARITY_SHARDS> parity_ptrs;
+    for (std::size_t i = 0u; i < DATA_SHARDS; i++) {
+        data_ptrs[i] = &data[i * len];
+    }
+
+    for (std::size_t i = 0u; i < PARITY_SHARDS; i++) {
+        parity_ptrs[i] = &parity[i * len];
+    }
+
+    while(state.KeepRunning()) {
+        striper.encode_shards<TestCoder>(data_ptrs.data(), parity_ptrs.data(), len);
+        benchmark::DoNotOptimize(parity.data());
+    }
+
+    state.SetBytesProcessed(state.iterations() * len * DATA_SHARDS);
+}
+
+BENCHMARK(Striping_EncodeShards)->Apply(striping_arguments)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include "FEC/Turbo.h"
+
+using TestEncoder = Thiemar::Turbo::TurboEncoder<
+    4u,
+    Thiemar::Turbo::Interleavers::lte_6144,
+    Thiemar::Turbo::Polynomials::lte_feedback,
+    Thiemar::Turbo::Polynomials::lte_feedforward
+>;
+
+using TestDecoder = Thiemar::Turbo::TurboDecoder<
+    4u,
+    256u,
+    Thiemar::Turbo::Interleavers::lte_6144,
+    Thiemar::Turbo::Polynomials::lte_feedback,
+    Thiemar::Turbo::Polynomials::lte_feedforward
+>;
+
+void TurboEncoder_Encode(benchmark::State& state) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+    std::array<uint8_t, TestEncoder::calculate_output_length()> test_out = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    while(state.KeepRunning()) {
+        test_out = TestEncoder::encode(test_in);
+        benchmark::DoNotOptimize(test_out);
+    }
+}
+
+BENCHMARK(TurboEncoder_Encode);
+
+void TurboDecoder_Decode(benchmark::State& state) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+    std::array<float, TestDecoder::calculate_input_length()> test_llr = {};
+    std::array<uint8_t, TestEncoder::message_length()> test_decoded = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoder::encode(test_in);
+    for (std::size_t i = 0u; i < test_llr.size(); i++) {
+        test_llr[i] = (test_out[i / 8u] & (0x80u >> (i % 8u))) ? -1.0f : 1.0f;
+    }
+
+    /* Run a fixed number of iterations by never stopping early. */
+    while(state.KeepRunning()) {
+        test_decoded = TestDecoder::decode<8u>(test_llr, [](const auto &) { return false; });
+    }
+}
+
+BENCHMARK(TurboDecoder_Decode);
+
+/* As above, with the sub-blocks spread across a pool of 'state.range(0)' threads. */
+void TurboDecoder_DecodeWorkerPool(benchmark::State& state) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+    std::array<float, TestDecoder::calculate_input_length()> test_llr = {};
+    std::array<uint8_t, TestEncoder::message_length()> test_decoded = {};
+    Thiemar::Striping::WorkerPool pool(state.range(0));
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoder::encode(test_in);
+    for (std::size_t i = 0u; i < test_llr.size(); i++) {
+        test_llr[i] = (test_out[i / 8u] & (0x80u >> (i % 8u))) ? -1.0f : 1.0f;
+    }
+
+    /* Run a fixed number of iterations by never stopping early. */
+    while(state.KeepRunning()) {
+        test_decoded = TestDecoder::decode<8u>(pool, test_llr, [](const auto &) { return false; });
+    }
+}
+
+BENCHMARK(TurboDecoder_DecodeWorkerPool)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
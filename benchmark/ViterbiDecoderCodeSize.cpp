@@ -0,0 +1,43 @@
+#include "FEC/Convolutional.h"
+
+/*
+Instantiate the hard-decision Viterbi decoder for every puncturing matrix
+at a single constraint length, so that the compile time and object size of
+the decoder can be tracked as the constraint length grows.
+*/
+#ifndef CONSTRAINT_LENGTH
+#define CONSTRAINT_LENGTH 7
+#endif
+
+#define CONCATENATE_DETAIL(a, b, c) a ## b ## c
+#define CONCATENATE(a, b, c) CONCATENATE_DETAIL(a, b, c)
+#define POLYNOMIAL(g) Thiemar::Convolutional::Polynomials::CONCATENATE(n_2_k_, CONSTRAINT_LENGTH, g)
+
+template <typename PuncturingMatrix>
+using TestDecoder = Thiemar::Convolutional::PuncturedHardDecisionViterbiDecoder<
+    CONSTRAINT_LENGTH,
+    840u,
+    PuncturingMatrix,
+    POLYNOMIAL(_g11),
+    POLYNOMIAL(_g12)
+>;
+
+void viterbi_decode_rate_1_2(const uint8_t *in, std::size_t len, uint8_t *out) {
+    TestDecoder<Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2>::decode(in, len, out);
+}
+
+void viterbi_decode_rate_2_3(const uint8_t *in, std::size_t len, uint8_t *out) {
+    TestDecoder<Thiemar::Convolutional::PuncturingMatrices::n_2_rate_2_3>::decode(in, len, out);
+}
+
+void viterbi_decode_rate_3_4(const uint8_t *in, std::size_t len, uint8_t *out) {
+    TestDecoder<Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4>::decode(in, len, out);
+}
+
+void viterbi_decode_rate_5_6(const uint8_t *in, std::size_t len, uint8_t *out) {
+    TestDecoder<Thiemar::Convolutional::PuncturingMatrices::n_2_rate_5_6>::decode(in, len, out);
+}
+
+void viterbi_decode_rate_7_8(const uint8_t *in, std::size_t len, uint8_t *out) {
+    TestDecoder<Thiemar::Convolutional::PuncturingMatrices::n_2_rate_7_8>::decode(in, len, out);
+}
@@ -0,0 +1,108 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "FEC/Types.h"
+
+namespace Thiemar {
+
+/*
+Table-driven cyclic redundancy check, processing one byte per table lookup.
+The CRC is calculated MSB-first with a zero initial value and no final XOR,
+as used by LTE. The 'Polynomial' parameter omits the leading term.
+*/
+template <std::size_t Width, uint64_t Polynomial>
+class CRC {
+    static_assert(Width >= 8u && Width <= 64u, "CRC width must be between 8 and 64 bits");
+
+public:
+    using crc_t = std::conditional_t<(Width <= 16u), std::conditional_t<(Width <= 8u), uint8_t, uint16_t>,
+        std::conditional_t<(Width <= 32u), uint32_t, uint64_t>>;
+
+private:
+    static constexpr uint64_t mask() { return Width == 64u ? ~(uint64_t)0u : ((uint64_t)1u << Width) - 1u; }
+
+    static constexpr std::array<crc_t, 256u> get_table() {
+        std::array<crc_t, 256u> table = {};
+
+        for (std::size_t i = 0u; i < 256u; i++) {
+            uint64_t reg = (uint64_t)i << (Width - 8u);
+            for (std::size_t j = 0u; j < 8u; j++) {
+                reg = (reg & ((uint64_t)1u << (Width - 1u))) ? (reg << 1u) ^ Polynomial : reg << 1u;
+            }
+
+            table[i] = (crc_t)(reg & mask());
+        }
+
+        return table;
+    }
+
+    static constexpr std::array<crc_t, 256u> table = get_table();
+
+public:
+    /* Number of bytes occupied by the CRC when appended to a message. */
+    static constexpr std::size_t size() { return Width / 8u + ((Width % 8u) ? 1u : 0u); }
+
+    /* Calculate the CRC of a buffer. */
+    static crc_t calculate(const uint8_t *in, std::size_t len) {
+        uint64_t reg = 0u;
+
+        for (std::size_t i = 0u; i < len; i++) {
+            reg = ((reg << 8u) ^ table[((reg >> (Width - 8u)) ^ in[i]) & 0xffu]) & mask();
+        }
+
+        return (crc_t)reg;
+    }
+
+    template <std::size_t Len>
+    static crc_t calculate(const std::array<uint8_t, Len> &in) {
+        return calculate(in.data(), Len);
+    }
+
+    /*
+    Check a message with the CRC appended MSB-first in its last bytes. The
+    CRC width must be a whole number of bytes.
+    */
+    template <std::size_t Len>
+    static bool check(const std::array<uint8_t, Len> &in) {
+        static_assert(Width % 8u == 0u, "CRC width must be a whole number of bytes");
+        static_assert(Len >= size(), "Message must be large enough to contain the CRC");
+
+        return calculate(in.data(), Len) == 0u;
+    }
+};
+
+namespace CRCs {
+    /* LTE CRCs from 3GPP TS 36.212. */
+    using lte_24a = CRC<24u, 0x864cfbu>;
+    using lte_24b = CRC<24u, 0x800063u>;
+    using lte_16 = CRC<16u, 0x1021u>;
+}
+
+}
@@ -0,0 +1,418 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(USE_SIMD_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "FEC/Types.h"
+#include "FEC/Utilities.h"
+#include "FEC/BinarySequence.h"
+#include "FEC/GaloisField.h"
+
+namespace Thiemar {
+
+namespace Detail {
+    /* Carry-less product of two 64-bit polynomials, as low and high words. */
+    struct clmul_result_t {
+        uint64_t lo;
+        uint64_t hi;
+    };
+
+    /*
+    Portable carry-less multiply of the low Bits bits of 'b' by 'a', which
+    runs the same number of steps whatever the operands, using masks rather
+    than branches.
+    */
+    template <std::size_t Bits>
+    struct clmul_generic {
+        static clmul_result_t op(uint64_t a, uint64_t b) {
+            clmul_result_t r = { 0u, 0u };
+            for (std::size_t i = 0u; i < Bits; i++) {
+                uint64_t mask = (uint64_t)0u - ((b >> i) & 1u);
+                r.lo ^= (a << i) & mask;
+                r.hi ^= (i ? (a >> (64u - i)) : 0u) & mask;
+            }
+
+            return r;
+        }
+    };
+
+#if defined(USE_SIMD_X86)
+    struct clmul_pclmul {
+        __attribute__((target("pclmul,sse4.1")))
+        static inline clmul_result_t op(uint64_t a, uint64_t b) {
+            __m128i p = _mm_clmulepi64_si128(_mm_cvtsi64_si128((long long)a), _mm_cvtsi64_si128((long long)b), 0x00);
+            return clmul_result_t{ (uint64_t)_mm_cvtsi128_si64(p), (uint64_t)_mm_extract_epi64(p, 1) };
+        }
+    };
+#endif
+
+    /*
+    Shift a product of two elements right by M bits, for 1 <= M <= 64. For
+    M <= 32 the product fits in the low word.
+    */
+    template <std::size_t M>
+    constexpr uint64_t clmul_shift_right(clmul_result_t c) {
+        if constexpr (M == 64u) {
+            return c.hi;
+        } else if constexpr (M <= 32u) {
+            return c.lo >> M;
+        } else {
+            return (c.lo >> M) | (c.hi << (64u - M));
+        }
+    }
+
+    template <std::size_t M>
+    constexpr uint64_t low_bits_mask() {
+        return (M == 64u) ? ~(uint64_t)0u : (((uint64_t)1u << M) - 1u);
+    }
+
+    /*
+    Barrett constant for P = x^M + p, without its x^M term. This is
+    floor(x^2M / P) - x^M, which is floor(x^M * p / P), found by long
+    division of x^M * p held in two words.
+    */
+    template <std::size_t M>
+    constexpr uint64_t barrett_constant(uint64_t p) {
+        uint64_t n_lo = (M == 64u) ? 0u : (p << M);
+        uint64_t n_hi = (M == 64u) ? p : ((M > 0u) ? (p >> (64u - M)) : 0u);
+        uint64_t q = 0u;
+
+        for (std::size_t d = 2u * M; d-- > M;) {
+            bool set = (d >= 64u) ? ((n_hi >> (d - 64u)) & 1u) : ((n_lo >> d) & 1u);
+            if (!set) {
+                continue;
+            }
+
+            /* Subtract P * x^(d - M), which is x^d + p * x^(d - M). */
+            std::size_t s = d - M;
+            q |= (uint64_t)1u << s;
+            if (d >= 64u) {
+                n_hi ^= (uint64_t)1u << (d - 64u);
+            } else {
+                n_lo ^= (uint64_t)1u << d;
+            }
+
+            n_lo ^= p << s;
+            n_hi ^= s ? (p >> (64u - s)) : 0u;
+        }
+
+        return q;
+    }
+}
+
+/*
+Galois field arithmetic using carry-less multiplication and Barrett
+reduction by the field polynomial, for fields of up to 2^64 elements.
+There are no log or antilog tables, so this leaves the cache to other
+work and, unlike table lookups, runs in time independent of the operands.
+
+With USE_SIMD_X86, multiplication uses PCLMULQDQ when the CPU supports
+it, and otherwise a portable shift-and-XOR loop. Each product takes
+three carry-less multiplies: the product itself, the Barrett quotient
+estimate, and the multiple of the polynomial to subtract.
+
+This has the same interface as GaloisField for arithmetic on elements,
+regions and polynomials, but not log(), antilog() or split_table(). It
+is the field of GaloisField<M, Primitive, GaloisFieldBackends::Carryless>.
+*/
+template <std::size_t M, typename Primitive>
+class CarrylessGaloisField {
+    static_assert(M >= 2u && M <= 64u, "Galois field order must be between 2^2 and 2^64");
+    static_assert(Primitive::size() == M + 1u, "Field polynomial must have degree M");
+
+public:
+    using gf_t = typename std::conditional<(M <= 8u), uint8_t,
+        typename std::conditional<(M <= 16u), uint16_t,
+        typename std::conditional<(M <= 32u), uint32_t, uint64_t>::type>::type>::type;
+
+private:
+    /* Field polynomial without its x^M term, and the Barrett constant. */
+    static constexpr uint64_t poly = Detail::integer_from_index_sequence<uint64_t>(
+        (typename Primitive::ones_index_sequence_reversed){}) & Detail::low_bits_mask<M>();
+    static constexpr uint64_t mu = Detail::barrett_constant<M>(poly);
+
+    /*
+    Reduce a product of degree less than 2M. Writing it as c_hi * x^M +
+    c_lo, the quotient by P is c_hi + floor(c_hi * mu / x^M), and the
+    remainder is c_lo plus the low M bits of the quotient times p.
+    */
+    template <typename Clmul>
+    __attribute__((always_inline))
+    static inline gf_t reduce(Detail::clmul_result_t c) {
+        uint64_t c_lo = c.lo & Detail::low_bits_mask<M>();
+        uint64_t c_hi = Detail::clmul_shift_right<M>(c);
+        uint64_t q = c_hi ^ Detail::clmul_shift_right<M>(Clmul::op(mu, c_hi));
+        return (gf_t)((c_lo ^ Clmul::op(poly, q).lo) & Detail::low_bits_mask<M>());
+    }
+
+    template <typename Clmul>
+    __attribute__((always_inline))
+    static inline gf_t multiply_impl(gf_t x, gf_t y) {
+        return reduce<Clmul>(Clmul::op(x, y));
+    }
+
+#if defined(USE_SIMD_X86)
+    __attribute__((target("pclmul,sse4.1")))
+    static gf_t multiply_pclmul(gf_t x, gf_t y) {
+        return multiply_impl<Detail::clmul_pclmul>(x, y);
+    }
+
+    template <bool Accumulate>
+    __attribute__((target("pclmul,sse4.1")))
+    static void mul_region_pclmul(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+        for (std::size_t i = 0u; i < len; i++) {
+            gf_t r = multiply_impl<Detail::clmul_pclmul>(c, src[i]);
+            dst[i] = Accumulate ? (dst[i] ^ r) : r;
+        }
+    }
+#endif
+
+    template <bool Accumulate>
+    static void mul_region_generic(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+        for (std::size_t i = 0u; i < len; i++) {
+            gf_t r = multiply_impl<Detail::clmul_generic<M>>(c, src[i]);
+            dst[i] = Accumulate ? (dst[i] ^ r) : r;
+        }
+    }
+
+    template <bool Accumulate>
+    static void mul_region_impl(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+#if defined(USE_SIMD_X86)
+        if (Detail::cpu_supports_pclmul()) {
+            mul_region_pclmul<Accumulate>(dst, src, c, len);
+            return;
+        }
+#endif
+        mul_region_generic<Accumulate>(dst, src, c, len);
+    }
+
+    template <typename Clmul>
+    __attribute__((always_inline))
+    static inline void evaluate_n_impl(gf_t *dst, const gf_t *poly, std::size_t len, std::size_t stride,
+            const gf_t *x, std::size_t n) {
+        constexpr std::size_t group = 8u;
+        for (std::size_t k0 = 0u; k0 < n; k0 += group) {
+            gf_t acc[group] = {};
+            std::size_t m = std::min(group, n - k0);
+            for (std::size_t i = 0u; i < len; i++) {
+                for (std::size_t k = 0u; k < m; k++) {
+                    acc[k] = multiply_impl<Clmul>(acc[k], x[k0 + k]) ^ poly[i * stride];
+                }
+            }
+
+            std::copy_n(acc, m, &dst[k0]);
+        }
+    }
+
+#if defined(USE_SIMD_X86)
+    __attribute__((target("pclmul,sse4.1")))
+    static void evaluate_n_pclmul(gf_t *dst, const gf_t *poly, std::size_t len, std::size_t stride,
+            const gf_t *x, std::size_t n) {
+        evaluate_n_impl<Detail::clmul_pclmul>(dst, poly, len, stride, x, n);
+    }
+#endif
+
+public:
+    static constexpr gf_t add(gf_t x, gf_t y) { return x^y; }
+
+    static constexpr gf_t subtract(gf_t x, gf_t y) { return x^y; }
+
+    /* Number of non-zero elements, which is the period of alpha^i. */
+    static constexpr std::size_t field_size() { return (std::size_t)Detail::low_bits_mask<M>(); }
+
+    static gf_t multiply(gf_t x, gf_t y) {
+#if defined(USE_SIMD_X86)
+        if (Detail::cpu_supports_pclmul()) {
+            return multiply_pclmul(x, y);
+        }
+#endif
+        return multiply_impl<Detail::clmul_generic<M>>(x, y);
+    }
+
+    /* Raise 'x' to the power 'e' by square-and-multiply over all 64 bits of 'e'. */
+    static gf_t power(gf_t x, uint64_t e) {
+        gf_t r = 1u;
+        for (std::size_t i = 64u; i-- > 0u;) {
+            r = multiply(r, r);
+            gf_t t = multiply(r, x);
+            r = ((e >> i) & 1u) ? t : r;
+        }
+
+        return r;
+    }
+
+    /* Multiplicative inverse, x^(2^M - 2), with the inverse of zero taken as zero. */
+    static gf_t inverse(gf_t x) {
+        return power(x, Detail::low_bits_mask<M>() - 1u);
+    }
+
+    static gf_t divide(gf_t x, gf_t y) {
+        return multiply(x, inverse(y));
+    }
+
+    /*
+    Region operations, which set dst[i] = c * src[i] (mul_region) or
+    dst[i] += c * src[i] (mul_add_region) for 'len' elements. 'dst' may be
+    equal to 'src', but the regions must not otherwise overlap.
+    */
+    static void mul_region(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+        mul_region_impl<false>(dst, src, c, len);
+    }
+
+    static void mul_add_region(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+        mul_region_impl<true>(dst, src, c, len);
+    }
+
+    /*
+    Batch operations on vectors of 'len' elements, as for GaloisField.
+    multiply_n sets dst[i] = x[i] * y[i], and 'dst' may be equal to either
+    input.
+    */
+    static void multiply_n(gf_t *dst, const gf_t *x, const gf_t *y, std::size_t len) {
+        for (std::size_t i = 0u; i < len; i++) {
+            dst[i] = multiply(x[i], y[i]);
+        }
+    }
+
+    /* Inner product of 'x' and 'y'. */
+    static gf_t dot(const gf_t *x, const gf_t *y, std::size_t len) {
+        gf_t r = 0u;
+        for (std::size_t i = 0u; i < len; i++) {
+            r ^= multiply(x[i], y[i]);
+        }
+
+        return r;
+    }
+
+    /*
+    Evaluate a polynomial with 'len' coefficients, highest order first, at
+    'x' using Horner's rule.
+    */
+    static gf_t evaluate(const gf_t *poly, std::size_t len, gf_t x) {
+        gf_t r = 0u;
+        evaluate_n(&r, poly, len, 1u, &x, 1u);
+        return r;
+    }
+
+    /*
+    Evaluate a polynomial with 'len' coefficients, highest order first and
+    'stride' elements apart, at each of the 'n' points in 'x', writing the
+    values to 'dst'. Groups of points are evaluated together so that their
+    dependency chains overlap.
+    */
+    static void evaluate_n(gf_t *dst, const gf_t *poly, std::size_t len, std::size_t stride,
+            const gf_t *x, std::size_t n) {
+#if defined(USE_SIMD_X86)
+        if (Detail::cpu_supports_pclmul()) {
+            evaluate_n_pclmul(dst, poly, len, stride, x, n);
+            return;
+        }
+#endif
+        evaluate_n_impl<Detail::clmul_generic<M>>(dst, poly, len, stride, x, n);
+    }
+
+    /* Polynomial arithmetic, with the highest order coefficient first. */
+    template <std::size_t Len1, std::size_t Len2>
+    static std::array<gf_t, std::max(Len1, Len2)> add(
+            const std::array<gf_t, Len1>& x, const std::array<gf_t, Len2>& y) {
+        std::array<gf_t, std::max(Len1, Len2)> r = {};
+
+        for (std::size_t i = 0u; i < Len1; i++) {
+            r[i + r.size() - Len1] = x[i];
+        }
+
+        for (std::size_t i = 0u; i < Len2; i++) {
+            r[i + r.size() - Len2] ^= y[i];
+        }
+
+        return r;
+    }
+
+    template <std::size_t Len1, std::size_t Len2>
+    static std::array<gf_t, Len1 + Len2 - 1u> multiply(
+            const std::array<gf_t, Len1>& x, const std::array<gf_t, Len2>& y) {
+        std::array<gf_t, Len1 + Len2 - 1u> r = {};
+
+        for (std::size_t i = 0u; i < Len1; i++) {
+            for (std::size_t j = 0u; j < Len2; j++) {
+                r[i + j] ^= multiply(x[i], y[j]);
+            }
+        }
+
+        return r;
+    }
+
+    /* Remainder of 'x' divided by the monic polynomial 'y'. */
+    template <std::size_t Len1, std::size_t Len2>
+    static std::array<gf_t, Len2 - 1u> remainder(
+            const std::array<gf_t, Len1>& x, const std::array<gf_t, Len2>& y) {
+        std::array<gf_t, Len1> d = x;
+
+        for (std::size_t i = 0u; i < Len1 - Len2 + 1u; i++) {
+            if (d[i] != 0u) {
+                mul_add_region(&d[i + 1u], &y[1u], d[i], Len2 - 1u);
+            }
+        }
+
+        std::array<gf_t, Len2 - 1u> r;
+
+        for (std::size_t i = 0u; i < Len2 - 1u; i++) {
+            r[i] = d[Len1 - Len2 + 1u + i];
+        }
+
+        return r;
+    }
+};
+
+namespace GaloisFieldBackends {
+    struct Carryless {
+        template <std::size_t M, typename Primitive>
+        using field = CarrylessGaloisField<M, Primitive>;
+    };
+}
+
+namespace CarrylessPolynomials {
+    /* x^32 + x^22 + x^2 + x + 1. */
+    using m_32 = BinarySequence<1,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1>;
+
+    /* x^64 + x^4 + x^3 + x + 1. */
+    using m_64 = BinarySequence<1,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, 1, 1>;
+}
+
+}
@@ -0,0 +1,276 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(USE_SIMD_X86)
+    #include <x86intrin.h>
+#endif
+
+#include "FEC/Types.h"
+
+namespace Thiemar {
+
+namespace ChannelInterleaver {
+
+namespace Operations {
+
+/*
+Transpose a rows x cols matrix of bytes stored row-major in 'in', writing
+the cols x rows result to 'out'. The matrix is processed in square tiles
+so that both the reads and the writes of each tile stay within a handful
+of cache lines, rather than striding through the whole output buffer for
+every input row.
+*/
+static constexpr std::size_t transpose_tile_size() { return 16u; }
+
+static inline void transpose_bytes(const uint8_t *in, std::size_t in_stride, uint8_t *out, std::size_t out_stride,
+        std::size_t rows, std::size_t cols) {
+    for (std::size_t r0 = 0u; r0 < rows; r0 += transpose_tile_size()) {
+        std::size_t r1 = (r0 + transpose_tile_size() < rows) ? r0 + transpose_tile_size() : rows;
+        for (std::size_t c0 = 0u; c0 < cols; c0 += transpose_tile_size()) {
+            std::size_t c1 = (c0 + transpose_tile_size() < cols) ? c0 + transpose_tile_size() : cols;
+            for (std::size_t r = r0; r < r1; r++) {
+                for (std::size_t c = c0; c < c1; c++) {
+                    out[c * out_stride + r] = in[r * in_stride + c];
+                }
+            }
+        }
+    }
+}
+
+/* Transpose an 8 x 8 bit matrix, with row 0 in the most significant byte. */
+static constexpr uint64_t transpose_8x8(uint64_t x) {
+    x = (x & 0xAA55AA55AA55AA55u) | ((x & 0x00AA00AA00AA00AAu) << 7u) | ((x >> 7u) & 0x00AA00AA00AA00AAu);
+    x = (x & 0xCCCC3333CCCC3333u) | ((x & 0x0000CCCC0000CCCCu) << 14u) | ((x >> 14u) & 0x0000CCCC0000CCCCu);
+    x = (x & 0xF0F0F0F00F0F0F0Fu) | ((x & 0x00000000F0F0F0F0u) << 28u) | ((x >> 28u) & 0x00000000F0F0F0F0u);
+    return x;
+}
+
+/*
+Transpose the bit matrix region [r0, r1) x [c0, c1) of a rows x cols
+matrix, packed MSB-first in row-major order. If the region is aligned to
+whole bytes in both the input and the output, it is processed as 8 x 8 bit
+tiles; otherwise one bit at a time.
+*/
+static inline void transpose_bits(const uint8_t *in, std::size_t rows, std::size_t cols, uint8_t *out,
+        std::size_t r0, std::size_t r1, std::size_t c0, std::size_t c1) {
+    if (!((rows | cols | r0 | r1 | c0 | c1) % 8u)) {
+        for (std::size_t r = r0; r < r1; r += 8u) {
+            for (std::size_t c = c0; c < c1; c += 8u) {
+                uint64_t x = 0u;
+                for (std::size_t i = 0u; i < 8u; i++) {
+                    x = (x << 8u) | in[((r + i) * cols + c) / 8u];
+                }
+
+                x = transpose_8x8(x);
+                for (std::size_t i = 0u; i < 8u; i++) {
+                    out[((c + i) * rows + r) / 8u] = (uint8_t)(x >> (56u - 8u * i));
+                }
+            }
+        }
+    } else {
+        for (std::size_t r = r0; r < r1; r++) {
+            for (std::size_t c = c0; c < c1; c++) {
+                std::size_t i = r * cols + c;
+                std::size_t o = c * rows + r;
+                uint8_t bit = 0x80u >> (o % 8u);
+                out[o / 8u] = (in[i / 8u] & (0x80u >> (i % 8u))) ? (out[o / 8u] | bit) : (out[o / 8u] & ~bit);
+            }
+        }
+    }
+}
+
+/*
+Transpose operations on bytes (T = uint8_t) or packed bits (T = bool). The
+SIMD specialisations handle whole 16 x 16 byte tiles and fall back to the
+generic functions for the edges.
+*/
+template <typename T>
+struct transpose_op_container {
+    static void op(const uint8_t *in, std::size_t rows, std::size_t cols, uint8_t *out) {
+        if constexpr (std::is_same<T, bool>::value) {
+            transpose_bits(in, rows, cols, out, 0u, rows, 0u, cols);
+        } else {
+            transpose_bytes(in, cols, out, rows, rows, cols);
+        }
+    }
+};
+
+/* Include any specialisations. */
+#if defined(USE_SIMD_X86)
+#include "FEC/ChannelInterleaverSIMD_x86.h"
+#endif
+
+template <typename T>
+void transpose(const uint8_t *in, std::size_t rows, std::size_t cols, uint8_t *out) {
+    transpose_op_container<T>::op(in, rows, cols, out);
+}
+
+}
+
+/*
+Row/column block interleaver. Symbols are written into a Rows x Cols
+matrix row by row and read out column by column, so a burst of up to Rows
+consecutive channel errors is spread over Rows different rows, each of
+which is typically one codeword of the inner or outer code. 'T' selects
+whether the symbols are bytes (uint8_t) or bits (bool, packed MSB-first).
+*/
+template <std::size_t Rows, std::size_t Cols, typename T = uint8_t>
+class BlockInterleaver {
+    static_assert(Rows > 0u && Cols > 0u, "Interleaver dimensions must be larger than zero");
+    static_assert(std::is_same<T, uint8_t>::value || std::is_same<T, bool>::value,
+        "Interleaver symbols must be bytes or bits");
+    static_assert(!std::is_same<T, bool>::value || !((Rows * Cols) % 8u),
+        "Bit interleaver size must be a whole number of bytes");
+
+public:
+    /* Size of an interleaver block in bytes. */
+    static constexpr std::size_t size() {
+        return std::is_same<T, bool>::value ? (Rows * Cols) / 8u : Rows * Cols;
+    }
+
+    static void interleave(const uint8_t *in, uint8_t *out) {
+        Operations::transpose<T>(in, Rows, Cols, out);
+    }
+
+    static void deinterleave(const uint8_t *in, uint8_t *out) {
+        Operations::transpose<T>(in, Cols, Rows, out);
+    }
+
+    static std::array<uint8_t, size()> interleave(const std::array<uint8_t, size()> &in) {
+        std::array<uint8_t, size()> out = {};
+        interleave(in.data(), out.data());
+        return out;
+    }
+
+    static std::array<uint8_t, size()> deinterleave(const std::array<uint8_t, size()> &in) {
+        std::array<uint8_t, size()> out = {};
+        deinterleave(in.data(), out.data());
+        return out;
+    }
+};
+
+/*
+Convolutional (Forney) interleaver with 'Branches' branches, where branch j
+delays its symbols by j * Delay commutator cycles. The deinterleaver uses
+the complementary delays (Branches - 1 - j) * Delay, so the overall delay
+through both is Branches * (Branches - 1) * Delay symbols, about half the
+latency and memory of a block interleaver with the same burst spreading.
+
+Symbol n passes through branch n mod Branches, so branch j is just the
+input delayed by j * Delay * Branches symbols. Rather than keeping a
+separate FIFO per branch, all branches therefore share one power-of-two
+ring buffer of recent input, and each output is a single masked lookup.
+State is kept between calls, so a stream can be processed in arbitrary
+chunks.
+*/
+template <std::size_t Branches, std::size_t Delay, bool Deinterleave = false>
+class ConvolutionalInterleaver {
+    static_assert(Branches > 0u, "Number of branches must be larger than zero");
+
+    static constexpr std::size_t max_delay() { return (Branches - 1u) * Delay * Branches; }
+
+    static constexpr std::size_t buffer_size() {
+        std::size_t size = 1u;
+        while (size <= max_delay()) {
+            size <<= 1u;
+        }
+
+        return size;
+    }
+
+    static constexpr std::array<std::size_t, Branches> get_delays() {
+        std::array<std::size_t, Branches> delays = {};
+        for (std::size_t j = 0u; j < Branches; j++) {
+            delays[j] = (Deinterleave ? Branches - 1u - j : j) * Delay * Branches;
+        }
+
+        return delays;
+    }
+
+    static constexpr std::array<std::size_t, Branches> delays = get_delays();
+
+    std::array<uint8_t, buffer_size()> buffer = {};
+    std::size_t position = 0u;
+    std::size_t branch = 0u;
+
+public:
+    /* Number of symbols before the first input symbol appears at the output of the deinterleaver. */
+    static constexpr std::size_t latency() { return max_delay(); }
+
+    /* Clear the delay lines and reset the commutator to the first branch. */
+    void reset() {
+        buffer.fill(0u);
+        position = 0u;
+        branch = 0u;
+    }
+
+    /* Process 'len' symbols from 'in' into 'out'. The buffers may alias. */
+    void process(const uint8_t *in, std::size_t len, uint8_t *out) {
+        /*
+        Work on local copies of the state, since the byte buffers could
+        otherwise alias it.
+        */
+        uint8_t *buf = buffer.data();
+        std::size_t pos = position;
+        std::size_t j = branch;
+        std::size_t i = 0u;
+
+        /* Finish the current commutator cycle. */
+        for (; i < len && j; i++, pos++, j = (j + 1u == Branches) ? 0u : j + 1u) {
+            buf[pos % buffer_size()] = in[i];
+            out[i] = buf[(pos - delays[j]) % buffer_size()];
+        }
+
+        /* Whole commutator cycles, with the branch delays known at compile time. */
+        for (; i + Branches <= len; i += Branches, pos += Branches) {
+            for (std::size_t k = 0u; k < Branches; k++) {
+                buf[(pos + k) % buffer_size()] = in[i + k];
+                out[i + k] = buf[(pos + k - delays[k]) % buffer_size()];
+            }
+        }
+
+        /* Start of a partial cycle, which always begins on the first branch. */
+        for (; i < len; i++, pos++, j = (j + 1u == Branches) ? 0u : j + 1u) {
+            buf[pos % buffer_size()] = in[i];
+            out[i] = buf[(pos - delays[j]) % buffer_size()];
+        }
+
+        position = pos;
+        branch = j;
+    }
+};
+
+template <std::size_t Branches, std::size_t Delay>
+using ConvolutionalDeinterleaver = ConvolutionalInterleaver<Branches, Delay, true>;
+
+}
+
+}
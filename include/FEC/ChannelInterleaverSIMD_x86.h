@@ -0,0 +1,116 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include <x86intrin.h>
+
+/*
+Transpose a 16 x 16 byte tile held in 16 registers. Interleaving the low and
+high halves of rows i and i + 8 four times in succession is a perfect
+shuffle of the 256 bytes, which after four rounds is the transpose.
+*/
+static inline void transpose_16x16(__m128i (&x)[16u]) {
+    for (std::size_t round = 0u; round < 4u; round++) {
+        __m128i y[16u];
+        for (std::size_t i = 0u; i < 8u; i++) {
+            y[2u * i] = _mm_unpacklo_epi8(x[i], x[i + 8u]);
+            y[2u * i + 1u] = _mm_unpackhi_epi8(x[i], x[i + 8u]);
+        }
+
+        for (std::size_t i = 0u; i < 16u; i++) {
+            x[i] = y[i];
+        }
+    }
+}
+
+template <>
+struct transpose_op_container<uint8_t> {
+    static void op(const uint8_t *in, std::size_t rows, std::size_t cols, uint8_t *out) {
+        std::size_t rows_simd = rows - rows % 16u;
+        std::size_t cols_simd = cols - cols % 16u;
+
+        for (std::size_t r = 0u; r < rows_simd; r += 16u) {
+            for (std::size_t c = 0u; c < cols_simd; c += 16u) {
+                __m128i x[16u];
+                for (std::size_t i = 0u; i < 16u; i++) {
+                    x[i] = _mm_loadu_si128((const __m128i *)&in[(r + i) * cols + c]);
+                }
+
+                transpose_16x16(x);
+                for (std::size_t i = 0u; i < 16u; i++) {
+                    _mm_storeu_si128((__m128i *)&out[(c + i) * rows + r], x[i]);
+                }
+            }
+        }
+
+        /* Right-hand columns, then bottom rows. */
+        transpose_bytes(&in[cols_simd], cols, &out[cols_simd * rows], rows, rows, cols - cols_simd);
+        transpose_bytes(&in[rows_simd * cols], cols, &out[rows_simd], rows, rows - rows_simd, cols_simd);
+    }
+};
+
+/*
+Transpose bits 16 rows and 128 columns at a time. A 16 x 16 byte tile is
+first transposed so that each register holds one byte column of the 16
+rows, with the rows in reverse order. PMOVMSKB then extracts one bit column
+for all 16 rows, already in MSB-first order, and shifting every byte left
+by one exposes the next bit column.
+*/
+template <>
+struct transpose_op_container<bool> {
+    static void op(const uint8_t *in, std::size_t rows, std::size_t cols, uint8_t *out) {
+        if ((rows | cols) % 8u) {
+            transpose_bits(in, rows, cols, out, 0u, rows, 0u, cols);
+            return;
+        }
+
+        std::size_t rows_simd = rows - rows % 16u;
+        std::size_t cols_simd = cols - cols % 128u;
+
+        for (std::size_t r = 0u; r < rows_simd; r += 16u) {
+            for (std::size_t c = 0u; c < cols_simd; c += 128u) {
+                __m128i x[16u];
+                for (std::size_t i = 0u; i < 16u; i++) {
+                    x[15u - i] = _mm_loadu_si128((const __m128i *)&in[((r + i) * cols + c) / 8u]);
+                }
+
+                transpose_16x16(x);
+                for (std::size_t i = 0u; i < 16u; i++) {
+                    for (std::size_t b = 0u; b < 8u; b++) {
+                        uint32_t mask = (uint32_t)_mm_movemask_epi8(x[i]);
+                        uint8_t *dst = &out[((c + i * 8u + b) * rows + r) / 8u];
+                        dst[0] = (uint8_t)(mask >> 8u);
+                        dst[1] = (uint8_t)mask;
+                        x[i] = _mm_add_epi8(x[i], x[i]);
+                    }
+                }
+            }
+        }
+
+        /* Right-hand columns, then bottom rows. */
+        transpose_bits(in, rows, cols, out, 0u, rows, cols_simd, cols);
+        transpose_bits(in, rows, cols, out, rows_simd, rows, 0u, cols_simd);
+    }
+};
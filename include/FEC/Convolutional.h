@@ -23,11 +23,18 @@ SOFTWARE.
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
+#if defined(USE_SIMD_X86)
+  #include <x86intrin.h>
+#endif
+
 #include "FEC/Types.h"
 #include "FEC/Utilities.h"
 #include "FEC/BinarySequence.h"
@@ -35,24 +42,6 @@ SOFTWARE.
 
 namespace Thiemar {
 
-namespace Detail {
-    /* Create a Hamming distance look-up table for the given type. */
-    template <typename T, std::size_t NumPoly, T PunctureMask, T Reference>
-    class HammingDistance {
-        template <std::size_t... I>
-        static constexpr std::array<T, sizeof...(I)> get_hamming_table_elements(std::index_sequence<I...>) {
-            return std::array<T, sizeof...(I)>{ calculate_hamming_weight((I ^ Reference) & PunctureMask) ... };
-        }
-
-    public:
-        static constexpr std::array<T, (std::size_t)1u << NumPoly> table =
-            get_hamming_table_elements(std::make_index_sequence<(std::size_t)1u << NumPoly>{});
-    };
-
-    template <typename T, std::size_t NumPoly, T PunctureMask, T Reference>
-    constexpr std::array<T, (std::size_t)1u << NumPoly> HammingDistance<T, NumPoly, PunctureMask, Reference>::table;
-}
-
 namespace Convolutional {
 
 /*
@@ -111,6 +100,15 @@ class PuncturedConvolutionalEncoder {
 
     using interleaver = Interleaver<PuncturingMatrix, sizeof...(Polynomials), block_size()>;
 
+    /*
+    Number of input bytes read by encode_block, which is the block size
+    rounded up to a whole number of words.
+    */
+    static constexpr std::size_t read_size() {
+        return (block_size() / sizeof(bool_vec_t) + ((block_size() % sizeof(bool_vec_t)) ? 1u : 0u)) *
+            sizeof(bool_vec_t);
+    }
+
     /*
     Pull in a number of data bits from 'in' corresponding to the size of the
     bool_vec_t data type.
@@ -195,242 +193,1638 @@ public:
 
     /*
     Do efficient convolutional encoding by carrying out a number of
-    convolutions in parallel equal to the word size.
+    convolutions in parallel equal to the word size. The 'out' buffer must
+    have space for calculate_output_length(len) bytes.
     */
+    static void encode(const uint8_t *in, std::size_t len, uint8_t *out) {
+        /*
+        Blocks are read directly from the input buffer where possible. Blocks
+        at the start and end of the buffer, which need leading constraint
+        bytes or trailing flush bytes, are staged in a temporary array.
+        */
+        constexpr std::size_t flush_bytes = ConstraintLength / 8u + ((ConstraintLength % 8u) ? 1u : 0u);
+        const std::size_t out_len = calculate_output_length(len);
+
+        std::size_t out_idx = 0u;
+        for (std::size_t i = 0u; i < len + flush_bytes; i += block_size()) {
+            std::array<uint8_t, interleaver::out_buf_len()> out_block;
+
+            if (i >= flush_bytes && i + read_size() <= len) {
+                out_block = encode_block(&in[i]);
+            } else {
+                std::array<uint8_t, read_size() + flush_bytes> in_block = {};
+                std::size_t start = i - std::min(i, flush_bytes);
+                std::size_t end = std::min(len, i + read_size());
+                if (end > start) {
+                    std::copy_n(in + start, end - start, in_block.begin() + flush_bytes - (i - start));
+                }
+                out_block = encode_block(&in_block[flush_bytes]);
+            }
+
+            std::copy_n(out_block.begin(), std::min(interleaver::out_buf_len(), out_len - out_idx), out + out_idx);
+            out_idx += std::min(interleaver::out_buf_len(), out_len - out_idx);
+        }
+    }
+
     template <std::size_t Len>
     static std::array<uint8_t, calculate_output_length(Len)> encode(const std::array<uint8_t, Len> &in) {
         std::array<uint8_t, calculate_output_length(Len)> out;
+        encode(in.data(), Len, out.data());
+        return out;
+    }
+
+    /*
+    Calculate the number of output bytes for a given tail-biting input
+    length. No flush bits are appended, so the output only covers the
+    message itself.
+    */
+    static constexpr std::size_t calculate_tail_biting_output_length(std::size_t len) {
+        std::size_t out_len = len * 8u * sizeof...(Polynomials) * PuncturingMatrix::ones();
+
+        if (out_len % PuncturingMatrix::size()) {
+            out_len = out_len / PuncturingMatrix::size() + 1u;
+        } else {
+            out_len /= PuncturingMatrix::size();
+        }
+
+        return out_len % 8u ? (out_len / 8u) + 1u : out_len / 8u;
+    }
+
+    /*
+    Do tail-biting convolutional encoding. Rather than starting from the zero
+    state and flushing with zero bits, the encoder state is initialised from
+    the last (ConstraintLength - 1) bits of the message so that the trellis
+    path starts and ends in the same state. Any padding bits in the final
+    output byte are cleared.
+    */
+    template <std::size_t Len>
+    static std::array<uint8_t, calculate_tail_biting_output_length(Len)> encode_tail_biting(
+            const std::array<uint8_t, Len> &in) {
+        static_assert(Len > 0u, "Tail-biting frame must contain at least one byte");
+        static_assert((Len * 8u) % (PuncturingMatrix::size() / sizeof...(Polynomials)) == 0u,
+            "Tail-biting frame length must be an integer number of puncturing matrix cycles");
+
+        constexpr std::size_t out_len = calculate_tail_biting_output_length(Len);
+        std::array<uint8_t, out_len> out;
 
         /*
-        Use temporary arrays to allow input and output lengths of sizes which
-        aren't integer multiples of the block size.
+        The leading constraint bytes of the first block are taken from the
+        end of the message, wrapping around for very short messages.
         */
         constexpr std::size_t flush_bytes = ConstraintLength / 8u + ((ConstraintLength % 8u) ? 1u : 0u);
         std::size_t out_idx = 0u;
-        for (std::size_t i = 0u; i < Len + flush_bytes; i += block_size()) {
-            std::array<uint8_t, block_size() + flush_bytes> in_block = {};
-            std::copy_n(in.begin() + i - std::min(i, flush_bytes),
-                std::min(block_size(), Len - i) + std::min(i, flush_bytes),
-                in_block.begin() + flush_bytes - std::min(i, flush_bytes));
+        for (std::size_t i = 0u; i < Len; i += block_size()) {
+            std::array<uint8_t, read_size() + flush_bytes> in_block = {};
+            for (std::size_t j = 0u; j < flush_bytes; j++) {
+                in_block[j] = in[(Len * flush_bytes + i + j - flush_bytes) % Len];
+            }
+
+            std::copy_n(in.begin() + i, std::min(block_size(), Len - i), in_block.begin() + flush_bytes);
 
             std::array<uint8_t, interleaver::out_buf_len()> out_block = encode_block(&in_block[flush_bytes]);
-            std::copy_n(out_block.begin(), std::min(interleaver::out_buf_len(), calculate_output_length(Len) - out_idx),
+            std::copy_n(out_block.begin(), std::min(interleaver::out_buf_len(), out_len - out_idx),
                 out.begin() + out_idx);
 
-            out_idx += std::min(interleaver::out_buf_len(), calculate_output_length(Len) - out_idx);
+            out_idx += std::min(interleaver::out_buf_len(), out_len - out_idx);
         }
 
+        constexpr std::size_t pad_bits = out_len * 8u -
+            (Len * 8u * PuncturingMatrix::ones()) / (PuncturingMatrix::size() / sizeof...(Polynomials));
+        out[out_len - 1u] &= (uint8_t)(0xffu << pad_bits);
+
         return out;
     }
 };
 
-/* Decoder implementing the Viterbi algorithm using hard-decisions. */
-template <std::size_t ConstraintLength, std::size_t TracebackLength, typename PuncturingMatrix, typename... Polynomials>
-class PuncturedHardDecisionViterbiDecoder {
+/*
+Convolutional encoder using compile-time lookup tables, producing output
+identical to PuncturedConvolutionalEncoder. The code is linear, so the
+outputs for the eight steps of an input byte are the XOR of the
+contributions of that byte and each earlier byte within the constraint
+length. Each contribution is looked up in a table indexed by byte value and
+puncturing phase, and is already punctured and ordered for transmission, so
+each input byte takes one lookup per byte of history.
+*/
+template <std::size_t ConstraintLength, typename PuncturingMatrix, typename... Polynomials>
+class PuncturedTableConvolutionalEncoder {
     static_assert(ConstraintLength > 1u, "Constraint length must be at least two");
     static_assert(sizeof...(Polynomials) > 1u, "Minimum of two polynomials are required");
-    static_assert(sizeof...(Polynomials) <= 8u, "Maximum supported code rate is 1/8");
+    static_assert(sizeof...(Polynomials) <= 4u, "Maximum supported code rate is 1/4");
     static_assert(Detail::all_true<(Polynomials::size() == ConstraintLength)...>::value,
         "Length of polynomials must be equal to constraint length");
     static_assert(PuncturingMatrix::size() % sizeof...(Polynomials) == 0u,
         "Puncturing matrix size must be an integer multiple of the code rate");
     static_assert(PuncturingMatrix::size() > 0u, "Puncturing matrix size must be larger than zero");
-    static_assert(PuncturingMatrix::size() <= ConstraintLength*sizeof...(Polynomials),
-        "Puncturing matrix size must be no greater than the constraint length multiplied by the code rate");
-    static_assert(TracebackLength % (PuncturingMatrix::size() / sizeof...(Polynomials)) == 0u,
-        "Traceback length must be an integer multiple of puncturing matrix row length");
-    static_assert(TracebackLength % 8u == 0u, "Traceback length must be a multiple of eight");
-    static_assert(sizeof(bool_vec_t) * 8u / PuncturingMatrix::ones() > 0u,
-        "Word size must be large enough to fit at least one puncturing matrix cycle");
 
-    using metric_t = bool_vec_t;
-    using state_vec_t = bool_vec_t;
-    using bit_vec_t = uint8_t;
+    using table_t = uint32_t;
 
-    static constexpr std::size_t num_states() { return (state_vec_t)1u << (ConstraintLength - 1u); }
+    static constexpr std::size_t puncturing_row_len() { return PuncturingMatrix::size() / sizeof...(Polynomials); }
 
-    /* Number of bool_vec_t required for a decision vector. */
-    static constexpr std::size_t decision_size() {
-        return std::max((num_states() / 8u) / sizeof(bool_vec_t) +
-            ((num_states() / 8u) % sizeof(bool_vec_t) ? 1u : 0u), (std::size_t)1u);
+    /* Number of input bytes after which the puncturing pattern repeats. */
+    static constexpr std::size_t num_phases() {
+        std::size_t phases = 1u;
+        while ((phases * 8u) % puncturing_row_len()) {
+            phases++;
+        }
+
+        return phases;
     }
 
-    /*
-    Number of output bytes generated per call of decode_block. This number is
-    calculated to consume an integer number of input bytes.
-    */
-    static constexpr std::size_t block_size() {
-        std::size_t puncturing_row_len = PuncturingMatrix::size() / sizeof...(Polynomials);
-        return sizeof(bool_vec_t) > puncturing_row_len ? (sizeof(bool_vec_t) / puncturing_row_len) * puncturing_row_len :
-            puncturing_row_len;
+    /* Number of earlier bytes which contribute to the outputs of a byte. */
+    static constexpr std::size_t history_bytes() { return (ConstraintLength + 6u) / 8u; }
+
+    /* Number of output bits for an input byte in each puncturing phase. */
+    static constexpr std::array<std::size_t, num_phases()> get_output_bits() {
+        std::array<std::size_t, num_phases()> bits = {};
+
+        for (std::size_t p = 0u; p < num_phases(); p++) {
+            for (std::size_t i = 0u; i < 8u; i++) {
+                std::size_t col = (p * 8u + i) % puncturing_row_len();
+                for (std::size_t q = 0u; q < sizeof...(Polynomials); q++) {
+                    bits[p] += PuncturingMatrix::test(col * sizeof...(Polynomials) + q) ? 1u : 0u;
+                }
+            }
+        }
+
+        return bits;
     }
 
-    using interleaver = Interleaver<PuncturingMatrix, sizeof...(Polynomials), block_size()>;
+    /*
+    Table of the output contribution of the byte 'd' bytes before the
+    current one, for each phase and byte value. Output bits are right-aligned
+    with the first transmitted bit most significant.
+    */
+    static constexpr std::array<table_t, (history_bytes() + 1u) * num_phases() * 256u> get_table() {
+        constexpr std::size_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        std::array<table_t, (history_bytes() + 1u) * num_phases() * 256u> table = {};
+
+        for (std::size_t d = 0u; d <= history_bytes(); d++) {
+            for (std::size_t p = 0u; p < num_phases(); p++) {
+                for (std::size_t v = 0u; v < 256u; v++) {
+                    table_t entry = 0u;
+                    for (std::size_t i = 0u; i < 8u; i++) {
+                        std::size_t col = (p * 8u + i) % puncturing_row_len();
+                        for (std::size_t q = 0u; q < sizeof...(Polynomials); q++) {
+                            if (!PuncturingMatrix::test(col * sizeof...(Polynomials) + q)) {
+                                continue;
+                            }
+
+                            /* Input bit 'b' of the byte has a delay of (8d + i - b) at step 'i'. */
+                            bool bit = false;
+                            for (std::size_t b = 0u; b < 8u; b++) {
+                                std::size_t delay = d * 8u + i - b;
+                                if (d * 8u + i >= b && delay < ConstraintLength && (v & (0x80u >> b))) {
+                                    bit ^= (poly_vec[q] >> (ConstraintLength - 1u - delay)) & 1u;
+                                }
+                            }
+
+                            entry = (entry << 1u) | (bit ? 1u : 0u);
+                        }
+                    }
+
+                    table[(d * num_phases() + p) * 256u + v] = entry;
+                }
+            }
+        }
 
-    /* Decode a number of bits equal to the traceback length. */
-    static std::size_t decode_traceback(const uint8_t *in, std::size_t len, uint8_t *out, metric_t *path_metrics) {
-        std::size_t traceback_bits = std::min(calculate_output_length(len) * 8u, TracebackLength);
+        return table;
+    }
 
-        bool_vec_t decisions[TracebackLength * decision_size()] = {};
-        metric_t temp_path_metrics[num_states()];
+    static constexpr std::array<std::size_t, num_phases()> output_bits = get_output_bits();
+    static constexpr std::array<table_t, (history_bytes() + 1u) * num_phases() * 256u> table = get_table();
 
-        /* Do as many full block operations as required. */
-        std::size_t i = 0u, idx = 0u;
-        for (; i < TracebackLength / (block_size() * 8u); i++) {
-            decode_block(&in[idx], path_metrics, temp_path_metrics, &decisions[i * block_size() * 8u * decision_size()],
-                std::make_index_sequence<block_size() * 8u>{});
-            idx += interleaver::out_buf_len();
+    /*
+    Encode one input byte, writing completed 32-bit words of output. The
+    'in' pointer should have the history bytes below it in memory.
+    */
+    template <std::size_t Phase, std::size_t... HistoryIndices>
+    static void encode_byte(const uint8_t *in, uint64_t &acc, std::size_t &acc_bits, uint8_t *&out,
+            std::index_sequence<HistoryIndices...>) {
+        acc = (acc << output_bits[Phase]) |
+            (table[(HistoryIndices * num_phases() + Phase) * 256u + in[-(std::ptrdiff_t)HistoryIndices]] ^ ...);
+        acc_bits += output_bits[Phase];
+
+        if (acc_bits >= 32u) {
+            acc_bits -= 32u;
+            out[0u] = (uint8_t)(acc >> (acc_bits + 24u));
+            out[1u] = (uint8_t)(acc >> (acc_bits + 16u));
+            out[2u] = (uint8_t)(acc >> (acc_bits + 8u));
+            out[3u] = (uint8_t)(acc >> acc_bits);
+            out += 4u;
         }
+    }
+
+    /* Encode one byte of each puncturing phase. */
+    template <std::size_t... Phases>
+    static void encode_group(const uint8_t *in, uint64_t &acc, std::size_t &acc_bits, uint8_t *&out,
+            std::index_sequence<Phases...>) {
+        (encode_byte<Phases>(&in[Phases], acc, acc_bits, out, std::make_index_sequence<history_bytes() + 1u>{}), ...);
+    }
 
-        /* Do a final partial block operation if needed. */
-        if constexpr ((TracebackLength % (block_size() * 8u)) != 0u) {
-            decode_block(&in[idx], path_metrics, temp_path_metrics, &decisions[i * block_size() * 8u * decision_size()],
-                std::make_index_sequence<TracebackLength % (block_size() * 8u)>{});
+    /* Upper bound on the number of bytes written by encode_group. */
+    static constexpr std::size_t group_out_bytes() {
+        std::size_t bits = 0u;
+        for (std::size_t p = 0u; p < num_phases(); p++) {
+            bits += output_bits[p];
         }
 
-        /* Find best path metric at the end. */
-        state_vec_t min_path = std::min_element(path_metrics, path_metrics + num_states()) - path_metrics;
+        return (bits / 32u + 1u) * 4u;
+    }
 
-        /* Run traceback. */
-        state_vec_t state = min_path;
-        for (std::size_t i = 0u; i < traceback_bits; i++) {
-            std::size_t coarse_offset = state / (sizeof(bool_vec_t) * 8u);
-            std::size_t fine_offset = state % (sizeof(bool_vec_t) * 8u);
+public:
+    /* Calculate the number of output bytes for a given input length. */
+    static constexpr std::size_t calculate_output_length(std::size_t len) {
+        return PuncturedConvolutionalEncoder<ConstraintLength, PuncturingMatrix, Polynomials...>::
+            calculate_output_length(len);
+    }
 
-            out[(traceback_bits - i - 1u) / 8u] |= (state & (num_states() / 2u)) ? (uint8_t)1u << (i % 8u) : 0u;
+    /* Encode 'len' bytes into 'out', which must hold calculate_output_length(len) bytes. */
+    static void encode(const uint8_t *in, std::size_t len, uint8_t *out) {
+        const std::size_t out_len = calculate_output_length(len);
 
-            state <<= 1u;
+        uint64_t acc = 0u;
+        std::size_t acc_bits = 0u;
+        std::size_t out_idx = 0u;
 
-            if (decisions[(traceback_bits - i - 1u) * decision_size() + coarse_offset] & ((bool_vec_t)1u << fine_offset)) {
-                state |= 1u;
+        /*
+        Input is followed by zero bytes to flush the encoder and fill the
+        last output byte. Groups near the start and end of the buffers are
+        staged in temporary arrays.
+        */
+        for (std::size_t i = 0u; out_idx < out_len; i += num_phases()) {
+            const uint8_t *group_in = in + std::min(i, len);
+            uint8_t in_block[history_bytes() + num_phases()];
+            if (i < history_bytes() || i + num_phases() > len) {
+                for (std::size_t j = 0u; j < history_bytes() + num_phases(); j++) {
+                    in_block[j] = (i + j >= history_bytes() && i + j - history_bytes() < len) ?
+                        in[i + j - history_bytes()] : 0u;
+                }
+
+                group_in = &in_block[history_bytes()];
             }
 
-            state &= num_states() - 1u;
+            if (out_idx + group_out_bytes() <= out_len) {
+                uint8_t *group_out = &out[out_idx];
+                encode_group(group_in, acc, acc_bits, group_out, std::make_index_sequence<num_phases()>{});
+                out_idx = group_out - out;
+            } else {
+                uint8_t out_block[group_out_bytes()];
+                uint8_t *group_out = out_block;
+                encode_group(group_in, acc, acc_bits, group_out, std::make_index_sequence<num_phases()>{});
+
+                std::size_t n = std::min((std::size_t)(group_out - out_block), out_len - out_idx);
+                std::copy_n(out_block, n, out + out_idx);
+                out_idx += n;
+            }
         }
+    }
 
-        return traceback_bits / 8u;
+    template <std::size_t Len>
+    static std::array<uint8_t, calculate_output_length(Len)> encode(const std::array<uint8_t, Len> &in) {
+        std::array<uint8_t, calculate_output_length(Len)> out;
+        encode(in.data(), Len, out.data());
+        return out;
     }
+};
 
-    /* Decode a block of bytes. */
-    template <std::size_t... BitIndices>
-    static void decode_block(const uint8_t *in,
-            metric_t *path_metrics_1, metric_t *path_metrics_2,
-            bool_vec_t *decisions, std::index_sequence<BitIndices...>) {
-        /* Deinterleave the block into boolean vectors. */
-        std::array<bool_vec_t, interleaver::in_buf_len()> in_vec = interleaver::deinterleave(
-            Detail::to_array<uint8_t, interleaver::out_buf_len()>(in));
+/*
+Recursive systematic convolutional (RSC) encoder. Each step transmits the
+message bit followed by one parity bit per feedforward polynomial, and the
+bit shifted into the register is the message bit XOR the feedback taps of
+the state, using the same register convention as the feedforward encoder.
+After the message, the trellis is terminated by K - 1 steps which shift in
+zero bits, whose systematic and parity bits are also transmitted. The
+output is punctured and packed MSB-first.
+
+Feedback makes the word-parallel convolutions of the feedforward encoder
+inapplicable, but the encoder is still linear over GF(2): the outputs and
+next state after a byte of input are the XOR of the response to that byte
+from the zero state and the responses to each byte of the current state
+with zero input. Each of these is a compile-time table indexed by byte
+value and puncturing phase, so each input byte takes one lookup per byte of
+state plus one.
+*/
+template <std::size_t ConstraintLength, typename PuncturingMatrix, typename FeedbackPolynomial,
+    typename... Polynomials>
+class PuncturedRecursiveSystematicEncoder {
+    static_assert(ConstraintLength > 1u, "Constraint length must be at least two");
+    static_assert(sizeof...(Polynomials) > 0u, "Minimum of one feedforward polynomial is required");
+    static_assert(sizeof...(Polynomials) <= 3u, "Maximum supported code rate is 1/4");
+    static_assert(FeedbackPolynomial::size() == ConstraintLength &&
+        Detail::all_true<(Polynomials::size() == ConstraintLength)...>::value,
+        "Length of polynomials must be equal to constraint length");
+    static_assert(FeedbackPolynomial::template test<ConstraintLength - 1u>(),
+        "Feedback polynomial must include the undelayed input");
+    static_assert(PuncturingMatrix::size() % (sizeof...(Polynomials) + 1u) == 0u,
+        "Puncturing matrix size must be an integer multiple of the code rate");
+    static_assert(PuncturingMatrix::size() > 0u, "Puncturing matrix size must be larger than zero");
 
-        /*
-        Each iteration, we need the current and next path metrics. The
-        calculate_trellis_step function takes the current path metrics and
-        returns the new path metrics.
-        */
-        (calculate_trellis_step<BitIndices % (PuncturingMatrix::size() / sizeof...(Polynomials))>(
-            get_in_bits<BitIndices>(in_vec.data(), std::make_index_sequence<sizeof...(Polynomials)>{}),
-            BitIndices % 2u ? path_metrics_2 : path_metrics_1,
-            BitIndices % 2u ? path_metrics_1 : path_metrics_2,
-            &decisions[BitIndices * decision_size()], std::make_integer_sequence<state_vec_t, num_states()>{}), ...);
-    }
+    /* Outputs in the low 32 bits, with the first transmitted bit most significant, and next state above. */
+    using table_t = uint64_t;
+
+    static constexpr std::size_t num_outputs() { return sizeof...(Polynomials) + 1u; }
+    static constexpr std::size_t puncturing_row_len() { return PuncturingMatrix::size() / num_outputs(); }
+    static constexpr std::size_t state_mask() { return ((std::size_t)1u << (ConstraintLength - 1u)) - 1u; }
+    static constexpr std::size_t state_bytes() { return (ConstraintLength + 6u) / 8u; }
 
-    template <std::size_t BitIndex, std::size_t... PolyIndices>
-    static bit_vec_t get_in_bits(const bool_vec_t *in_vec, std::index_sequence<PolyIndices...>) {
-        constexpr std::size_t coarse_offset = BitIndex / (sizeof(bool_vec_t) * 8u);
-        constexpr std::size_t fine_offset = BitIndex % (sizeof(bool_vec_t) * 8u);
+    /* Number of input bytes after which the puncturing pattern repeats. */
+    static constexpr std::size_t num_phases() {
+        std::size_t phases = 1u;
+        while ((phases * 8u) % puncturing_row_len()) {
+            phases++;
+        }
 
-        return (((in_vec[coarse_offset * sizeof...(Polynomials) + PolyIndices] &
-            ((bool_vec_t)1u << ((sizeof(bool_vec_t) * 8u)-1u - fine_offset))) ? (1u << PolyIndices) : 0u) | ...);
+        return phases;
     }
 
-    template <std::size_t PunctureIndex, state_vec_t... StateIndices>
-    static void calculate_trellis_step(bit_vec_t in_bits,
-            const metric_t *cur_path_metrics, metric_t *next_path_metrics,
-            bool_vec_t *decisions, std::integer_sequence<state_vec_t, StateIndices...>) {
-        /* Carry out add-compare-select for each possible state. */
-        ((next_path_metrics[StateIndices] = add_compare_select<
-            calculate_puncture_mask<PunctureIndex>(std::make_index_sequence<sizeof...(Polynomials)>{}), StateIndices>(
-            in_bits, cur_path_metrics, decisions)), ...);
+    static constexpr bool parity(std::size_t reg, std::size_t poly) {
+        return Detail::calculate_hamming_weight(reg & poly) % 2u;
     }
 
-    template <std::size_t I, std::size_t... PolyIndices>
-    static constexpr bit_vec_t calculate_puncture_mask(std::index_sequence<PolyIndices...>) {
-        return ((PuncturingMatrix::test(I * sizeof...(Polynomials) + PolyIndices) << PolyIndices) | ...);
+    /*
+    Run one trellis step with message bit 'u' at puncturing column 'col',
+    appending the transmitted bits to 'out' and returning the next state.
+    */
+    static constexpr std::size_t step(std::size_t state, bool u, std::size_t col, table_t &out, std::size_t &bits) {
+        constexpr std::size_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        std::size_t reg = ((std::size_t)(u ^ parity(state, FeedbackPolynomial::to_integer())) <<
+            (ConstraintLength - 1u)) | state;
+
+        for (std::size_t q = 0u; q < num_outputs(); q++) {
+            if (PuncturingMatrix::test(col * num_outputs() + q)) {
+                out = (out << 1u) | ((q ? parity(reg, poly_vec[q - 1u]) : u) ? 1u : 0u);
+                bits++;
+            }
+        }
+
+        return reg >> 1u;
     }
 
-    /* Carry out an add-compare-select operation for a single bit. */
-    template <bit_vec_t PunctureMask, state_vec_t State>
-    static metric_t add_compare_select(bit_vec_t in_bits, const metric_t *prev_path_metrics, bool_vec_t *decisions) {
-        /* Work out ancestor state indices. */
-        constexpr state_vec_t ancestor_1 = State << 1u;
-        constexpr state_vec_t ancestor_2 = ancestor_1 | 1u;
+    /* Response to eight steps of input 'v' from 'state', in puncturing phase 'p'. */
+    static constexpr table_t get_entry(std::size_t p, std::size_t state, uint8_t v) {
+        table_t out = 0u;
+        std::size_t bits = 0u;
+
+        for (std::size_t i = 0u; i < 8u; i++) {
+            state = step(state, (v >> (7u - i)) & 1u, (p * 8u + i) % puncturing_row_len(), out, bits);
+        }
 
-        /* Calculate expected bits for each branch. */
-        constexpr bit_vec_t expected_bits_1 = calculate_expected_bits(ancestor_1,
-            std::make_index_sequence<sizeof...(Polynomials)>{});
-        constexpr bit_vec_t expected_bits_2 = calculate_expected_bits(ancestor_2,
-            std::make_index_sequence<sizeof...(Polynomials)>{});
+        return out | ((table_t)state << 32u);
+    }
 
-        constexpr state_vec_t idx_1 = ancestor_1 & (num_states() - 1u);
-        constexpr state_vec_t idx_2 = ancestor_2 & (num_states() - 1u);
+    static constexpr std::array<std::size_t, num_phases()> get_output_bits() {
+        std::array<std::size_t, num_phases()> bits = {};
 
-        /* Calculate updated path metrics for ancestor branches. */
-        metric_t path_1 = prev_path_metrics[idx_1] +
-            (metric_t)Detail::HammingDistance<bit_vec_t, sizeof...(Polynomials), PunctureMask, expected_bits_1>::table[in_bits];
-        metric_t path_2 = prev_path_metrics[idx_2] +
-            (metric_t)Detail::HammingDistance<bit_vec_t, sizeof...(Polynomials), PunctureMask, expected_bits_2>::table[in_bits];
+        for (std::size_t p = 0u; p < num_phases(); p++) {
+            table_t out = 0u;
+            for (std::size_t i = 0u; i < 8u; i++) {
+                step(0u, false, (p * 8u + i) % puncturing_row_len(), out, bits[p]);
+            }
+        }
 
-        /* Choose and store smallest path metric and store decision. */
-        constexpr std::size_t coarse_offset = State / (sizeof(bool_vec_t) * 8u);
-        constexpr std::size_t fine_offset = State % (sizeof(bool_vec_t) * 8u);
+        return bits;
+    }
 
-        if (path_2 < path_1) {
-            decisions[coarse_offset] |= (bool_vec_t)1u << fine_offset;
-            return path_2;
+    /*
+    Tables of the response to each byte of the state, followed by the
+    response to the input byte.
+    */
+    static constexpr std::array<table_t, (state_bytes() + 1u) * num_phases() * 256u> get_table() {
+        std::array<table_t, (state_bytes() + 1u) * num_phases() * 256u> table = {};
+
+        for (std::size_t j = 0u; j <= state_bytes(); j++) {
+            for (std::size_t p = 0u; p < num_phases(); p++) {
+                for (std::size_t v = 0u; v < 256u; v++) {
+                    table[(j * num_phases() + p) * 256u + v] = (j < state_bytes()) ?
+                        get_entry(p, (v << (8u * j)) & state_mask(), 0u) : get_entry(p, 0u, (uint8_t)v);
+                }
+            }
         }
 
-        return path_1;
+        return table;
     }
 
-    /* Calculate the expected set of encoder outputs for a given state. */
-    template <std::size_t... PolyIndices>
-    static constexpr bit_vec_t calculate_expected_bits(state_vec_t state, std::index_sequence<PolyIndices...>) {
-        constexpr state_vec_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+    static constexpr std::array<std::size_t, num_phases()> output_bits = get_output_bits();
+    static constexpr std::array<table_t, (state_bytes() + 1u) * num_phases() * 256u> table = get_table();
 
-        return (((Detail::calculate_hamming_weight(state & poly_vec[PolyIndices]) % 2u) << PolyIndices) | ...);
+    template <std::size_t... StateIndices>
+    static table_t lookup(std::size_t p, std::size_t state, uint8_t in, std::index_sequence<StateIndices...>) {
+        return table[(state_bytes() * num_phases() + p) * 256u + in] ^
+            (table[(StateIndices * num_phases() + p) * 256u + ((state >> (8u * StateIndices)) & 0xffu)] ^ ...);
     }
 
 public:
+    static constexpr std::size_t num_states() { return state_mask() + 1u; }
+
+    /*
+    Trellis of the code, for decoders. The register value on a branch is
+    (a << (K - 1)) | s, where 's' is the state and 'a' is the bit shifted
+    in, so the message bit on the branch is a XOR feedback(s), and the
+    parity bits are output(reg, q) for each feedforward polynomial q.
+    */
+    static constexpr bool feedback(std::size_t state) {
+        return parity(state, FeedbackPolynomial::to_integer());
+    }
+
+    static constexpr bool output(std::size_t reg, std::size_t q) {
+        constexpr std::size_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        return parity(reg, poly_vec[q]);
+    }
+
+    /* Number of transmitted bits for a given input length, including termination. */
+    static constexpr std::size_t calculate_output_bits(std::size_t len) {
+        std::size_t steps = len * 8u + ConstraintLength - 1u;
+        std::size_t bits = (steps / puncturing_row_len()) * PuncturingMatrix::ones();
+
+        for (std::size_t i = 0u; i < (steps % puncturing_row_len()) * num_outputs(); i++) {
+            bits += PuncturingMatrix::test(i) ? 1u : 0u;
+        }
+
+        return bits;
+    }
+
     /* Calculate the number of output bytes for a given input length. */
     static constexpr std::size_t calculate_output_length(std::size_t len) {
-        std::size_t out_bits = (len * 8u * PuncturingMatrix::size()) / (PuncturingMatrix::ones() * sizeof...(Polynomials)) +
-            (((len * 8u * PuncturingMatrix::size()) % (PuncturingMatrix::ones() * sizeof...(Polynomials))) ? 1u : 0u);
+        return calculate_output_bits(len) / 8u + ((calculate_output_bits(len) % 8u) ? 1u : 0u);
+    }
 
-        return out_bits / 8u + ((out_bits % 8u) ? 1u : 0u);
+    /* Encode 'len' bytes into 'out', which must hold calculate_output_length(len) bytes. */
+    static void encode(const uint8_t *in, std::size_t len, uint8_t *out) {
+        std::size_t state = 0u;
+        uint64_t acc = 0u;
+        std::size_t acc_bits = 0u;
+        std::size_t p = 0u;
+
+        for (std::size_t i = 0u; i < len; i++) {
+            table_t entry = lookup(p, state, in[i], std::make_index_sequence<state_bytes()>{});
+            acc = (acc << output_bits[p]) | (entry & 0xffffffffu);
+            acc_bits += output_bits[p];
+            state = (std::size_t)(entry >> 32u);
+            p = (p + 1u == num_phases()) ? 0u : p + 1u;
+
+            while (acc_bits >= 8u) {
+                acc_bits -= 8u;
+                *out++ = (uint8_t)(acc >> acc_bits);
+            }
+        }
+
+        /* Terminate the trellis, shifting in zero bits. */
+        for (std::size_t i = 0u; i < ConstraintLength - 1u; i++) {
+            state = step(state, parity(state, FeedbackPolynomial::to_integer()),
+                (len * 8u + i) % puncturing_row_len(), acc, acc_bits);
+
+            if (acc_bits >= 8u) {
+                acc_bits -= 8u;
+                *out++ = (uint8_t)(acc >> acc_bits);
+            }
+        }
+
+        if (acc_bits) {
+            *out = (uint8_t)(acc << (8u - acc_bits));
+        }
+    }
+
+    template <std::size_t Len>
+    static std::array<uint8_t, calculate_output_length(Len)> encode(const std::array<uint8_t, Len> &in) {
+        std::array<uint8_t, calculate_output_length(Len)> out;
+        encode(in.data(), Len, out.data());
+        return out;
+    }
+};
+
+namespace Operations {
+
+/*
+Calculate the offset of each element of the puncturing matrix within a
+cycle of transmitted bits, or -1 if the element is punctured.
+*/
+template <typename PuncturingMatrix>
+static constexpr std::array<std::ptrdiff_t, PuncturingMatrix::size()> get_puncture_offsets() {
+    std::array<std::ptrdiff_t, PuncturingMatrix::size()> offsets = {};
+    std::ptrdiff_t offset = 0;
+
+    for (std::size_t i = 0u; i < PuncturingMatrix::size(); i++) {
+        offsets[i] = PuncturingMatrix::test(i) ? offset++ : -1;
+    }
+
+    return offsets;
+}
+
+/*
+Depuncture whole puncturing matrix cycles, reading PuncturingMatrix::ones()
+LLRs and writing PuncturingMatrix::size() LLRs per cycle. Punctured and
+erased bits are written as zero.
+*/
+template <typename PuncturingMatrix, typename T>
+void depuncture_cycles(const T *in, const uint8_t *erasures, std::size_t cycles, T *out) {
+    constexpr std::array<std::ptrdiff_t, PuncturingMatrix::size()> offsets = get_puncture_offsets<PuncturingMatrix>();
+
+    for (std::size_t c = 0u; c < cycles; c++) {
+        for (std::size_t i = 0u; i < PuncturingMatrix::size(); i++) {
+            std::ptrdiff_t offset = offsets[i];
+            out[i] = (offset >= 0 && !(erasures && erasures[offset])) ? in[offset] : (T)0;
+        }
+
+        in += PuncturingMatrix::ones();
+        erasures = erasures ? erasures + PuncturingMatrix::ones() : nullptr;
+        out += PuncturingMatrix::size();
+    }
+}
+
+template <typename PuncturingMatrix, typename T>
+struct depuncture_op_container {
+    static void op(const T *in, const uint8_t *erasures, std::size_t cycles, T *out) {
+        depuncture_cycles<PuncturingMatrix>(in, erasures, cycles, out);
     }
+};
+
+/* Include any specialisations. */
+#if defined(USE_SIMD_X86)
+#include "FEC/DepuncturerSIMD_x86.h"
+#endif
+
+template <typename PuncturingMatrix, typename T>
+void depuncture(const T *in, const uint8_t *erasures, std::size_t cycles, T *out) {
+    depuncture_op_container<PuncturingMatrix, T>::op(in, erasures, cycles, out);
+}
+
+}
 
+/*
+Expand a stream of received LLRs back to the full rate 1/n mother code by
+inserting zero LLRs (erasures) for the bits removed by the puncturing
+matrix. An optional array of flags, one per received LLR, marks symbols
+which the demodulator has flagged as unreliable, and these are erased too.
+This lets a single rate 1/n decoder serve every punctured code rate.
+*/
+template <typename PuncturingMatrix, std::size_t NumPoly>
+class Depuncturer {
+    static_assert(PuncturingMatrix::size() % NumPoly == 0u,
+        "Puncturing matrix size must be an integer multiple of the code rate");
+    static_assert(PuncturingMatrix::ones() > 0u, "Puncturing matrix must transmit at least one bit");
+
+    static constexpr std::size_t row_len() { return PuncturingMatrix::size() / NumPoly; }
+
+public:
     /*
-    Decode a block of convolutionally encoded data using the Viterbi
-    algorithm with hard-decisions.
+    Depuncture 'steps' trellis steps, starting at the first column of the
+    puncturing matrix, into 'out', which must hold steps * NumPoly LLRs.
+    Input beyond 'len' received LLRs is treated as erased. The 'erasures'
+    array may be null; otherwise a non-zero entry erases the corresponding
+    received LLR.
     */
-    template <std::size_t Len>
-    static std::array<uint8_t, calculate_output_length(Len)> decode(const std::array<uint8_t, Len> &in) {
-        std::array<uint8_t, calculate_output_length(Len)> out = {};
+    template <typename T>
+    static void depuncture(const T *in, const uint8_t *erasures, std::size_t len, T *out, std::size_t steps) {
+        constexpr std::array<std::ptrdiff_t, PuncturingMatrix::size()> offsets =
+            Operations::get_puncture_offsets<PuncturingMatrix>();
+
+        std::size_t cycles = std::min(steps / row_len(), len / PuncturingMatrix::ones());
+        Operations::depuncture<PuncturingMatrix>(in, erasures, cycles, out);
+
+        /* Finish the remaining steps one bit at a time. */
+        for (std::size_t i = cycles * PuncturingMatrix::size(); i < steps * NumPoly; i++) {
+            std::ptrdiff_t offset = offsets[i % PuncturingMatrix::size()];
+            std::size_t idx = (i / PuncturingMatrix::size()) * PuncturingMatrix::ones() + offset;
+            out[i] = (offset >= 0 && idx < len && !(erasures && erasures[idx])) ? in[idx] : (T)0;
+        }
+    }
+};
 
-        /*
-        Initialise path metric corresponding to state 0 to 0, and all other
-        paths to a sufficiently large value.
-        */
-        metric_t path_metrics[num_states()];
-        path_metrics[0] = 0u;
-        std::fill_n(&path_metrics[1], num_states() - 1u, (metric_t)1u << (sizeof(metric_t) * 8u - 1u));
+/*
+Decision storage and traceback shared by the Viterbi decoders. The decisions
+for each trellis step are packed into a row of decision_size() words, with
+the bit for each state set if its surviving path came from the odd ancestor.
+*/
+template <std::size_t ConstraintLength>
+class ViterbiTraceback {
+    using state_vec_t = bool_vec_t;
 
-        constexpr std::size_t in_bytes = (TracebackLength / 8u) * PuncturingMatrix::ones() /
-            (PuncturingMatrix::size() / sizeof...(Polynomials));
-        std::size_t out_idx = 0u;
+    static constexpr std::size_t num_states() { return (state_vec_t)1u << (ConstraintLength - 1u); }
+
+    /* Bit-reversed value of each byte. */
+    static constexpr std::array<uint8_t, 256u> get_reversed_bytes() {
+        std::array<uint8_t, 256u> reversed = {};
+        for (std::size_t i = 0u; i < 256u; i++) {
+            for (std::size_t j = 0u; j < 8u; j++) {
+                reversed[i] |= ((i >> j) & 1u) << (7u - j);
+            }
+        }
+
+        return reversed;
+    }
+
+    static constexpr std::array<uint8_t, 256u> reversed_bytes = get_reversed_bytes();
+
+public:
+    /* Number of bool_vec_t required for a decision vector. */
+    static constexpr std::size_t decision_size() {
+        return std::max((num_states() / 8u) / sizeof(bool_vec_t) +
+            ((num_states() / 8u) % sizeof(bool_vec_t) ? 1u : 0u), (std::size_t)1u);
+    }
 
-        for (std::size_t i = 0u; i < Len; i += in_bytes) {
-            out_idx += decode_traceback(&in.data()[i], Len - i, &out[out_idx], path_metrics);
+    /* Look up the decision bit for a state within a row of decisions. */
+    static bool_vec_t get_decision(const bool_vec_t *row, state_vec_t state) {
+        constexpr std::size_t word_shift = Detail::log2(sizeof(bool_vec_t) * 8u);
+        return (row[state >> word_shift] >> (state & (sizeof(bool_vec_t) * 8u - 1u))) & 1u;
+    }
+
+    /*
+    Trace back through 'bits' decision vectors starting from 'state',
+    writing the decoded bits to 'out'. Returns the state at the start of the
+    traceback. The number of bits must be a multiple of eight.
+
+    The path is accumulated in a shift register with the state in its low
+    bits. After eight steps, the eight bits above the state are the decoded
+    bits of one output byte in reverse order.
+    */
+    static state_vec_t traceback(const bool_vec_t *decisions, std::size_t bits, state_vec_t state, uint8_t *out) {
+        for (std::size_t i = bits / 8u; i-- > 0u;) {
+            const bool_vec_t *row = &decisions[(i * 8u + 7u) * decision_size()];
+            bool_vec_t acc = state;
+
+            for (std::size_t j = 0u; j < 8u; j++) {
+                acc = (acc << 1u) | get_decision(row - j * decision_size(), acc & (num_states() - 1u));
+            }
+
+            out[i] = reversed_bytes[(acc >> (ConstraintLength - 1u)) & 0xffu];
+            state = acc & (num_states() - 1u);
         }
 
+        return state;
+    }
+};
+
+/* Decoder implementing the Viterbi algorithm using hard-decisions. */
+template <std::size_t ConstraintLength, std::size_t TracebackLength, typename PuncturingMatrix, typename... Polynomials>
+class PuncturedHardDecisionViterbiDecoder {
+    static_assert(ConstraintLength > 1u, "Constraint length must be at least two");
+    static_assert(sizeof...(Polynomials) > 1u, "Minimum of two polynomials are required");
+    static_assert(sizeof...(Polynomials) <= 8u, "Maximum supported code rate is 1/8");
+    static_assert(Detail::all_true<(Polynomials::size() == ConstraintLength)...>::value,
+        "Length of polynomials must be equal to constraint length");
+    static_assert(PuncturingMatrix::size() % sizeof...(Polynomials) == 0u,
+        "Puncturing matrix size must be an integer multiple of the code rate");
+    static_assert(PuncturingMatrix::size() > 0u, "Puncturing matrix size must be larger than zero");
+    static_assert(PuncturingMatrix::size() <= ConstraintLength*sizeof...(Polynomials),
+        "Puncturing matrix size must be no greater than the constraint length multiplied by the code rate");
+    static_assert(TracebackLength % (PuncturingMatrix::size() / sizeof...(Polynomials)) == 0u,
+        "Traceback length must be an integer multiple of puncturing matrix row length");
+    static_assert(TracebackLength % 8u == 0u, "Traceback length must be a multiple of eight");
+    static_assert(sizeof(bool_vec_t) * 8u / PuncturingMatrix::ones() > 0u,
+        "Word size must be large enough to fit at least one puncturing matrix cycle");
+
+    using metric_t = bool_vec_t;
+    using state_vec_t = bool_vec_t;
+    using bit_vec_t = uint8_t;
+
+    static constexpr std::size_t num_states() { return (state_vec_t)1u << (ConstraintLength - 1u); }
+
+    using traceback_t = ViterbiTraceback<ConstraintLength>;
+
+    static constexpr std::size_t decision_size() { return traceback_t::decision_size(); }
+
+    /*
+    Number of output bytes generated per call of decode_block. This number is
+    calculated to consume an integer number of input bytes.
+    */
+    static constexpr std::size_t block_size() {
+        std::size_t puncturing_row_len = PuncturingMatrix::size() / sizeof...(Polynomials);
+        return sizeof(bool_vec_t) > puncturing_row_len ? (sizeof(bool_vec_t) / puncturing_row_len) * puncturing_row_len :
+            puncturing_row_len;
+    }
+
+    using interleaver = Interleaver<PuncturingMatrix, sizeof...(Polynomials), block_size()>;
+
+    /*
+    Run the trellis over a compile-time number of bits, consuming whole
+    interleaver blocks from 'in'. The path metrics are updated in place.
+    */
+    template <std::size_t Bits>
+    static void decode_bits(const uint8_t *in, metric_t *path_metrics, bool_vec_t *decisions) {
+        static_assert(Bits % 2u == 0u, "Number of bits must be even");
+        metric_t temp_path_metrics[num_states()];
+
+        for (std::size_t i = 0u, idx = 0u; i < Bits; i += block_size() * 8u, idx += interleaver::out_buf_len()) {
+            decode_block(&in[idx], path_metrics, temp_path_metrics, &decisions[i * decision_size()],
+                std::min(Bits - i, block_size() * 8u));
+        }
+    }
+
+    /*
+    Decode a number of bits equal to the traceback length. Input which would
+    be read past the end of the buffer is staged in a zero-padded array.
+    */
+    static std::size_t decode_traceback(const uint8_t *in, std::size_t len, uint8_t *out, metric_t *path_metrics) {
+        std::size_t traceback_bits = std::min(calculate_output_length(len) * 8u, TracebackLength);
+
+        constexpr std::size_t read_bytes = (TracebackLength / (block_size() * 8u) +
+            ((TracebackLength % (block_size() * 8u)) ? 1u : 0u)) * interleaver::out_buf_len();
+
+        alignas(16) bool_vec_t decisions[TracebackLength * decision_size()];
+        if (len >= read_bytes) {
+            decode_bits<TracebackLength>(in, path_metrics, decisions);
+        } else {
+            uint8_t in_block[read_bytes] = {};
+            std::copy_n(in, len, in_block);
+            decode_bits<TracebackLength>(in_block, path_metrics, decisions);
+        }
+
+        /* Find best path metric at the end. */
+        state_vec_t min_path = std::min_element(path_metrics, path_metrics + num_states()) - path_metrics;
+
+        /* Run traceback. */
+        traceback_t::traceback(decisions, traceback_bits, min_path, out);
+
+        return traceback_bits / 8u;
+    }
+
+    /*
+    Number of butterflies in each unrolled group of add-compare-select
+    operations. A group produces half a decision word for each half of the
+    state space, and the loops over trellis steps and groups keep the
+    amount of generated code bounded as the constraint length grows.
+    */
+    static constexpr std::size_t unroll_width() {
+        return std::min(num_states() / 2u, sizeof(bool_vec_t) * 4u);
+    }
+
+    /*
+    Calculate the encoder outputs for each possible shift register value,
+    with the output of polynomial i in bit i.
+    */
+    static constexpr std::array<bit_vec_t, 2u * num_states()> get_branch_outputs() {
+        constexpr state_vec_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        std::array<bit_vec_t, 2u * num_states()> outputs = {};
+
+        for (std::size_t r = 0u; r < outputs.size(); r++) {
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                outputs[r] |= (Detail::calculate_hamming_weight(r & poly_vec[p]) % 2u) << p;
+            }
+        }
+
+        return outputs;
+    }
+
+    /* Calculate the mask of transmitted bits for each column of the puncturing matrix. */
+    static constexpr std::array<bit_vec_t, PuncturingMatrix::size() / sizeof...(Polynomials)> get_puncture_masks() {
+        std::array<bit_vec_t, PuncturingMatrix::size() / sizeof...(Polynomials)> masks = {};
+
+        for (std::size_t i = 0u; i < masks.size(); i++) {
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                masks[i] |= PuncturingMatrix::test(i * sizeof...(Polynomials) + p) << p;
+            }
+        }
+
+        return masks;
+    }
+
+    static constexpr std::array<bit_vec_t, (std::size_t)1u << sizeof...(Polynomials)> get_hamming_weights() {
+        std::array<bit_vec_t, (std::size_t)1u << sizeof...(Polynomials)> weights = {};
+
+        for (std::size_t i = 0u; i < weights.size(); i++) {
+            weights[i] = Detail::calculate_hamming_weight(i);
+        }
+
+        return weights;
+    }
+
+    static constexpr std::array<bit_vec_t, 2u * num_states()> branch_outputs = get_branch_outputs();
+    static constexpr std::array<bit_vec_t, PuncturingMatrix::size() / sizeof...(Polynomials)> puncture_masks =
+        get_puncture_masks();
+    static constexpr std::array<bit_vec_t, (std::size_t)1u << sizeof...(Polynomials)> hamming_weights =
+        get_hamming_weights();
+
+    /* Decode up to one block of bits from a block of bytes. */
+    static void decode_block(const uint8_t *in, metric_t *path_metrics_1, metric_t *path_metrics_2,
+            bool_vec_t *decisions, std::size_t bits) {
+        /* Deinterleave the block into boolean vectors. */
+        std::array<bool_vec_t, interleaver::in_buf_len()> in_vec = interleaver::deinterleave(
+            Detail::to_array<uint8_t, interleaver::out_buf_len()>(in));
+
+        /*
+        Each iteration, we need the current and next path metrics. The
+        calculate_trellis_step function takes the current path metrics and
+        returns the new path metrics.
+        */
+        for (std::size_t i = 0u; i < bits; i++) {
+            calculate_trellis_step(get_in_bits(in_vec.data(), i),
+                puncture_masks[i % (PuncturingMatrix::size() / sizeof...(Polynomials))],
+                i % 2u ? path_metrics_2 : path_metrics_1,
+                i % 2u ? path_metrics_1 : path_metrics_2,
+                &decisions[i * decision_size()]);
+        }
+    }
+
+    static bit_vec_t get_in_bits(const bool_vec_t *in_vec, std::size_t bit) {
+        const std::size_t coarse_offset = bit / (sizeof(bool_vec_t) * 8u);
+        const std::size_t fine_offset = (sizeof(bool_vec_t) * 8u) - 1u - bit % (sizeof(bool_vec_t) * 8u);
+
+        bit_vec_t in_bits = 0u;
+        for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+            in_bits |= ((in_vec[coarse_offset * sizeof...(Polynomials) + p] >> fine_offset) & 1u) << p;
+        }
+
+        return in_bits;
+    }
+
+    static void calculate_trellis_step(bit_vec_t in_bits, bit_vec_t puncture_mask,
+            const metric_t *cur_path_metrics, metric_t *next_path_metrics, bool_vec_t *decisions) {
+        /* Calculate the distance of each possible combination of outputs from the input. */
+        metric_t output_metrics[(std::size_t)1u << sizeof...(Polynomials)];
+        for (std::size_t c = 0u; c < ((std::size_t)1u << sizeof...(Polynomials)); c++) {
+            output_metrics[c] = hamming_weights[(in_bits ^ c) & puncture_mask];
+        }
+
+        /*
+        Carry out add-compare-select for each possible state. States s and
+        s + num_states() / 2 share the same pair of ancestors, so they are
+        processed together. Decisions are packed into a local row so that
+        each word of the row is written to memory once.
+        */
+        bool_vec_t row[decision_size()] = {};
+        for (state_vec_t s = 0u; s < num_states() / 2u; s += unroll_width()) {
+            add_compare_select(output_metrics, cur_path_metrics, next_path_metrics, row, s,
+                std::make_index_sequence<unroll_width()>{});
+        }
+
+        std::copy_n(row, decision_size(), decisions);
+    }
+
+    /*
+    Carry out add-compare-select operations for a group of butterflies,
+    packing the decisions of the group before writing them to the row.
+    */
+    template <std::size_t... Offsets>
+    static void add_compare_select(const metric_t *output_metrics, const metric_t *prev_path_metrics,
+            metric_t *next_path_metrics, bool_vec_t *decisions, state_vec_t base, std::index_sequence<Offsets...>) {
+        constexpr std::size_t word_bits = sizeof(bool_vec_t) * 8u;
+
+        bool_vec_t group_1 = ((add_compare_select(output_metrics, prev_path_metrics, next_path_metrics,
+            base + Offsets) << Offsets) | ...);
+        bool_vec_t group_2 = ((add_compare_select(output_metrics, prev_path_metrics, next_path_metrics,
+            base + Offsets + num_states() / 2u) << Offsets) | ...);
+
+        decisions[base / word_bits] |= group_1 << (base % word_bits);
+        decisions[(base + num_states() / 2u) / word_bits] |= group_2 << ((base + num_states() / 2u) % word_bits);
+    }
+
+    /*
+    Carry out an add-compare-select operation for a single state, returning
+    the decision.
+    */
+    static bool_vec_t add_compare_select(const metric_t *output_metrics, const metric_t *prev_path_metrics,
+            metric_t *next_path_metrics, state_vec_t state) {
+        /* Work out ancestor state indices. */
+        state_vec_t ancestor_1 = state << 1u;
+        state_vec_t ancestor_2 = ancestor_1 | 1u;
+
+        /* Calculate updated path metrics for ancestor branches. */
+        metric_t path_1 = prev_path_metrics[ancestor_1 & (num_states() - 1u)] +
+            output_metrics[branch_outputs[ancestor_1]];
+        metric_t path_2 = prev_path_metrics[ancestor_2 & (num_states() - 1u)] +
+            output_metrics[branch_outputs[ancestor_2]];
+
+        /* Choose and store smallest path metric. */
+        bool_vec_t decision = path_2 < path_1;
+        next_path_metrics[state] = decision ? path_2 : path_1;
+        return decision;
+    }
+
+public:
+    /* Calculate the number of output bytes for a given input length. */
+    static constexpr std::size_t calculate_output_length(std::size_t len) {
+        std::size_t out_bits = (len * 8u * PuncturingMatrix::size()) / (PuncturingMatrix::ones() * sizeof...(Polynomials)) +
+            (((len * 8u * PuncturingMatrix::size()) % (PuncturingMatrix::ones() * sizeof...(Polynomials))) ? 1u : 0u);
+
+        return out_bits / 8u + ((out_bits % 8u) ? 1u : 0u);
+    }
+
+    /*
+    Decode a block of convolutionally encoded data using the Viterbi
+    algorithm with hard-decisions. The 'out' buffer must have space for
+    calculate_output_length(len) bytes.
+    */
+    static void decode(const uint8_t *in, std::size_t len, uint8_t *out) {
+        /*
+        Initialise path metric corresponding to state 0 to 0, and all other
+        paths to a sufficiently large value.
+        */
+        metric_t path_metrics[num_states()];
+        path_metrics[0] = 0u;
+        std::fill_n(&path_metrics[1], num_states() - 1u, (metric_t)1u << (sizeof(metric_t) * 8u - 1u));
+
+        constexpr std::size_t in_bytes = (TracebackLength / 8u) * PuncturingMatrix::ones() /
+            (PuncturingMatrix::size() / sizeof...(Polynomials));
+        std::size_t out_idx = 0u;
+
+        for (std::size_t i = 0u; i < len; i += in_bytes) {
+            out_idx += decode_traceback(&in[i], len - i, &out[out_idx], path_metrics);
+        }
+    }
+
+    template <std::size_t Len>
+    static std::array<uint8_t, calculate_output_length(Len)> decode(const std::array<uint8_t, Len> &in) {
+        std::array<uint8_t, calculate_output_length(Len)> out = {};
+        decode(in.data(), Len, out.data());
+        return out;
+    }
+
+    /*
+    Calculate the number of output bytes for a given tail-biting input
+    length. Tail-biting frames carry no flush bits, so any bits left over in
+    the final input byte are padding.
+    */
+    static constexpr std::size_t calculate_tail_biting_output_length(std::size_t len) {
+        return ((len * 8u * PuncturingMatrix::size()) / (PuncturingMatrix::ones() * sizeof...(Polynomials))) / 8u;
+    }
+
+    /*
+    Decode a tail-biting frame using the wrap-around Viterbi algorithm
+    (WAVA). All states start with equal path metrics, and the trellis is
+    run around the frame up to 'Iterations' times, with each pass starting
+    from the final path metrics of the previous one. Decoding stops early
+    once the best surviving path starts and ends in the same state.
+    */
+    template <std::size_t Iterations = 4u, std::size_t Len>
+    static std::array<uint8_t, calculate_tail_biting_output_length(Len)> decode_tail_biting(
+            const std::array<uint8_t, Len> &in) {
+        static_assert(Iterations > 0u, "At least one iteration is required");
+
+        constexpr std::size_t frame_bits = calculate_tail_biting_output_length(Len) * 8u;
+        static_assert(frame_bits > 0u, "Tail-biting frame must contain at least one byte");
+        static_assert(frame_bits % (PuncturingMatrix::size() / sizeof...(Polynomials)) == 0u,
+            "Tail-biting frame length must be an integer number of puncturing matrix cycles");
+
+        std::array<uint8_t, calculate_tail_biting_output_length(Len)> out;
+
+        /* Pad the input to an integer number of interleaver blocks. */
+        constexpr std::size_t num_blocks = frame_bits / (block_size() * 8u) +
+            ((frame_bits % (block_size() * 8u)) ? 1u : 0u);
+        std::array<uint8_t, num_blocks * interleaver::out_buf_len()> in_buf = {};
+        std::copy_n(in.begin(), std::min(Len, in_buf.size()), in_buf.begin());
+
+        /* The starting state is unknown, so all paths start out equal. */
+        metric_t path_metrics[num_states()] = {};
+        alignas(16) bool_vec_t decisions[frame_bits * decision_size()];
+
+        for (std::size_t i = 0u; i < Iterations; i++) {
+            decode_bits<frame_bits>(in_buf.data(), path_metrics, decisions);
+
+            /*
+            Stop if any of the best surviving paths is tail-biting. At high
+            code rates the final bits are only weakly protected, so several
+            states can share the minimum path metric.
+            */
+            metric_t min_metric = *std::min_element(path_metrics, path_metrics + num_states());
+            for (state_vec_t j = 0u; j < num_states(); j++) {
+                if (path_metrics[j] == min_metric && traceback_t::traceback(decisions, frame_bits, j, out.data()) == j) {
+                    return out;
+                }
+            }
+
+            /* Normalise path metrics before wrapping around again. */
+            for (std::size_t j = 0u; j < num_states(); j++) {
+                path_metrics[j] -= min_metric;
+            }
+        }
+
+        /* No tail-biting path was found, so use the best path. */
+        traceback_t::traceback(decisions, frame_bits,
+            std::min_element(path_metrics, path_metrics + num_states()) - path_metrics, out.data());
+
+        return out;
+    }
+};
+
+/*
+Decoder implementing the Viterbi algorithm using soft-decisions. The input
+is the stream of 8-bit LLRs for the transmitted bits of a
+PuncturedConvolutionalEncoder with the same parameters, with positive values
+indicating a zero bit. The input is depunctured to the rate 1/n mother code,
+so the same add-compare-select kernel is used for every puncturing matrix,
+and optionally flagged symbols are erased.
+*/
+template <std::size_t ConstraintLength, std::size_t TracebackLength, typename PuncturingMatrix, typename... Polynomials>
+class PuncturedSoftDecisionViterbiDecoder {
+    static_assert(ConstraintLength > 1u, "Constraint length must be at least two");
+    static_assert(sizeof...(Polynomials) > 1u, "Minimum of two polynomials are required");
+    static_assert(sizeof...(Polynomials) <= 8u, "Maximum supported code rate is 1/8");
+    static_assert(Detail::all_true<(Polynomials::size() == ConstraintLength)...>::value,
+        "Length of polynomials must be equal to constraint length");
+    static_assert(PuncturingMatrix::size() % sizeof...(Polynomials) == 0u,
+        "Puncturing matrix size must be an integer multiple of the code rate");
+    static_assert(PuncturingMatrix::size() > 0u, "Puncturing matrix size must be larger than zero");
+    static_assert(TracebackLength % (PuncturingMatrix::size() / sizeof...(Polynomials)) == 0u,
+        "Traceback length must be an integer multiple of puncturing matrix row length");
+    static_assert(TracebackLength % 8u == 0u, "Traceback length must be a multiple of eight");
+    static_assert(TracebackLength * sizeof...(Polynomials) * 128u < ((std::size_t)1u << 29u),
+        "Traceback length is too long for the path metric range");
+
+    using metric_t = int32_t;
+    using state_vec_t = bool_vec_t;
+    using traceback_t = ViterbiTraceback<ConstraintLength>;
+    using depuncturer = Depuncturer<PuncturingMatrix, sizeof...(Polynomials)>;
+
+    static constexpr std::size_t num_states() { return (state_vec_t)1u << (ConstraintLength - 1u); }
+    static constexpr std::size_t decision_size() { return traceback_t::decision_size(); }
+
+    /*
+    Calculate the encoder outputs for each possible shift register value,
+    with the output of polynomial i in bit i.
+    */
+    static constexpr std::array<uint8_t, 2u * num_states()> get_branch_outputs() {
+        constexpr std::size_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        std::array<uint8_t, 2u * num_states()> outputs = {};
+
+        for (std::size_t r = 0u; r < outputs.size(); r++) {
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                outputs[r] |= (Detail::calculate_hamming_weight(r & poly_vec[p]) % 2u) << p;
+            }
+        }
+
+        return outputs;
+    }
+
+    static constexpr std::array<uint8_t, 2u * num_states()> branch_outputs = get_branch_outputs();
+
+    /*
+    Carry out add-compare-select for one step of the rate 1/n trellis. Path
+    metrics are correlations with the received LLRs, so larger is better.
+    */
+    static void calculate_trellis_step(const int8_t *llr, const metric_t *cur_path_metrics,
+            metric_t *next_path_metrics, bool_vec_t *decisions) {
+        /* Calculate the metric for each possible combination of outputs. */
+        metric_t output_metrics[(std::size_t)1u << sizeof...(Polynomials)];
+        for (std::size_t c = 0u; c < ((std::size_t)1u << sizeof...(Polynomials)); c++) {
+            metric_t metric = 0;
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                metric += (c & ((std::size_t)1u << p)) ? -(metric_t)llr[p] : (metric_t)llr[p];
+            }
+
+            output_metrics[c] = metric;
+        }
+
+        bool_vec_t row[decision_size()] = {};
+        for (state_vec_t s = 0u; s < num_states(); s++) {
+            state_vec_t ancestor_1 = s << 1u;
+            state_vec_t ancestor_2 = ancestor_1 | 1u;
+
+            metric_t path_1 = cur_path_metrics[ancestor_1 & (num_states() - 1u)] +
+                output_metrics[branch_outputs[ancestor_1]];
+            metric_t path_2 = cur_path_metrics[ancestor_2 & (num_states() - 1u)] +
+                output_metrics[branch_outputs[ancestor_2]];
+
+            bool_vec_t decision = path_2 > path_1;
+            next_path_metrics[s] = decision ? path_2 : path_1;
+            row[s / (sizeof(bool_vec_t) * 8u)] |= decision << (s % (sizeof(bool_vec_t) * 8u));
+        }
+
+        std::copy_n(row, decision_size(), decisions);
+    }
+
+    /*
+    Run the trellis over a number of steps equal to the traceback length,
+    and normalise the path metrics relative to the best one. Returns the
+    best state at the end.
+    */
+    static state_vec_t decode_steps(const int8_t *in, const uint8_t *erasures, std::size_t len,
+            metric_t *path_metrics, bool_vec_t *decisions) {
+        int8_t llr[TracebackLength * sizeof...(Polynomials)];
+        depuncturer::depuncture(in, erasures, len, llr, TracebackLength);
+
+        /* The traceback length is even, so the final path metrics end up back in 'path_metrics'. */
+        metric_t temp_path_metrics[num_states()];
+        for (std::size_t i = 0u; i < TracebackLength; i++) {
+            calculate_trellis_step(&llr[i * sizeof...(Polynomials)],
+                i % 2u ? temp_path_metrics : path_metrics,
+                i % 2u ? path_metrics : temp_path_metrics,
+                &decisions[i * decision_size()]);
+        }
+
+        state_vec_t max_path = std::max_element(path_metrics, path_metrics + num_states()) - path_metrics;
+        metric_t max_metric = path_metrics[max_path];
+        for (std::size_t i = 0u; i < num_states(); i++) {
+            path_metrics[i] = std::max(path_metrics[i] - max_metric, std::numeric_limits<metric_t>::min() / 2);
+        }
+
+        return max_path;
+    }
+
+public:
+    /* Calculate the number of output bytes for a given number of input LLRs. */
+    static constexpr std::size_t calculate_output_length(std::size_t len) {
+        std::size_t out_bits = (len * PuncturingMatrix::size()) / (PuncturingMatrix::ones() * sizeof...(Polynomials)) +
+            (((len * PuncturingMatrix::size()) % (PuncturingMatrix::ones() * sizeof...(Polynomials))) ? 1u : 0u);
+
+        return out_bits / 8u + ((out_bits % 8u) ? 1u : 0u);
+    }
+
+    /*
+    Decode 'len' LLRs into 'out', which must have space for
+    calculate_output_length(len) bytes. If 'erasures' is not null, it holds
+    one flag per LLR, and LLRs with a non-zero flag are ignored.
+    */
+    static void decode(const int8_t *in, const uint8_t *erasures, std::size_t len, uint8_t *out) {
+        /* The encoder starts in state 0. */
+        metric_t path_metrics[num_states()];
+        path_metrics[0] = 0;
+        std::fill_n(&path_metrics[1], num_states() - 1u, std::numeric_limits<metric_t>::min() / 2);
+
+        constexpr std::size_t in_llrs = TracebackLength * PuncturingMatrix::ones() /
+            (PuncturingMatrix::size() / sizeof...(Polynomials));
+        constexpr std::size_t out_bytes = TracebackLength / 8u;
+
+        /*
+        Decisions for the two most recent blocks of steps are kept. Each
+        block is decoded once the following block has been run, by tracing
+        back through the following block first, so that every decoded bit
+        has a decision depth of at least the traceback length.
+        */
+        alignas(16) bool_vec_t decisions[2u][TracebackLength * decision_size()];
+        uint8_t discard[out_bytes];
+        state_vec_t max_path = 0u;
+        std::size_t block = 0u;
+
+        for (std::size_t i = 0u; i < len; i += in_llrs, block++) {
+            max_path = decode_steps(&in[i], erasures ? &erasures[i] : nullptr, len - i, path_metrics,
+                decisions[block % 2u]);
+
+            if (block > 0u) {
+                state_vec_t state = traceback_t::traceback(decisions[block % 2u], TracebackLength, max_path, discard);
+                traceback_t::traceback(decisions[(block - 1u) % 2u], TracebackLength, state,
+                    &out[(block - 1u) * out_bytes]);
+            }
+        }
+
+        /* The final block is traced back from the best state at the end. */
+        if (block > 0u) {
+            std::size_t bits = std::min(calculate_output_length(len) - (block - 1u) * out_bytes, out_bytes) * 8u;
+            traceback_t::traceback(decisions[(block - 1u) % 2u], bits, max_path, &out[(block - 1u) * out_bytes]);
+        }
+    }
+
+    static void decode(const int8_t *in, std::size_t len, uint8_t *out) {
+        decode(in, nullptr, len, out);
+    }
+
+    template <std::size_t Len>
+    static std::array<uint8_t, calculate_output_length(Len)> decode(const std::array<int8_t, Len> &in) {
+        std::array<uint8_t, calculate_output_length(Len)> out = {};
+        decode(in.data(), nullptr, Len, out.data());
+        return out;
+    }
+
+    template <std::size_t Len>
+    static std::array<uint8_t, calculate_output_length(Len)> decode(const std::array<int8_t, Len> &in,
+            const std::array<uint8_t, Len> &erasures) {
+        std::array<uint8_t, calculate_output_length(Len)> out = {};
+        decode(in.data(), erasures.data(), Len, out.data());
+        return out;
+    }
+};
+
+/*
+Decoder implementing the parallel list Viterbi algorithm for terminated
+frames. Each state keeps the 'ListSize' best paths into it rather than just
+one, and the candidates ending in state zero are tested in order of path
+metric against a caller-supplied check, usually a CRC over the message.
+The input is the stream of 8-bit LLRs for the transmitted bits of a
+PuncturedConvolutionalEncoder with the same parameters, with positive values
+indicating a zero bit.
+
+The survivor memory holds one byte per path per state per trellis step, so
+this decoder is intended for short frames.
+*/
+template <std::size_t ConstraintLength, std::size_t ListSize, typename PuncturingMatrix, typename... Polynomials>
+class PuncturedListViterbiDecoder {
+    static_assert(ConstraintLength > 1u, "Constraint length must be at least two");
+    static_assert(sizeof...(Polynomials) > 1u, "Minimum of two polynomials are required");
+    static_assert(sizeof...(Polynomials) <= 8u, "Maximum supported code rate is 1/8");
+    static_assert(Detail::all_true<(Polynomials::size() == ConstraintLength)...>::value,
+        "Length of polynomials must be equal to constraint length");
+    static_assert(PuncturingMatrix::size() % sizeof...(Polynomials) == 0u,
+        "Puncturing matrix size must be an integer multiple of the code rate");
+    static_assert(PuncturingMatrix::size() > 0u, "Puncturing matrix size must be larger than zero");
+    static_assert(ListSize > 0u, "List size must be at least one");
+    static_assert(ListSize <= 128u, "Maximum supported list size is 128");
+
+    using metric_t = int32_t;
+    using state_vec_t = bool_vec_t;
+    using encoder = PuncturedConvolutionalEncoder<ConstraintLength, PuncturingMatrix, Polynomials...>;
+    using depuncturer = Depuncturer<PuncturingMatrix, sizeof...(Polynomials)>;
+
+    static constexpr std::size_t num_states() { return (state_vec_t)1u << (ConstraintLength - 1u); }
+
+    /* Metric of an empty list entry. */
+    static constexpr metric_t unreachable() { return std::numeric_limits<metric_t>::min() / 2; }
+
+    /*
+    Calculate the encoder outputs for each possible shift register value,
+    with the output of polynomial i in bit i.
+    */
+    static constexpr std::array<uint8_t, 2u * num_states()> get_branch_outputs() {
+        constexpr std::size_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        std::array<uint8_t, 2u * num_states()> outputs = {};
+
+        for (std::size_t r = 0u; r < outputs.size(); r++) {
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                outputs[r] |= (Detail::calculate_hamming_weight(r & poly_vec[p]) % 2u) << p;
+            }
+        }
+
+        return outputs;
+    }
+
+    static constexpr std::array<uint8_t, 2u * num_states()> branch_outputs = get_branch_outputs();
+
+    /*
+    Carry out one step of the trellis. The sorted lists of the two ancestors
+    of each state are merged, and the best 'ListSize' entries kept. Each
+    survivor records which ancestor it came from in its top bit, and its
+    position in that ancestor's list in the remaining bits.
+    */
+    static void calculate_trellis_step(const int8_t *llr, const metric_t *cur_path_metrics,
+            metric_t *next_path_metrics, uint8_t *survivors) {
+        /* Calculate the metric for each possible combination of outputs. */
+        metric_t output_metrics[(std::size_t)1u << sizeof...(Polynomials)];
+        for (std::size_t c = 0u; c < ((std::size_t)1u << sizeof...(Polynomials)); c++) {
+            metric_t metric = 0;
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                metric += (c & ((std::size_t)1u << p)) ? -(metric_t)llr[p] : (metric_t)llr[p];
+            }
+
+            output_metrics[c] = metric;
+        }
+
+        for (state_vec_t s = 0u; s < num_states(); s++) {
+            state_vec_t ancestor_1 = s << 1u;
+            state_vec_t ancestor_2 = ancestor_1 | 1u;
+
+            const metric_t *list_1 = &cur_path_metrics[(ancestor_1 & (num_states() - 1u)) * ListSize];
+            const metric_t *list_2 = &cur_path_metrics[(ancestor_2 & (num_states() - 1u)) * ListSize];
+            metric_t branch_1 = output_metrics[branch_outputs[ancestor_1]];
+            metric_t branch_2 = output_metrics[branch_outputs[ancestor_2]];
+
+            std::size_t i = 0u, j = 0u;
+            for (std::size_t k = 0u; k < ListSize; k++) {
+                metric_t path_1 = list_1[i] + branch_1;
+                metric_t path_2 = list_2[j] + branch_2;
+
+                if (path_2 > path_1) {
+                    next_path_metrics[s * ListSize + k] = path_2;
+                    survivors[s * ListSize + k] = 0x80u | (uint8_t)j++;
+                } else {
+                    next_path_metrics[s * ListSize + k] = path_1;
+                    survivors[s * ListSize + k] = (uint8_t)i++;
+                }
+            }
+        }
+    }
+
+    /* Trace back the path in position 'rank' of the list for state zero. */
+    template <std::size_t MessageLen>
+    static void traceback(const uint8_t *survivors, std::size_t steps, std::size_t rank,
+            std::array<uint8_t, MessageLen> &out) {
+        out.fill(0u);
+        state_vec_t state = 0u;
+
+        for (std::size_t t = steps; t-- > 0u;) {
+            uint8_t survivor = survivors[(t * num_states() + state) * ListSize + rank];
+
+            if (t < MessageLen * 8u && (state >> (ConstraintLength - 2u))) {
+                out[t / 8u] |= 0x80u >> (t % 8u);
+            }
+
+            state = ((state << 1u) | (survivor >> 7u)) & (num_states() - 1u);
+            rank = survivor & 0x7fu;
+        }
+    }
+
+public:
+    /* Calculate the number of input LLRs for a frame of 'len' message bytes. */
+    static constexpr std::size_t calculate_input_length(std::size_t len) {
+        return encoder::calculate_output_length(len) * 8u;
+    }
+
+    /*
+    Decode a frame of 'MessageLen' bytes, returning the most likely
+    candidate for which 'check' returns true. If no candidate passes, the
+    maximum likelihood path is returned.
+    */
+    template <std::size_t MessageLen, typename Check>
+    static std::array<uint8_t, MessageLen> decode(const std::array<int8_t, calculate_input_length(MessageLen)> &in,
+            Check check) {
+        /* The flush bits return the encoder to state zero. */
+        constexpr std::size_t steps = MessageLen * 8u + ConstraintLength - 1u;
+
+        int8_t llr[steps * sizeof...(Polynomials)];
+        depuncturer::depuncture(in.data(), nullptr, in.size(), llr, steps);
+
+        /* The encoder starts in state 0. */
+        metric_t path_metrics[2u][num_states() * ListSize];
+        std::fill_n(path_metrics[0], num_states() * ListSize, unreachable());
+        path_metrics[0][0] = 0;
+
+        uint8_t survivors[steps * num_states() * ListSize];
+        for (std::size_t t = 0u; t < steps; t++) {
+            calculate_trellis_step(&llr[t * sizeof...(Polynomials)], path_metrics[t % 2u], path_metrics[(t + 1u) % 2u],
+                &survivors[t * num_states() * ListSize]);
+        }
+
+        /* Test the candidates ending in state zero in order. */
+        std::array<uint8_t, MessageLen> out;
+        const metric_t *final_metrics = path_metrics[steps % 2u];
+        for (std::size_t k = 0u; k < ListSize && final_metrics[k] > unreachable() / 2; k++) {
+            traceback(survivors, steps, k, out);
+            if (check(out)) {
+                return out;
+            }
+        }
+
+        traceback(survivors, steps, 0u, out);
+        return out;
+    }
+};
+
+/*
+This namespace contains the building blocks of the BCJR soft-in soft-out
+decoder. All metrics are kept in the log domain, and the 'Algorithm' type
+selects how two path metrics are combined.
+*/
+namespace BCJR {
+
+/* Max-Log-MAP approximation, max*(x, y) = max(x, y). */
+struct MaxLogMAP {
+    static float max_star(float x, float y) {
+        return std::max(x, y);
+    }
+};
+
+/* Exact Log-MAP, max*(x, y) = max(x, y) + ln(1 + e^-|x - y|). */
+struct LogMAP {
+    static float max_star(float x, float y) {
+        return std::max(x, y) + std::log1p(std::exp(-std::abs(x - y)));
+    }
+};
+
+namespace Operations {
+
+/*
+Branch metrics are indexed by the contents of the encoder shift register,
+(a << (K - 1)) | s, where 'a' is the bit shifted in and 's' is the state the
+branch leaves. That branch ends in state (a * Ns / 2 + s / 2).
+*/
+
+/* Do one step of the forward recursion. */
+template <typename Algorithm, std::size_t Ns>
+struct forward_op_container {
+    static void op(const float *alpha, const float *gamma, float *alpha_next) {
+        for (std::size_t a = 0u; a < 2u; a++) {
+            for (std::size_t j = 0u; j < Ns / 2u; j++) {
+                alpha_next[a * (Ns / 2u) + j] = Algorithm::max_star(alpha[2u * j] + gamma[a * Ns + 2u * j],
+                    alpha[2u * j + 1u] + gamma[a * Ns + 2u * j + 1u]);
+            }
+        }
+    }
+};
+
+/* Do one step of the backward recursion. */
+template <typename Algorithm, std::size_t Ns>
+struct backward_op_container {
+    static void op(const float *beta, const float *gamma, float *beta_prev) {
+        for (std::size_t s = 0u; s < Ns; s++) {
+            beta_prev[s] = Algorithm::max_star(beta[s / 2u] + gamma[s], beta[Ns / 2u + s / 2u] + gamma[Ns + s]);
+        }
+    }
+};
+
+/* Calculate the a posteriori LLR of the bit shifted in at one step. */
+template <typename Algorithm, std::size_t Ns>
+struct llr_op_container {
+    static float op(const float *alpha, const float *gamma, const float *beta) {
+        float metric_0 = alpha[0u] + gamma[0u] + beta[0u];
+        float metric_1 = alpha[0u] + gamma[Ns] + beta[Ns / 2u];
+        for (std::size_t s = 1u; s < Ns; s++) {
+            metric_0 = Algorithm::max_star(metric_0, alpha[s] + gamma[s] + beta[s / 2u]);
+            metric_1 = Algorithm::max_star(metric_1, alpha[s] + gamma[Ns + s] + beta[Ns / 2u + s / 2u]);
+        }
+
+        return metric_0 - metric_1;
+    }
+};
+
+/* Include SIMD specialisations if defined. */
+#if defined(USE_SIMD_X86)
+  #include "ConvolutionalSIMD_x86.h"
+#endif
+
+/* Wrapper functions to allow template argument deduction. */
+
+template <typename Algorithm, std::size_t Ns>
+void forward(const float *alpha, const float *gamma, float *alpha_next) {
+    forward_op_container<Algorithm, Ns>::op(alpha, gamma, alpha_next);
+}
+
+template <typename Algorithm, std::size_t Ns>
+void backward(const float *beta, const float *gamma, float *beta_prev) {
+    backward_op_container<Algorithm, Ns>::op(beta, gamma, beta_prev);
+}
+
+template <typename Algorithm, std::size_t Ns>
+float llr(const float *alpha, const float *gamma, const float *beta) {
+    return llr_op_container<Algorithm, Ns>::op(alpha, gamma, beta);
+}
+
+}
+
+}
+
+/*
+Soft-in soft-out decoder implementing the BCJR (maximum a posteriori)
+algorithm, with the 'Algorithm' parameter selecting either BCJR::LogMAP or
+BCJR::MaxLogMAP. The input is the stream of LLRs for the transmitted bits
+of a PuncturedConvolutionalEncoder with the same parameters, including the
+flush bits, and the output is the a posteriori LLR of each message bit.
+LLRs are defined as ln(P(0) / P(1)), so positive values indicate a zero bit.
+
+The recursions are run over sliding windows of 'WindowLength' trellis steps,
+so memory use is bounded by the window length rather than the message
+length. The backward recursion for each window is initialised by a training
+recursion over the following window.
+*/
+template <std::size_t ConstraintLength, std::size_t WindowLength, typename Algorithm,
+    typename PuncturingMatrix, typename... Polynomials>
+class PuncturedBCJRDecoder {
+    static_assert(ConstraintLength > 1u, "Constraint length must be at least two");
+    static_assert(sizeof...(Polynomials) > 1u, "Minimum of two polynomials are required");
+    static_assert(sizeof...(Polynomials) <= 8u, "Maximum supported code rate is 1/8");
+    static_assert(Detail::all_true<(Polynomials::size() == ConstraintLength)...>::value,
+        "Length of polynomials must be equal to constraint length");
+    static_assert(PuncturingMatrix::size() % sizeof...(Polynomials) == 0u,
+        "Puncturing matrix size must be an integer multiple of the code rate");
+    static_assert(PuncturingMatrix::size() > 0u, "Puncturing matrix size must be larger than zero");
+    static_assert(WindowLength > 0u, "Window length must be at least one");
+
+    static constexpr std::size_t num_states() { return (std::size_t)1u << (ConstraintLength - 1u); }
+
+    /* A priori LLR used for the flush bits, which are known to be zero. */
+    static constexpr float flush_llr() { return 1e9f; }
+
+    /*
+    Calculate the encoder outputs for each possible shift register value,
+    with the output of polynomial i in bit i.
+    */
+    static constexpr std::array<uint8_t, 2u * num_states()> get_branch_outputs() {
+        constexpr std::size_t poly_vec[sizeof...(Polynomials)] = { Polynomials::to_integer()... };
+        std::array<uint8_t, 2u * num_states()> outputs = {};
+
+        for (std::size_t r = 0u; r < outputs.size(); r++) {
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                outputs[r] |= (Detail::calculate_hamming_weight(r & poly_vec[p]) % 2u) << p;
+            }
+        }
+
+        return outputs;
+    }
+
+    static constexpr std::array<uint8_t, 2u * num_states()> branch_outputs = get_branch_outputs();
+    static constexpr std::array<std::ptrdiff_t, PuncturingMatrix::size()> puncture_offsets =
+        Operations::get_puncture_offsets<PuncturingMatrix>();
+
+    /*
+    Calculate the branch metrics for trellis step 't'. Punctured bits, and
+    bits beyond the end of the input, are treated as erasures.
+    */
+    static void calculate_branch_metrics(const float *in, std::size_t in_len, std::size_t t, float apriori,
+            float *gamma) {
+        constexpr std::size_t row_len = PuncturingMatrix::size() / sizeof...(Polynomials);
+
+        float in_llr[sizeof...(Polynomials)];
+        std::size_t base = (t / row_len) * PuncturingMatrix::ones();
+        for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+            std::ptrdiff_t offset = puncture_offsets[(t % row_len) * sizeof...(Polynomials) + p];
+            in_llr[p] = (offset >= 0 && base + offset < in_len) ? in[base + offset] : 0.0f;
+        }
+
+        /* Calculate the metric for each possible combination of outputs. */
+        float output_metrics[(std::size_t)1u << sizeof...(Polynomials)];
+        for (std::size_t c = 0u; c < ((std::size_t)1u << sizeof...(Polynomials)); c++) {
+            float metric = 0.0f;
+            for (std::size_t p = 0u; p < sizeof...(Polynomials); p++) {
+                metric += (c & ((std::size_t)1u << p)) ? -in_llr[p] : in_llr[p];
+            }
+
+            output_metrics[c] = 0.5f * metric;
+        }
+
+        for (std::size_t r = 0u; r < num_states(); r++) {
+            gamma[r] = output_metrics[branch_outputs[r]] + 0.5f * apriori;
+            gamma[num_states() + r] = output_metrics[branch_outputs[num_states() + r]] - 0.5f * apriori;
+        }
+    }
+
+    /* Subtract the metric of state zero, which is always reachable. */
+    static void normalise(const float *in, float *out) {
+        float ref = in[0u];
+        for (std::size_t s = 0u; s < num_states(); s++) {
+            out[s] = in[s] - ref;
+        }
+    }
+
+    /* Initialise metrics to the zero state at the start or end of the trellis. */
+    static void initialise_terminal(float *metrics) {
+        metrics[0u] = 0.0f;
+        std::fill_n(&metrics[1u], num_states() - 1u, -flush_llr());
+    }
+
+    /*
+    Run the decoder over 'info_bits' message bits followed by the flush
+    bits. The a priori LLRs are optional.
+    */
+    static void decode_window(const float *in, std::size_t in_len, const float *apriori, std::size_t info_bits,
+            float *out) {
+        const std::size_t num_steps = info_bits + ConstraintLength;
+        auto step_apriori = [&](std::size_t t) {
+            return t < info_bits ? (apriori ? apriori[t] : 0.0f) : flush_llr();
+        };
+
+        float alphas[WindowLength][num_states()];
+        float alpha[num_states()], beta[num_states()], temp[num_states()];
+        float gamma[2u * num_states()];
+
+        initialise_terminal(alpha);
+        for (std::size_t w0 = 0u; w0 < info_bits; w0 += WindowLength) {
+            std::size_t w1 = std::min(w0 + WindowLength, info_bits);
+
+            /* Run the forward recursion over the window. */
+            for (std::size_t t = w0; t < w1; t++) {
+                std::copy_n(alpha, num_states(), alphas[t - w0]);
+                calculate_branch_metrics(in, in_len, t, step_apriori(t), gamma);
+                BCJR::Operations::forward<Algorithm, num_states()>(alpha, gamma, temp);
+                normalise(temp, alpha);
+            }
+
+            /*
+            Initialise the backward recursion by training over the next
+            window, or from the end of the trellis if it is within reach.
+            */
+            std::size_t t_end = std::min(w1 + WindowLength, num_steps);
+            if (t_end == num_steps) {
+                initialise_terminal(beta);
+            } else {
+                std::fill_n(beta, num_states(), 0.0f);
+            }
+
+            for (std::size_t t = t_end; t-- > w1;) {
+                calculate_branch_metrics(in, in_len, t, step_apriori(t), gamma);
+                BCJR::Operations::backward<Algorithm, num_states()>(beta, gamma, temp);
+                normalise(temp, beta);
+            }
+
+            /* Run the backward recursion over the window and calculate LLRs. */
+            for (std::size_t t = w1; t-- > w0;) {
+                calculate_branch_metrics(in, in_len, t, step_apriori(t), gamma);
+                out[t] = BCJR::Operations::llr<Algorithm, num_states()>(alphas[t - w0], gamma, beta);
+                BCJR::Operations::backward<Algorithm, num_states()>(beta, gamma, temp);
+                normalise(temp, beta);
+            }
+        }
+    }
+
+public:
+    /*
+    Calculate the number of input LLRs for a given message length in bytes.
+    This is one LLR per bit of the encoder output.
+    */
+    static constexpr std::size_t calculate_input_length(std::size_t len) {
+        std::size_t out_len = (len * 8u + ConstraintLength) * sizeof...(Polynomials) * PuncturingMatrix::ones();
+
+        if (out_len % PuncturingMatrix::size()) {
+            out_len = out_len / PuncturingMatrix::size() + 1u;
+        } else {
+            out_len /= PuncturingMatrix::size();
+        }
+
+        return (out_len % 8u ? (out_len / 8u) + 1u : out_len / 8u) * 8u;
+    }
+
+    /* Calculate the a posteriori LLRs of a message of 'Len' bytes. */
+    template <std::size_t Len>
+    static std::array<float, Len * 8u> decode(const std::array<float, calculate_input_length(Len)> &in) {
+        std::array<float, Len * 8u> out;
+        decode_window(in.data(), in.size(), nullptr, Len * 8u, out.data());
+        return out;
+    }
+
+    /*
+    Calculate the a posteriori LLRs of a message of 'Len' bytes, given a
+    priori LLRs for each message bit.
+    */
+    template <std::size_t Len>
+    static std::array<float, Len * 8u> decode(const std::array<float, calculate_input_length(Len)> &in,
+            const std::array<float, Len * 8u> &apriori) {
+        std::array<float, Len * 8u> out;
+        decode_window(in.data(), in.size(), apriori.data(), Len * 8u, out.data());
         return out;
     }
 };
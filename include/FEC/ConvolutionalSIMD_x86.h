@@ -0,0 +1,128 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <x86intrin.h>
+
+/* Horizontal maximum of the four lanes of a vector. */
+static inline float horizontal_max(__m128 vec) {
+    vec = _mm_max_ps(vec, _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(2, 3, 0, 1)));
+    vec = _mm_max_ps(vec, _mm_shuffle_ps(vec, vec, _MM_SHUFFLE(1, 0, 3, 2)));
+    return _mm_cvtss_f32(vec);
+}
+
+/*
+Max-Log-MAP forward recursion. Each group of four output states is the
+maximum of the even and odd predecessor metrics, which are separated with a
+pair of shuffles.
+*/
+template <std::size_t Ns>
+struct forward_op_container<MaxLogMAP, Ns> {
+    static void op(const float *alpha, const float *gamma, float *alpha_next) {
+        if constexpr (Ns >= 8u) {
+            for (std::size_t a = 0u; a < 2u; a++) {
+                for (std::size_t j = 0u; j < Ns / 2u; j += 4u) {
+                    __m128 lo = _mm_add_ps(_mm_loadu_ps(&alpha[2u * j]), _mm_loadu_ps(&gamma[a * Ns + 2u * j]));
+                    __m128 hi = _mm_add_ps(_mm_loadu_ps(&alpha[2u * j + 4u]),
+                        _mm_loadu_ps(&gamma[a * Ns + 2u * j + 4u]));
+                    __m128 even = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(2, 0, 2, 0));
+                    __m128 odd = _mm_shuffle_ps(lo, hi, _MM_SHUFFLE(3, 1, 3, 1));
+                    _mm_storeu_ps(&alpha_next[a * (Ns / 2u) + j], _mm_max_ps(even, odd));
+                }
+            }
+        } else {
+            for (std::size_t a = 0u; a < 2u; a++) {
+                for (std::size_t j = 0u; j < Ns / 2u; j++) {
+                    alpha_next[a * (Ns / 2u) + j] = std::max(alpha[2u * j] + gamma[a * Ns + 2u * j],
+                        alpha[2u * j + 1u] + gamma[a * Ns + 2u * j + 1u]);
+                }
+            }
+        }
+    }
+};
+
+/*
+Max-Log-MAP backward recursion. Each successor metric is used by two
+adjacent states, so successor metrics are duplicated with unpack operations.
+*/
+template <std::size_t Ns>
+struct backward_op_container<MaxLogMAP, Ns> {
+    static void op(const float *beta, const float *gamma, float *beta_prev) {
+        if constexpr (Ns >= 8u) {
+            for (std::size_t s = 0u; s < Ns; s += 8u) {
+                __m128 b0 = _mm_loadu_ps(&beta[s / 2u]);
+                __m128 b1 = _mm_loadu_ps(&beta[Ns / 2u + s / 2u]);
+
+                _mm_storeu_ps(&beta_prev[s], _mm_max_ps(
+                    _mm_add_ps(_mm_unpacklo_ps(b0, b0), _mm_loadu_ps(&gamma[s])),
+                    _mm_add_ps(_mm_unpacklo_ps(b1, b1), _mm_loadu_ps(&gamma[Ns + s]))));
+                _mm_storeu_ps(&beta_prev[s + 4u], _mm_max_ps(
+                    _mm_add_ps(_mm_unpackhi_ps(b0, b0), _mm_loadu_ps(&gamma[s + 4u])),
+                    _mm_add_ps(_mm_unpackhi_ps(b1, b1), _mm_loadu_ps(&gamma[Ns + s + 4u]))));
+            }
+        } else {
+            for (std::size_t s = 0u; s < Ns; s++) {
+                beta_prev[s] = std::max(beta[s / 2u] + gamma[s], beta[Ns / 2u + s / 2u] + gamma[Ns + s]);
+            }
+        }
+    }
+};
+
+/* Max-Log-MAP output LLR, accumulating the maxima four states at a time. */
+template <std::size_t Ns>
+struct llr_op_container<MaxLogMAP, Ns> {
+    static float op(const float *alpha, const float *gamma, const float *beta) {
+        if constexpr (Ns >= 8u) {
+            __m128 metric_0 = _mm_set1_ps(-std::numeric_limits<float>::infinity());
+            __m128 metric_1 = metric_0;
+
+            for (std::size_t s = 0u; s < Ns; s += 8u) {
+                __m128 a0 = _mm_loadu_ps(&alpha[s]);
+                __m128 a1 = _mm_loadu_ps(&alpha[s + 4u]);
+                __m128 b0 = _mm_loadu_ps(&beta[s / 2u]);
+                __m128 b1 = _mm_loadu_ps(&beta[Ns / 2u + s / 2u]);
+
+                metric_0 = _mm_max_ps(metric_0, _mm_add_ps(_mm_add_ps(a0, _mm_loadu_ps(&gamma[s])),
+                    _mm_unpacklo_ps(b0, b0)));
+                metric_0 = _mm_max_ps(metric_0, _mm_add_ps(_mm_add_ps(a1, _mm_loadu_ps(&gamma[s + 4u])),
+                    _mm_unpackhi_ps(b0, b0)));
+                metric_1 = _mm_max_ps(metric_1, _mm_add_ps(_mm_add_ps(a0, _mm_loadu_ps(&gamma[Ns + s])),
+                    _mm_unpacklo_ps(b1, b1)));
+                metric_1 = _mm_max_ps(metric_1, _mm_add_ps(_mm_add_ps(a1, _mm_loadu_ps(&gamma[Ns + s + 4u])),
+                    _mm_unpackhi_ps(b1, b1)));
+            }
+
+            return horizontal_max(metric_0) - horizontal_max(metric_1);
+        } else {
+            float metric_0 = alpha[0u] + gamma[0u] + beta[0u];
+            float metric_1 = alpha[0u] + gamma[Ns] + beta[Ns / 2u];
+            for (std::size_t s = 1u; s < Ns; s++) {
+                metric_0 = std::max(metric_0, alpha[s] + gamma[s] + beta[s / 2u]);
+                metric_1 = std::max(metric_1, alpha[s] + gamma[Ns + s] + beta[Ns / 2u + s / 2u]);
+            }
+
+            return metric_0 - metric_1;
+        }
+    }
+};
@@ -0,0 +1,76 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <x86intrin.h>
+
+/*
+Depuncture 8-bit LLRs with PSHUFB. Each shuffle expands as many whole
+puncturing matrix cycles as fit in 16 bytes, with punctured positions taking
+a zero byte. Erased LLRs are cleared before the shuffle.
+*/
+template <typename PuncturingMatrix>
+struct depuncture_op_container<PuncturingMatrix, int8_t> {
+    static constexpr std::size_t cycles_per_vector() { return 16u / PuncturingMatrix::size(); }
+
+    static constexpr std::array<int8_t, 16u> get_shuffle_mask() {
+        constexpr std::array<std::ptrdiff_t, PuncturingMatrix::size()> offsets = get_puncture_offsets<PuncturingMatrix>();
+        std::array<int8_t, 16u> mask = {};
+
+        for (std::size_t i = 0u; i < 16u; i++) {
+            std::size_t c = i / PuncturingMatrix::size();
+            std::ptrdiff_t offset = offsets[i % PuncturingMatrix::size()];
+            mask[i] = (c < cycles_per_vector() && offset >= 0) ?
+                (int8_t)(c * PuncturingMatrix::ones() + offset) : (int8_t)0x80;
+        }
+
+        return mask;
+    }
+
+    static void op(const int8_t *in, const uint8_t *erasures, std::size_t cycles, int8_t *out) {
+        std::size_t c = 0u;
+
+        if constexpr (cycles_per_vector() > 0u) {
+            constexpr std::array<int8_t, 16u> shuffle_mask = get_shuffle_mask();
+            const __m128i mask = _mm_loadu_si128((const __m128i *)shuffle_mask.data());
+
+            /* Both the 16-byte load and store must stay within the buffers. */
+            for (; c * PuncturingMatrix::ones() + 16u <= cycles * PuncturingMatrix::ones() &&
+                    c * PuncturingMatrix::size() + 16u <= cycles * PuncturingMatrix::size();
+                    c += cycles_per_vector()) {
+                __m128i llr = _mm_loadu_si128((const __m128i *)&in[c * PuncturingMatrix::ones()]);
+                if (erasures) {
+                    __m128i flags = _mm_loadu_si128((const __m128i *)&erasures[c * PuncturingMatrix::ones()]);
+                    llr = _mm_and_si128(llr, _mm_cmpeq_epi8(flags, _mm_setzero_si128()));
+                }
+
+                _mm_storeu_si128((__m128i *)&out[c * PuncturingMatrix::size()], _mm_shuffle_epi8(llr, mask));
+            }
+        }
+
+        depuncture_cycles<PuncturingMatrix>(&in[c * PuncturingMatrix::ones()],
+            erasures ? &erasures[c * PuncturingMatrix::ones()] : nullptr, cycles - c,
+            &out[c * PuncturingMatrix::size()]);
+    }
+};
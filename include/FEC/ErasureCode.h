@@ -0,0 +1,285 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "FEC/Types.h"
+#include "FEC/GaloisField.h"
+
+namespace Thiemar {
+
+namespace ErasureCode {
+
+/*
+Systematic erasure code over GF(2^M), which encodes DataShards equal-sized
+buffers into ParityShards parity buffers such that any DataShards of the
+DataShards + ParityShards shards are enough to recover the rest.
+
+Parity shard i is the sum over data shards j of C[i][j] * data[j], where
+C[i][j] = 1 / (x_i + y_j) is a Cauchy matrix with x_i = i and
+y_j = ParityShards + j. Every square submatrix of a Cauchy matrix is
+invertible, so the generator matrix formed by stacking the identity on top
+of C is MDS. All of the work on shard contents is done with the GF region
+operations, which use SIMD when available.
+
+Recovery inverts the rows of the generator matrix for the shards that are
+present. The inverse depends only on which shards are present, so the
+coder keeps the inverses for the last CacheSize erasure patterns, and a
+burst of losses with the same pattern is only inverted once. Because of
+the cache, reconstruct() is not a static function, and an instance must
+not be shared between threads without external locking.
+*/
+template <std::size_t M, typename Primitive, std::size_t DataShards, std::size_t ParityShards,
+    std::size_t CacheSize = 8u>
+class CauchyErasureCoder {
+    static_assert(M <= 8u, "Erasure coding is only supported for fields of up to 2^8 elements");
+    static_assert(DataShards > 0u, "Number of data shards must be larger than zero");
+    static_assert(DataShards + ParityShards <= (1u << M), "Total number of shards must not exceed the field size");
+    static_assert(CacheSize > 0u, "Cache size must be larger than zero");
+
+    using gf = GaloisField<M, Primitive>;
+    using gf_t = typename gf::gf_t;
+
+    static constexpr std::size_t num_shards() { return DataShards + ParityShards; }
+
+    /* Number of elements processed at a time, so that a parity block stays in the L1 cache. */
+    static constexpr std::size_t block_size() { return 4096u; }
+
+    using matrix_t = std::array<std::array<gf_t, DataShards>, DataShards>;
+
+    static constexpr std::array<std::array<gf_t, DataShards>, ParityShards> get_cauchy_matrix() {
+        std::array<std::array<gf_t, DataShards>, ParityShards> matrix = {};
+        for (std::size_t i = 0u; i < ParityShards; i++) {
+            for (std::size_t j = 0u; j < DataShards; j++) {
+                matrix[i][j] = gf::divide(1u, i ^ (ParityShards + j));
+            }
+        }
+
+        return matrix;
+    }
+
+    static constexpr std::array<std::array<gf_t, DataShards>, ParityShards> cauchy_matrix = get_cauchy_matrix();
+
+    /* Row 'shard' of the generator matrix. */
+    static std::array<gf_t, DataShards> generator_row(std::size_t shard) {
+        if (shard < DataShards) {
+            std::array<gf_t, DataShards> row = {};
+            row[shard] = 1u;
+            return row;
+        }
+
+        return cauchy_matrix[shard - DataShards];
+    }
+
+    /* Invert a matrix by Gauss-Jordan elimination. Returns false if it is singular. */
+    static bool invert(matrix_t &a, matrix_t &inverse) {
+        inverse = {};
+        for (std::size_t i = 0u; i < DataShards; i++) {
+            inverse[i][i] = 1u;
+        }
+
+        for (std::size_t c = 0u; c < DataShards; c++) {
+            std::size_t pivot = c;
+            while (pivot < DataShards && !a[pivot][c]) {
+                pivot++;
+            }
+
+            if (pivot == DataShards) {
+                return false;
+            }
+
+            std::swap(a[c], a[pivot]);
+            std::swap(inverse[c], inverse[pivot]);
+
+            gf_t scale = gf::divide(1u, a[c][c]);
+            for (std::size_t j = 0u; j < DataShards; j++) {
+                a[c][j] = gf::multiply(a[c][j], scale);
+                inverse[c][j] = gf::multiply(inverse[c][j], scale);
+            }
+
+            for (std::size_t r = 0u; r < DataShards; r++) {
+                gf_t factor = a[r][c];
+                if (r != c && factor) {
+                    for (std::size_t j = 0u; j < DataShards; j++) {
+                        a[r][j] ^= gf::multiply(factor, a[c][j]);
+                        inverse[r][j] ^= gf::multiply(factor, inverse[c][j]);
+                    }
+                }
+            }
+        }
+
+        return true;
+    }
+
+    /*
+    Set out[k] = sum over i of coefficients[k][i] * in[i], for 'count'
+    outputs and DataShards inputs of 'len' elements. Working through the
+    buffers a block at a time means each input block is read from memory
+    once for all of the outputs.
+    */
+    static void combine(const std::array<gf_t, DataShards> *const *coefficients, gf_t *const *out,
+            std::size_t count, const gf_t *const *in, std::size_t len) {
+        for (std::size_t offset = 0u; offset < len; offset += block_size()) {
+            std::size_t n = std::min(block_size(), len - offset);
+            for (std::size_t k = 0u; k < count; k++) {
+                gf::mul_region(&out[k][offset], &in[0u][offset], (*coefficients[k])[0u], n);
+                for (std::size_t i = 1u; i < DataShards; i++) {
+                    gf::mul_add_region(&out[k][offset], &in[i][offset], (*coefficients[k])[i], n);
+                }
+            }
+        }
+    }
+
+    /* Recalculate the parity shards for which 'missing' is true. */
+    static void encode_parity(const gf_t *const *data, gf_t *const *parity, const bool *missing,
+            std::size_t len) {
+        std::array<const std::array<gf_t, DataShards> *, ParityShards> coefficients;
+        std::array<gf_t *, ParityShards> out;
+        std::size_t count = 0u;
+        for (std::size_t i = 0u; i < ParityShards; i++) {
+            if (missing[i]) {
+                coefficients[count] = &cauchy_matrix[i];
+                out[count++] = parity[i];
+            }
+        }
+
+        combine(coefficients.data(), out.data(), count, data, len);
+    }
+
+    struct CacheEntry {
+        /* Shards whose generator rows were inverted, in order. */
+        std::array<std::size_t, DataShards> rows = {};
+        matrix_t inverse = {};
+        bool valid = false;
+    };
+
+    std::array<CacheEntry, CacheSize> cache = {};
+    std::size_t next_entry = 0u;
+
+    /* Find or calculate the inverse for the given rows. */
+    const CacheEntry *get_inverse(const std::array<std::size_t, DataShards> &rows) {
+        for (const CacheEntry &entry : cache) {
+            if (entry.valid && entry.rows == rows) {
+                return &entry;
+            }
+        }
+
+        matrix_t a;
+        for (std::size_t r = 0u; r < DataShards; r++) {
+            a[r] = generator_row(rows[r]);
+        }
+
+        /* Replace entries in round-robin order. */
+        CacheEntry &entry = cache[next_entry];
+        next_entry = (next_entry + 1u) % CacheSize;
+
+        entry.rows = rows;
+        entry.valid = invert(a, entry.inverse);
+        return entry.valid ? &entry : nullptr;
+    }
+
+public:
+    static constexpr std::size_t data_shards() { return DataShards; }
+
+    static constexpr std::size_t parity_shards() { return ParityShards; }
+
+    /* Coefficient of data shard 'j' in parity shard 'i'. */
+    static constexpr gf_t coefficient(std::size_t i, std::size_t j) { return cauchy_matrix[i][j]; }
+
+    /*
+    Encode DataShards buffers from 'data' into ParityShards buffers in
+    'parity', each of 'len' elements.
+    */
+    static void encode(const gf_t *const *data, gf_t *const *parity, std::size_t len) {
+        std::array<bool, ParityShards> all;
+        all.fill(true);
+        encode_parity(data, parity, all.data(), len);
+    }
+
+    /*
+    Recover missing shards in place. 'shards' holds DataShards data
+    buffers followed by ParityShards parity buffers, each of 'len'
+    elements, and present[i] is false for each shard that has been lost.
+    Returns false without modifying any shard if fewer than DataShards
+    shards are present.
+    */
+    bool reconstruct(gf_t *const *shards, const bool *present, std::size_t len) {
+        std::array<std::size_t, DataShards> rows = {};
+        std::size_t num_present = 0u;
+        for (std::size_t i = 0u; i < num_shards() && num_present < DataShards; i++) {
+            if (present[i]) {
+                rows[num_present++] = i;
+            }
+        }
+
+        if (num_present < DataShards) {
+            return false;
+        }
+
+        /* The first DataShards present shards are all data shards if none of them were lost. */
+        if (rows[DataShards - 1u] >= DataShards) {
+            const CacheEntry *entry = get_inverse(rows);
+            if (!entry) {
+                return false;
+            }
+
+            std::array<const gf_t *, DataShards> in;
+            for (std::size_t r = 0u; r < DataShards; r++) {
+                in[r] = shards[rows[r]];
+            }
+
+            std::array<const std::array<gf_t, DataShards> *, DataShards> coefficients;
+            std::array<gf_t *, DataShards> out;
+            std::size_t count = 0u;
+            for (std::size_t d = 0u; d < DataShards; d++) {
+                if (!present[d]) {
+                    coefficients[count] = &entry->inverse[d];
+                    out[count++] = shards[d];
+                }
+            }
+
+            combine(coefficients.data(), out.data(), count, in.data(), len);
+        }
+
+        std::array<bool, ParityShards> missing;
+        for (std::size_t i = 0u; i < ParityShards; i++) {
+            missing[i] = !present[DataShards + i];
+        }
+
+        encode_parity(shards, &shards[DataShards], missing.data(), len);
+        return true;
+    }
+};
+
+template <std::size_t M, typename Primitive, std::size_t DataShards, std::size_t ParityShards, std::size_t CacheSize>
+constexpr std::array<std::array<typename GaloisField<M, Primitive>::gf_t, DataShards>, ParityShards>
+    CauchyErasureCoder<M, Primitive, DataShards, ParityShards, CacheSize>::cauchy_matrix;
+
+}
+
+}
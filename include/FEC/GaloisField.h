@@ -24,8 +24,13 @@ SOFTWARE.
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
+#if defined(USE_SIMD_X86)
+    #include <x86intrin.h>
+#endif
+
 #include "FEC/Types.h"
 #include "FEC/Utilities.h"
 #include "FEC/BinarySequence.h"
@@ -33,19 +38,116 @@ SOFTWARE.
 namespace Thiemar {
 
 namespace Detail {
+    /*
+    Exponent-order elements of the field, alpha^i for each i, generated with
+    one shift-and-reduce step per element so that even the 2^16 element
+    tables are cheap to evaluate at compile time. The table covers two full
+    periods, so the sum of two logarithms can index it without first being
+    reduced modulo 2^M - 1.
+    */
+    template <typename T, std::size_t M, std::size_t G>
+    constexpr std::array<T, 2u << M> get_antilog_table() {
+        std::array<T, 2u << M> table = {};
+        T e = 1u;
+        for (std::size_t i = 0u; i < table.size(); i++) {
+            table[i] = e;
+            e = (e & (1u << (M - 1u))) ? ((e << 1u) ^ G) : (e << 1u);
+        }
+
+        return table;
+    }
+
+    /* Exponent of each field element, with log(0) = 0. */
     template <typename T, std::size_t M, std::size_t G>
-    constexpr T get_field_element(std::size_t idx) {
+    constexpr std::array<T, 1u << M> get_log_table() {
+        std::array<T, 1u << M> table = {};
         T e = 1u;
-        for (std::size_t i = 0u; i < idx; i++) {
-            if (e & (1u << (M - 1u))) {
-                e = (e << 1u) ^ G;
-            } else {
-                e = e << 1u;
+        for (std::size_t i = 0u; i < table.size() - 1u; i++) {
+            table[e] = i;
+            e = (e & (1u << (M - 1u))) ? ((e << 1u) ^ G) : (e << 1u);
+        }
+
+        return table;
+    }
+
+    /*
+    Split multiplication table for a constant. Entry [n][v] is the product of
+    the constant with the value v placed in the n-th 4-bit nibble of a field
+    element, so by linearity a product is the XOR of one lookup per nibble.
+    */
+    template <typename T>
+    using split_table_t = std::array<std::array<T, 16u>, 2u * sizeof(T)>;
+
+    template <typename T>
+    T split_multiply(const split_table_t<T> &table, T x) {
+        T r = 0u;
+        for (std::size_t n = 0u; n < 2u * sizeof(T); n++) {
+            r ^= table[n][(x >> (4u * n)) & 0xfu];
+        }
+
+        return r;
+    }
+
+    template <typename T, bool Accumulate>
+    void mul_region_generic(T *dst, const T *src, const split_table_t<T> &table, std::size_t len) {
+        /* For long byte regions, expanding to a full product table saves a lookup per element. */
+        if (sizeof(T) == 1u && len >= 256u) {
+            std::array<T, 256u> products;
+            for (std::size_t v = 0u; v < products.size(); v++) {
+                products[v] = table[0u][v & 0xfu] ^ table[1u][v >> 4u];
+            }
+
+            for (std::size_t i = 0u; i < len; i++) {
+                dst[i] = Accumulate ? (dst[i] ^ products[src[i]]) : products[src[i]];
+            }
+
+            return;
+        }
+
+        /*
+        Likewise for long 16-bit regions, with a product table for each
+        byte of the source element rather than one for each nibble.
+        */
+        if constexpr (sizeof(T) == 2u) {
+            if (len >= 512u) {
+                std::array<T, 256u> products_low, products_high;
+                for (std::size_t v = 0u; v < 256u; v++) {
+                    products_low[v] = table[0u][v & 0xfu] ^ table[1u][v >> 4u];
+                    products_high[v] = table[2u][v & 0xfu] ^ table[3u][v >> 4u];
+                }
+
+                for (std::size_t i = 0u; i < len; i++) {
+                    T r = products_low[src[i] & 0xffu] ^ products_high[src[i] >> 8u];
+                    dst[i] = Accumulate ? (dst[i] ^ r) : r;
+                }
+
+                return;
             }
         }
 
-        return e;
+        for (std::size_t i = 0u; i < len; i++) {
+            T r = split_multiply(table, src[i]);
+            dst[i] = Accumulate ? (dst[i] ^ r) : r;
+        }
     }
+
+    /*
+    Multiply a region by a constant, either overwriting (Accumulate = false)
+    or adding to (Accumulate = true) the destination. The SIMD
+    specialisations handle whole vectors and fall back to the generic
+    function for the tail.
+    */
+    template <typename T, bool Accumulate>
+    struct region_op_container {
+        static void op(T *dst, const T *src, const split_table_t<T> &table, std::size_t len) {
+            mul_region_generic<T, Accumulate>(dst, src, table, len);
+        }
+    };
+
+    /* Include any specialisations. */
+#if defined(USE_SIMD_X86)
+    #include "FEC/GaloisFieldSIMD_x86.h"
+#endif
 }
 
 /* Class for doing arithmetic operations in the specified Galois field. */
@@ -56,52 +158,136 @@ class GaloisFieldImpl {
     static constexpr std::size_t gen_poly = Detail::integer_from_index_sequence<std::size_t>(
         (typename Primitive::ones_index_sequence_reversed){});
 
+    static constexpr std::array<T, 2u << M> antilog_table = Detail::get_antilog_table<T, M, gen_poly>();
+
+    static constexpr std::array<T, 1u << M> log_table = Detail::get_log_table<T, M, gen_poly>();
+
+public:
+    using gf_t = T;
+
+    static constexpr T add(T x, T y) { return x^y; }
+
+    static constexpr T subtract(T x, T y) { return x^y; }
+
+    /* Number of non-zero elements, which is the period of alpha^i. */
+    static constexpr std::size_t field_size() { return (1u << M) - 1u; }
+
+    static constexpr T log(T x) { return log_table[x]; }
+
+    /* Valid for exponents up to 2^(M+1) - 1, so sums of two logs need no reduction. */
+    static constexpr T antilog(std::size_t x) { return antilog_table[x]; }
+
+    static constexpr T multiply(T x, T y) {
+        return (x && y) ? antilog(std::size_t(log(x)) + log(y)) : 0u;
+    }
+
+    static constexpr T divide(T x, T y) {
+        return (x && y) ? antilog(field_size() + log(x) - log(y)) : 0u;
+    }
+
     /*
-    Get an array containing the elements of the Galois field in
-    exponent-order.
+    Batch operations on vectors of 'len' elements. multiply_n sets
+    dst[i] = x[i] * y[i], and 'dst' may be equal to either input.
     */
-    template <std::size_t... I>
-    static constexpr std::array<T, sizeof...(I)> get_field_elements(std::index_sequence<I...>) {
-        return std::array<T, sizeof...(I)>{ Detail::get_field_element<T, M, gen_poly>(I) ... };
+    static void multiply_n(gf_t *dst, const gf_t *x, const gf_t *y, std::size_t len) {
+        for (std::size_t i = 0u; i < len; i++) {
+            dst[i] = multiply(x[i], y[i]);
+        }
     }
 
-    static constexpr std::array<T, 1u << M> antilog_table = get_field_elements(std::make_index_sequence<1u << M>{});
+    /* Inner product of 'x' and 'y'. */
+    static gf_t dot(const gf_t *x, const gf_t *y, std::size_t len) {
+        gf_t r = 0u;
+        for (std::size_t i = 0u; i < len; i++) {
+            r ^= multiply(x[i], y[i]);
+        }
+
+        return r;
+    }
 
     /*
-    Get an array containing the exponents corresponding to each element of
-    the Galois field.
+    Evaluate a polynomial with 'len' coefficients, highest order first, at
+    'x' using Horner's rule. Each step is a dependent log and antilog
+    lookup, so the coefficients are split into four interleaved chains
+    stepping by x^4, which are combined at the end.
     */
-    template <std::size_t... I>
-    static constexpr std::array<T, sizeof...(I)> get_field_elements_inverse(std::index_sequence<I...>) {
-        constexpr std::array<T, sizeof...(I)> temp_antilog = get_field_elements(std::make_index_sequence<1u << M>{});
-        std::array<T, sizeof...(I)> temp = {};
+    static gf_t evaluate(const gf_t *poly, std::size_t len, gf_t x) {
+        if (!len) {
+            return 0u;
+        } else if (!x) {
+            return poly[len - 1u];
+        }
 
-        for (std::size_t i = 0u; i < sizeof...(I) - 1u; i++) {
-            temp[temp_antilog[i]] = i;
+        std::size_t e = log(x);
+        auto step = [](gf_t r, std::size_t e) { return r ? antilog(log(r) + e) : 0u; };
+
+        /* Leading coefficients which do not fill a block of four. */
+        std::size_t head = len % 4u;
+        gf_t r[4u] = { 0u, 0u, 0u, 0u };
+        for (std::size_t i = 0u; i < head; i++) {
+            r[3u] = step(r[3u], e) ^ poly[i];
         }
 
-        return temp;
-    }
+        std::size_t e4 = (4u * e) % field_size();
+        for (std::size_t i = head; i < len; i += 4u) {
+            for (std::size_t c = 0u; c < 4u; c++) {
+                r[c] = step(r[c], e4) ^ poly[i + c];
+            }
+        }
 
-    static constexpr std::array<T, 1u << M> log_table = get_field_elements_inverse(std::make_index_sequence<1u << M>{});
+        return step(step(step(r[0u], e) ^ r[1u], e) ^ r[2u], e) ^ r[3u];
+    }
 
-public:
-    using gf_t = T;
+    /*
+    Evaluate a polynomial with 'len' coefficients, highest order first and
+    'stride' elements apart, at each of the 'n' points in 'x', writing the
+    values to 'dst'.
+    */
+    static void evaluate_n(gf_t *dst, const gf_t *poly, std::size_t len, std::size_t stride,
+            const gf_t *x, std::size_t n) {
+        for (std::size_t k = 0u; k < n; k++) {
+            gf_t r = 0u;
+            for (std::size_t i = 0u; i < len; i++) {
+                r = multiply(r, x[k]) ^ poly[i * stride];
+            }
 
-    static constexpr T add(T x, T y) { return x^y; }
+            dst[k] = r;
+        }
+    }
 
-    static constexpr T subtract(T x, T y) { return x^y; }
+    /* Build the split multiplication table for the constant 'c'. */
+    static Detail::split_table_t<T> split_table(T c) {
+        Detail::split_table_t<T> table = {};
+
+        /* Walk 'e' through c * alpha^k, filling in one bit of a nibble at a time. */
+        T e = c;
+        for (std::size_t n = 0u; n < table.size(); n++) {
+            for (std::size_t b = 0u; b < 4u; b++) {
+                std::size_t bit = 1u << b;
+                for (std::size_t v = 0u; v < bit; v++) {
+                    table[n][bit | v] = table[n][v] ^ e;
+                }
 
-    static constexpr T log(T x) { return log_table[x]; }
+                e = (e & (1u << (M - 1u))) ? ((e << 1u) ^ gen_poly) : (e << 1u);
+            }
+        }
 
-    static constexpr T antilog(T x) { return antilog_table[x]; }
+        return table;
+    }
 
-    static constexpr T multiply(T x, T y) {
-        return (x && y) ? antilog((log(x) + log(y)) % ((1u << M) - 1u)) : 0u;
+    /*
+    Region operations, which set dst[i] = c * src[i] (mul_region) or
+    dst[i] += c * src[i] (mul_add_region) for 'len' elements. 'dst' may be
+    equal to 'src', but the regions must not otherwise overlap.
+    */
+    static void mul_region(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+        Detail::region_op_container<T, false>::op(dst, src, split_table(c), len);
     }
 
-    static constexpr T divide(T x, T y) {
-        return (x && y) ? antilog((((1u << M) - 1u) + log(x) - log(y)) % ((1u << M) - 1u)) : 0u;
+    static void mul_add_region(gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+        if (c) {
+            Detail::region_op_container<T, true>::op(dst, src, split_table(c), len);
+        }
     }
 
     template <std::size_t Len1, std::size_t Len2>
@@ -139,15 +325,22 @@ public:
             const std::array<gf_t, Len1>& x, const std::array<gf_t, Len2>& y) {
         std::array<gf_t, Len1> d = x;
 
+        /* Divisor logarithms are fixed, so look them up once. */
+        std::array<std::size_t, Len2> log_y = {};
+        for (std::size_t j = 1u; j < Len2; j++) {
+            log_y[j] = log(y[j]);
+        }
+
         for (std::size_t i = 0u; i < Len1 - Len2 + 1u; i++) {
             if (d[i] != 0u) {
+                std::size_t e = log(d[i]);
                 for (std::size_t j = 1u; j < Len2; j++) {
                     if (y[j] != 0u) {
                         /*
                         Already have zero-checks here, so avoid repeating
                         them in the GF multiplication function.
                         */
-                        d[i + j] ^= antilog((log(y[j]) + log(d[i])) % ((1u << M) - 1u));
+                        d[i + j] ^= antilog(log_y[j] + e);
                     }
                 }
             }
@@ -173,7 +366,8 @@ public:
 
         for (std::size_t i = 0u; i < Len1 - sizeof...(Gs); i++) {
             if (d[i] != 0u) {
-                ((d[i + Is + 1u] ^= antilog((log(Gs) + log(d[i])) % ((1u << M) - 1u))), ...);
+                std::size_t e = log(d[i]);
+                ((d[i + Is + 1u] ^= (Gs ? antilog(std::size_t(log(Gs)) + e) : 0u)), ...);
             }
         }
 
@@ -182,31 +376,49 @@ public:
 };
 
 template <typename T, std::size_t M, typename Primitive>
-constexpr std::array<T, 1u << M> GaloisFieldImpl<T, M, Primitive>::antilog_table;
+constexpr std::array<T, 2u << M> GaloisFieldImpl<T, M, Primitive>::antilog_table;
 
 template <typename T, std::size_t M, typename Primitive>
 constexpr std::array<T, 1u << M> GaloisFieldImpl<T, M, Primitive>::log_table;
 
 /*
-Selects the appropriate type for the Galois field primitive based on the
-order of the field.
+Implementations of the field arithmetic which GaloisField, and the codes
+built on it, can select between. Each provides the same interface for
+arithmetic on elements, regions and polynomials, and the table backend
+also has log(), antilog() and split_table().
+
+Tables, the default, uses log and antilog tables, for fields of up to
+2^16 elements. Carryless, in FEC/CarrylessGaloisField.h, uses carry-less
+multiplication and Barrett reduction, and has no tables.
+*/
+namespace GaloisFieldBackends {
+    struct Tables {};
+}
+
+/*
+Galois field with the arithmetic given by Backend. For the table backend,
+this selects the appropriate type for the Galois field primitive based on
+the order of the field. Other backends provide their own implementation
+as Backend::field.
 */
-template <std::size_t M, typename Primitive> class GaloisField;
-template <typename Primitive> class GaloisField<1u, Primitive> : public GaloisFieldImpl<uint8_t, 1u, Primitive> {};
-template <typename Primitive> class GaloisField<2u, Primitive> : public GaloisFieldImpl<uint8_t, 2u, Primitive> {};
-template <typename Primitive> class GaloisField<3u, Primitive> : public GaloisFieldImpl<uint8_t, 3u, Primitive> {};
-template <typename Primitive> class GaloisField<4u, Primitive> : public GaloisFieldImpl<uint8_t, 4u, Primitive> {};
-template <typename Primitive> class GaloisField<5u, Primitive> : public GaloisFieldImpl<uint8_t, 5u, Primitive> {};
-template <typename Primitive> class GaloisField<6u, Primitive> : public GaloisFieldImpl<uint8_t, 6u, Primitive> {};
-template <typename Primitive> class GaloisField<7u, Primitive> : public GaloisFieldImpl<uint8_t, 7u, Primitive> {};
-template <typename Primitive> class GaloisField<8u, Primitive> : public GaloisFieldImpl<uint8_t, 8u, Primitive> {};
-template <typename Primitive> class GaloisField<9u, Primitive> : public GaloisFieldImpl<uint16_t, 9u, Primitive> {};
-template <typename Primitive> class GaloisField<10u, Primitive> : public GaloisFieldImpl<uint16_t, 10u, Primitive> {};
-template <typename Primitive> class GaloisField<11u, Primitive> : public GaloisFieldImpl<uint16_t, 11u, Primitive> {};
-template <typename Primitive> class GaloisField<12u, Primitive> : public GaloisFieldImpl<uint16_t, 12u, Primitive> {};
-template <typename Primitive> class GaloisField<13u, Primitive> : public GaloisFieldImpl<uint16_t, 13u, Primitive> {};
-template <typename Primitive> class GaloisField<14u, Primitive> : public GaloisFieldImpl<uint16_t, 14u, Primitive> {};
-template <typename Primitive> class GaloisField<15u, Primitive> : public GaloisFieldImpl<uint16_t, 15u, Primitive> {};
-template <typename Primitive> class GaloisField<16u, Primitive> : public GaloisFieldImpl<uint16_t, 16u, Primitive> {};
+template <std::size_t M, typename Primitive, typename Backend = GaloisFieldBackends::Tables>
+class GaloisField : public Backend::template field<M, Primitive> {};
+
+template <typename Primitive> class GaloisField<1u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 1u, Primitive> {};
+template <typename Primitive> class GaloisField<2u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 2u, Primitive> {};
+template <typename Primitive> class GaloisField<3u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 3u, Primitive> {};
+template <typename Primitive> class GaloisField<4u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 4u, Primitive> {};
+template <typename Primitive> class GaloisField<5u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 5u, Primitive> {};
+template <typename Primitive> class GaloisField<6u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 6u, Primitive> {};
+template <typename Primitive> class GaloisField<7u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 7u, Primitive> {};
+template <typename Primitive> class GaloisField<8u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint8_t, 8u, Primitive> {};
+template <typename Primitive> class GaloisField<9u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 9u, Primitive> {};
+template <typename Primitive> class GaloisField<10u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 10u, Primitive> {};
+template <typename Primitive> class GaloisField<11u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 11u, Primitive> {};
+template <typename Primitive> class GaloisField<12u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 12u, Primitive> {};
+template <typename Primitive> class GaloisField<13u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 13u, Primitive> {};
+template <typename Primitive> class GaloisField<14u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 14u, Primitive> {};
+template <typename Primitive> class GaloisField<15u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 15u, Primitive> {};
+template <typename Primitive> class GaloisField<16u, Primitive, GaloisFieldBackends::Tables> : public GaloisFieldImpl<uint16_t, 16u, Primitive> {};
 
 }
@@ -0,0 +1,286 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include <x86intrin.h>
+
+/*
+Check at run time whether the CPU supports AVX2, GFNI and PCLMULQDQ. If
+the compiler already targets them, the check is resolved at compile time.
+The GFNI kernels use 256-bit vectors, so they also require AVX2.
+*/
+static inline bool cpu_supports_avx2() {
+#if defined(__AVX2__)
+    return true;
+#else
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#endif
+}
+
+static inline bool cpu_supports_gfni() {
+#if defined(__GFNI__) && defined(__AVX2__)
+    return true;
+#else
+    static const bool supported = __builtin_cpu_supports("gfni") && cpu_supports_avx2();
+    return supported;
+#endif
+}
+
+static inline bool cpu_supports_pclmul() {
+#if defined(__PCLMUL__) && defined(__SSE4_1__)
+    return true;
+#else
+    static const bool supported = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+    return supported;
+#endif
+}
+
+/*
+GF(2^M) multiplication by a constant for M <= 8. Each kernel processes
+whole vectors and returns the number of elements done.
+
+The SSSE3 and AVX2 kernels look up the low and high nibble of each byte in
+the two 16-entry split tables with PSHUFB.
+*/
+template <bool Accumulate>
+static inline std::size_t mul_region_ssse3(uint8_t *dst, const uint8_t *src,
+        const split_table_t<uint8_t> &table, std::size_t len) {
+    const __m128i lo_table = _mm_loadu_si128((const __m128i *)table[0u].data());
+    const __m128i hi_table = _mm_loadu_si128((const __m128i *)table[1u].data());
+    const __m128i mask = _mm_set1_epi8(0x0f);
+
+    std::size_t i = 0u;
+    for (; i + 16u <= len; i += 16u) {
+        __m128i x = _mm_loadu_si128((const __m128i *)&src[i]);
+        __m128i r = _mm_xor_si128(_mm_shuffle_epi8(lo_table, _mm_and_si128(x, mask)),
+            _mm_shuffle_epi8(hi_table, _mm_and_si128(_mm_srli_epi64(x, 4), mask)));
+        if (Accumulate) {
+            r = _mm_xor_si128(r, _mm_loadu_si128((const __m128i *)&dst[i]));
+        }
+
+        _mm_storeu_si128((__m128i *)&dst[i], r);
+    }
+
+    return i;
+}
+
+template <bool Accumulate>
+__attribute__((target("avx2")))
+static inline std::size_t mul_region_avx2(uint8_t *dst, const uint8_t *src,
+        const split_table_t<uint8_t> &table, std::size_t len) {
+    const __m256i lo_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)table[0u].data()));
+    const __m256i hi_table = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)table[1u].data()));
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+
+    std::size_t i = 0u;
+    for (; i + 32u <= len; i += 32u) {
+        __m256i x = _mm256_loadu_si256((const __m256i *)&src[i]);
+        __m256i r = _mm256_xor_si256(_mm256_shuffle_epi8(lo_table, _mm256_and_si256(x, mask)),
+            _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask)));
+        if (Accumulate) {
+            r = _mm256_xor_si256(r, _mm256_loadu_si256((const __m256i *)&dst[i]));
+        }
+
+        _mm256_storeu_si256((__m256i *)&dst[i], r);
+    }
+
+    return i;
+}
+
+/*
+Multiplication by a constant is a linear map on the bits of an element, so
+GFNI does it with a single GF2P8AFFINEQB. Row i of the 8 x 8 bit matrix,
+held in byte 7 - i, selects the input bits that contribute to output bit i.
+Unlike GF2P8MULB this is not tied to the AES polynomial.
+*/
+static inline uint64_t affine_matrix(const split_table_t<uint8_t> &table) {
+    uint64_t matrix = 0u;
+    for (std::size_t i = 0u; i < 8u; i++) {
+        uint64_t row = 0u;
+        for (std::size_t j = 0u; j < 8u; j++) {
+            row |= (uint64_t)((table[j / 4u][1u << (j % 4u)] >> i) & 1u) << j;
+        }
+
+        matrix |= row << (8u * (7u - i));
+    }
+
+    return matrix;
+}
+
+template <bool Accumulate>
+__attribute__((target("avx2,gfni")))
+static inline std::size_t mul_region_gfni(uint8_t *dst, const uint8_t *src,
+        const split_table_t<uint8_t> &table, std::size_t len) {
+    const __m256i matrix = _mm256_set1_epi64x((long long)affine_matrix(table));
+
+    std::size_t i = 0u;
+    for (; i + 32u <= len; i += 32u) {
+        __m256i r = _mm256_gf2p8affine_epi64_epi8(_mm256_loadu_si256((const __m256i *)&src[i]), matrix, 0);
+        if (Accumulate) {
+            r = _mm256_xor_si256(r, _mm256_loadu_si256((const __m256i *)&dst[i]));
+        }
+
+        _mm256_storeu_si256((__m256i *)&dst[i], r);
+    }
+
+    return i;
+}
+
+template <bool Accumulate>
+struct region_op_container<uint8_t, Accumulate> {
+    static void op(uint8_t *dst, const uint8_t *src, const split_table_t<uint8_t> &table, std::size_t len) {
+        std::size_t i = 0u;
+        if (cpu_supports_gfni()) {
+            i = mul_region_gfni<Accumulate>(dst, src, table, len);
+        } else if (cpu_supports_avx2()) {
+            i = mul_region_avx2<Accumulate>(dst, src, table, len);
+        }
+
+        i += mul_region_ssse3<Accumulate>(&dst[i], &src[i], table, len - i);
+        mul_region_generic<uint8_t, Accumulate>(&dst[i], &src[i], table, len - i);
+    }
+};
+
+/*
+GF(2^M) multiplication by a constant for 8 < M <= 16. Two vectors of
+16-bit elements are split into a vector of low bytes and a vector of high
+bytes, and each of the four nibbles is looked up in a table of low product
+bytes and a table of high product bytes. Unpacking the two product vectors
+restores the original element order, and since every step stays within a
+128-bit lane the AVX2 kernel needs no cross-lane shuffles.
+*/
+template <bool Accumulate>
+static inline std::size_t mul_region_ssse3(uint16_t *dst, const uint16_t *src,
+        const split_table_t<uint16_t> &table, std::size_t len) {
+    __m128i lo_tables[4u], hi_tables[4u];
+    for (std::size_t n = 0u; n < 4u; n++) {
+        uint8_t lo[16u], hi[16u];
+        for (std::size_t v = 0u; v < 16u; v++) {
+            lo[v] = table[n][v] & 0xffu;
+            hi[v] = table[n][v] >> 8u;
+        }
+
+        lo_tables[n] = _mm_loadu_si128((const __m128i *)lo);
+        hi_tables[n] = _mm_loadu_si128((const __m128i *)hi);
+    }
+
+    const __m128i split = _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    const __m128i mask = _mm_set1_epi8(0x0f);
+
+    std::size_t i = 0u;
+    for (; i + 16u <= len; i += 16u) {
+        __m128i a = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&src[i]), split);
+        __m128i b = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&src[i + 8u]), split);
+        __m128i x_lo = _mm_unpacklo_epi64(a, b);
+        __m128i x_hi = _mm_unpackhi_epi64(a, b);
+        __m128i nibbles[4u] = {
+            _mm_and_si128(x_lo, mask), _mm_and_si128(_mm_srli_epi64(x_lo, 4), mask),
+            _mm_and_si128(x_hi, mask), _mm_and_si128(_mm_srli_epi64(x_hi, 4), mask)
+        };
+
+        __m128i r_lo = _mm_setzero_si128(), r_hi = _mm_setzero_si128();
+        for (std::size_t n = 0u; n < 4u; n++) {
+            r_lo = _mm_xor_si128(r_lo, _mm_shuffle_epi8(lo_tables[n], nibbles[n]));
+            r_hi = _mm_xor_si128(r_hi, _mm_shuffle_epi8(hi_tables[n], nibbles[n]));
+        }
+
+        a = _mm_unpacklo_epi8(r_lo, r_hi);
+        b = _mm_unpackhi_epi8(r_lo, r_hi);
+        if (Accumulate) {
+            a = _mm_xor_si128(a, _mm_loadu_si128((const __m128i *)&dst[i]));
+            b = _mm_xor_si128(b, _mm_loadu_si128((const __m128i *)&dst[i + 8u]));
+        }
+
+        _mm_storeu_si128((__m128i *)&dst[i], a);
+        _mm_storeu_si128((__m128i *)&dst[i + 8u], b);
+    }
+
+    return i;
+}
+
+template <bool Accumulate>
+__attribute__((target("avx2")))
+static inline std::size_t mul_region_avx2(uint16_t *dst, const uint16_t *src,
+        const split_table_t<uint16_t> &table, std::size_t len) {
+    __m256i lo_tables[4u], hi_tables[4u];
+    for (std::size_t n = 0u; n < 4u; n++) {
+        uint8_t lo[16u], hi[16u];
+        for (std::size_t v = 0u; v < 16u; v++) {
+            lo[v] = table[n][v] & 0xffu;
+            hi[v] = table[n][v] >> 8u;
+        }
+
+        lo_tables[n] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)lo));
+        hi_tables[n] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)hi));
+    }
+
+    const __m256i split = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+
+    std::size_t i = 0u;
+    for (; i + 32u <= len; i += 32u) {
+        __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)&src[i]), split);
+        __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)&src[i + 16u]), split);
+        __m256i x_lo = _mm256_unpacklo_epi64(a, b);
+        __m256i x_hi = _mm256_unpackhi_epi64(a, b);
+        __m256i nibbles[4u] = {
+            _mm256_and_si256(x_lo, mask), _mm256_and_si256(_mm256_srli_epi64(x_lo, 4), mask),
+            _mm256_and_si256(x_hi, mask), _mm256_and_si256(_mm256_srli_epi64(x_hi, 4), mask)
+        };
+
+        __m256i r_lo = _mm256_setzero_si256(), r_hi = _mm256_setzero_si256();
+        for (std::size_t n = 0u; n < 4u; n++) {
+            r_lo = _mm256_xor_si256(r_lo, _mm256_shuffle_epi8(lo_tables[n], nibbles[n]));
+            r_hi = _mm256_xor_si256(r_hi, _mm256_shuffle_epi8(hi_tables[n], nibbles[n]));
+        }
+
+        a = _mm256_unpacklo_epi8(r_lo, r_hi);
+        b = _mm256_unpackhi_epi8(r_lo, r_hi);
+        if (Accumulate) {
+            a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i *)&dst[i]));
+            b = _mm256_xor_si256(b, _mm256_loadu_si256((const __m256i *)&dst[i + 16u]));
+        }
+
+        _mm256_storeu_si256((__m256i *)&dst[i], a);
+        _mm256_storeu_si256((__m256i *)&dst[i + 16u], b);
+    }
+
+    return i;
+}
+
+template <bool Accumulate>
+struct region_op_container<uint16_t, Accumulate> {
+    static void op(uint16_t *dst, const uint16_t *src, const split_table_t<uint16_t> &table, std::size_t len) {
+        std::size_t i = 0u;
+        if (cpu_supports_avx2()) {
+            i = mul_region_avx2<Accumulate>(dst, src, table, len);
+        }
+
+        i += mul_region_ssse3<Accumulate>(&dst[i], &src[i], table, len - i);
+        mul_region_generic<uint16_t, Accumulate>(&dst[i], &src[i], table, len - i);
+    }
+};
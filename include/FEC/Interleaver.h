@@ -28,6 +28,10 @@ SOFTWARE.
 #include <type_traits>
 #include <utility>
 
+#if defined(USE_SIMD_X86)
+  #include <x86intrin.h>
+#endif
+
 #include "FEC/Types.h"
 #include "FEC/Utilities.h"
 #include "FEC/BinarySequence.h"
@@ -177,6 +181,11 @@ namespace Detail {
                 new_output_sequence{}, new_diff_sequence{});
         }
     }
+
+    /* Include any specialisations. */
+#if defined(USE_SIMD_X86)
+    #include "FEC/InterleaverSIMD_x86.h"
+#endif
 }
 
 namespace Convolutional {
@@ -237,7 +246,8 @@ class Interleaver {
     static std::array<uint8_t, sizeof...(O)> interleave_block(const std::array<bool_vec_t, N> &in,
             std::index_sequence<I...>, std::index_sequence<O...>) {
         /* Pack bits into input vector and interleave. */
-        std::array<bool_vec_t, sizeof...(I)> out_vec = { pack_and_spread_vec<I>(in, std::make_index_sequence<NumPoly>{}) ... };
+        std::array<bool_vec_t, sizeof...(I)> out_vec = {
+            spread_words(pack_in_vec<I>(in, std::make_index_sequence<NumPoly>{}), std::make_index_sequence<NumPoly>{}) ... };
 
         /* Pack interleaved bits into output buffer. */
         return std::array<uint8_t, sizeof...(O)>{ pack_out_vec<O>(out_vec) ... };
@@ -245,10 +255,11 @@ class Interleaver {
 
     /*
     Pack bits from 'in' into a bool_vec_t array such that they are aligned
-    correctly, and then call spread_words.
+    correctly for spread_words.
     */
     template <std::size_t I, std::size_t N, std::size_t... PolyIndices>
-    static bool_vec_t pack_and_spread_vec(const std::array<bool_vec_t, N> &in, std::index_sequence<PolyIndices...>) {
+    static std::array<bool_vec_t, NumPoly> pack_in_vec(const std::array<bool_vec_t, N> &in,
+            std::index_sequence<PolyIndices...>) {
         constexpr std::size_t coarse_offset = ((I * num_in_bits()) / (sizeof(bool_vec_t) * 8u)) * NumPoly;
         constexpr std::size_t fine_offset = (I * num_in_bits()) % (sizeof(bool_vec_t) * 8u);
 
@@ -261,7 +272,7 @@ class Interleaver {
         constexpr bool_vec_t mask = Detail::mask_bits(num_in_bits());
         ((in_vec[PolyIndices] &= mask), ...);
 
-        return spread_words(in_vec, std::index_sequence<PolyIndices...>{});
+        return in_vec;
     }
 
     /* Pack 8 bits from 'in' into a single output byte. */
@@ -314,7 +325,8 @@ class Interleaver {
 
         /* Deinterleave and pack bits into output vector. */
         std::array<bool_vec_t, N> out = {};
-        (despread_and_pack_vector<O>(in_vec, out, std::make_index_sequence<NumPoly>{}), ...);
+        (pack_despread_vec<O>(despread_words(in_vec[O], std::make_index_sequence<NumPoly>{}), out,
+            std::make_index_sequence<NumPoly>{}), ...);
 
         return out;
     }
@@ -338,18 +350,19 @@ class Interleaver {
         }
     }
 
-    /*
-    Deinterleave bits from the input vector, and then pack them into the
-    array of output vectors.
-    */
-    template <std::size_t O, std::size_t N, std::size_t M, std::size_t... PolyIndices>
-    static void despread_and_pack_vector(const std::array<bool_vec_t, N> &in_vec, std::array<bool_vec_t, M> &out,
-            std::index_sequence<PolyIndices...>) {
-        std::array<bool_vec_t, NumPoly> in_despread = { Detail::despread_word<1u>(
-            in_vec[O] << PolyIndices, output_index_sequence<PolyIndices>{},
+    /* Deinterleave the bits of one input vector for each polynomial. */
+    template <std::size_t... PolyIndices>
+    static std::array<bool_vec_t, NumPoly> despread_words(bool_vec_t in, std::index_sequence<PolyIndices...>) {
+        return std::array<bool_vec_t, NumPoly>{ Detail::despread_word<1u>(
+            in << PolyIndices, output_index_sequence<PolyIndices>{},
             (typename Detail::DiffIndexSequence<output_index_sequence<PolyIndices>,
             input_index_sequence<PolyIndices>>::type){}) ... };
+    }
 
+    /* Pack deinterleaved bits into the array of output vectors. */
+    template <std::size_t O, std::size_t M, std::size_t... PolyIndices>
+    static void pack_despread_vec(const std::array<bool_vec_t, NumPoly> &in_despread, std::array<bool_vec_t, M> &out,
+            std::index_sequence<PolyIndices...>) {
         constexpr std::size_t coarse_offset = ((O * num_in_bits()) / (sizeof(bool_vec_t) * 8u)) * NumPoly;
         constexpr std::size_t fine_offset = (O * num_in_bits()) % (sizeof(bool_vec_t) * 8u);
 
@@ -360,6 +373,61 @@ class Interleaver {
         }
     }
 
+#if defined(USE_SIMD_X86)
+    /*
+    The BMI2 backend replaces each chain of shift/mask operations with a
+    single PEXT to gather the bits of a polynomial, and a single PDEP to
+    scatter them to their final positions.
+    */
+    template <std::size_t PolyIndex>
+    static constexpr bool_vec_t input_mask() {
+        return Detail::mask_from_index_sequence(input_index_sequence<PolyIndex>{});
+    }
+
+    template <std::size_t PolyIndex>
+    static constexpr bool_vec_t output_mask() {
+        return Detail::mask_from_index_sequence(output_index_sequence<PolyIndex>{});
+    }
+
+    template <std::size_t... PolyIndices>
+    __attribute__((target("bmi2")))
+    static bool_vec_t spread_words_bmi2(const std::array<bool_vec_t, NumPoly> &in, std::index_sequence<PolyIndices...>) {
+        return (... | (Detail::pdep(Detail::pext(in[PolyIndices], input_mask<PolyIndices>()),
+            output_mask<PolyIndices>()) >> PolyIndices));
+    }
+
+    template <std::size_t... PolyIndices>
+    __attribute__((target("bmi2")))
+    static std::array<bool_vec_t, NumPoly> despread_words_bmi2(bool_vec_t in, std::index_sequence<PolyIndices...>) {
+        return std::array<bool_vec_t, NumPoly>{ Detail::pdep(Detail::pext(in << PolyIndices,
+            output_mask<PolyIndices>()), input_mask<PolyIndices>()) ... };
+    }
+
+    template <std::size_t N, std::size_t... I, std::size_t... O>
+    __attribute__((target("bmi2")))
+    static std::array<uint8_t, sizeof...(O)> interleave_block_bmi2(const std::array<bool_vec_t, N> &in,
+            std::index_sequence<I...>, std::index_sequence<O...>) {
+        std::array<bool_vec_t, sizeof...(I)> out_vec = {
+            spread_words_bmi2(pack_in_vec<I>(in, std::make_index_sequence<NumPoly>{}), std::make_index_sequence<NumPoly>{}) ... };
+
+        return std::array<uint8_t, sizeof...(O)>{ pack_out_vec<O>(out_vec) ... };
+    }
+
+    template <std::size_t N, std::size_t... I, std::size_t... O>
+    __attribute__((target("bmi2")))
+    static std::array<bool_vec_t, N> deinterleave_block_bmi2(const std::array<uint8_t, sizeof...(I)> &in,
+            std::index_sequence<I...>, std::index_sequence<O...>) {
+        std::array<bool_vec_t, sizeof...(O)> in_vec = {};
+        (unpack_in_vec<I>(in[I], in_vec), ...);
+
+        std::array<bool_vec_t, N> out = {};
+        (pack_despread_vec<O>(despread_words_bmi2(in_vec[O], std::make_index_sequence<NumPoly>{}), out,
+            std::make_index_sequence<NumPoly>{}), ...);
+
+        return out;
+    }
+#endif
+
 public:
     /*
     Size (in bool_vec_t) of the input buffer required to supply a full
@@ -377,16 +445,56 @@ public:
         return BlockSize * PuncturingMatrix::ones() / (PuncturingMatrix::size() / NumPoly);
     }
 
-    /* Interleaves a block of bool_vec_t. */
+    /*
+    Interleaves a block of bool_vec_t. When built with USE_SIMD_X86, the
+    BMI2 backend is used if the CPU supports it.
+    */
     static std::array<uint8_t, out_buf_len()> interleave(const std::array<bool_vec_t, in_buf_len()> &in) {
-        return interleave_block(in, std::make_index_sequence<num_iterations()>{}, std::make_index_sequence<out_buf_len()>{});
+#if defined(USE_SIMD_X86)
+        if (Detail::cpu_supports_bmi2()) {
+            return interleave_bmi2(in);
+        }
+#endif
+        return interleave_generic(in);
     }
 
     /* Deinterleaves a block of bytes. */
     static std::array<bool_vec_t, in_buf_len()> deinterleave(const std::array<uint8_t, out_buf_len()> &in) {
+#if defined(USE_SIMD_X86)
+        if (Detail::cpu_supports_bmi2()) {
+            return deinterleave_bmi2(in);
+        }
+#endif
+        return deinterleave_generic(in);
+    }
+
+    /* Interleave and deinterleave using shift/mask operations only. */
+    static std::array<uint8_t, out_buf_len()> interleave_generic(const std::array<bool_vec_t, in_buf_len()> &in) {
+        return interleave_block(in, std::make_index_sequence<num_iterations()>{}, std::make_index_sequence<out_buf_len()>{});
+    }
+
+    static std::array<bool_vec_t, in_buf_len()> deinterleave_generic(const std::array<uint8_t, out_buf_len()> &in) {
         return deinterleave_block<in_buf_len()>(in,
             std::make_index_sequence<out_buf_len()>{}, std::make_index_sequence<num_iterations()>{});
     }
+
+#if defined(USE_SIMD_X86)
+    /*
+    Interleave and deinterleave using BMI2. These must only be called if
+    Detail::cpu_supports_bmi2() returns true.
+    */
+    __attribute__((target("bmi2")))
+    static std::array<uint8_t, out_buf_len()> interleave_bmi2(const std::array<bool_vec_t, in_buf_len()> &in) {
+        return interleave_block_bmi2(in, std::make_index_sequence<num_iterations()>{},
+            std::make_index_sequence<out_buf_len()>{});
+    }
+
+    __attribute__((target("bmi2")))
+    static std::array<bool_vec_t, in_buf_len()> deinterleave_bmi2(const std::array<uint8_t, out_buf_len()> &in) {
+        return deinterleave_block_bmi2<in_buf_len()>(in,
+            std::make_index_sequence<out_buf_len()>{}, std::make_index_sequence<num_iterations()>{});
+    }
+#endif
 };
 
 }
@@ -0,0 +1,60 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+#pragma once
+
+#include <x86intrin.h>
+
+/*
+Check at run time whether the CPU supports the BMI2 instructions. If the
+compiler already targets BMI2, the check is resolved at compile time.
+*/
+static inline bool cpu_supports_bmi2() {
+#if defined(__BMI2__)
+    return true;
+#else
+    static const bool supported = __builtin_cpu_supports("bmi2");
+    return supported;
+#endif
+}
+
+/* Gather the bits of 'in' selected by 'mask' into the low bits of the result. */
+__attribute__((target("bmi2")))
+static inline bool_vec_t pext(bool_vec_t in, bool_vec_t mask) {
+#if defined(__x86_64__)
+    return _pext_u64(in, mask);
+#else
+    return _pext_u32(in, mask);
+#endif
+}
+
+/* Scatter the low bits of 'in' to the bits selected by 'mask'. */
+__attribute__((target("bmi2")))
+static inline bool_vec_t pdep(bool_vec_t in, bool_vec_t mask) {
+#if defined(__x86_64__)
+    return _pdep_u64(in, mask);
+#else
+    return _pdep_u32(in, mask);
+#endif
+}
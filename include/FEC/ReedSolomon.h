@@ -22,13 +22,25 @@ SOFTWARE.
 
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
+#include <vector>
+
+#if defined(USE_SIMD_X86)
+    #include <x86intrin.h>
+#endif
 
 #include "FEC/Types.h"
 #include "FEC/Utilities.h"
 #include "FEC/GaloisField.h"
+#include "FEC/CarrylessGaloisField.h"
 
 namespace Thiemar {
 
@@ -77,6 +89,405 @@ namespace Detail {
     struct generator_polynomial<GF, Parity, 0u> {
         using coefficients = std::integer_sequence<typename GF::gf_t, 1u>;
     };
+
+    /* Generator coefficients below the leading (unity) term, highest order first. */
+    template <typename T, T G, T... Gs>
+    constexpr std::array<T, sizeof...(Gs)> feedback_coefficients(std::integer_sequence<T, G, Gs...>) {
+        return std::array<T, sizeof...(Gs)>{ Gs... };
+    }
+
+    /* All generator coefficients, highest order first. */
+    template <typename T, T... Gs>
+    constexpr std::array<T, sizeof...(Gs)> generator_coefficients(std::integer_sequence<T, Gs...>) {
+        return std::array<T, sizeof...(Gs)>{ Gs... };
+    }
+
+    /*
+    Calculate 'parity' syndromes of a single codeword of 'len' symbols, for
+    the roots alpha^1 to alpha^parity. The decoders have their own
+    table-driven loops, so there is no generic kernel, and available()
+    is true only where a specialisation is faster on this CPU for 'parity'
+    roots.
+    */
+    template <std::size_t M, typename Primitive, typename T = typename GaloisField<M, Primitive>::gf_t>
+    struct syndrome_op_container {
+        static constexpr bool available(std::size_t) { return false; }
+        static void op(const T *, std::size_t, std::size_t, T *) {}
+    };
+
+    /*
+    Kernels for Depth interleaved codewords, with symbol i of codeword l at
+    frame[i * Depth + l]. 'tables' holds the split multiplication tables of
+    the constants the kernel multiplies by: the generator coefficients for
+    the encoder, and the roots alpha^1 to alpha^Parity for the syndromes.
+
+    The generic encoder runs the shift register of each codeword over its
+    own strided symbols, and the generic syndrome check reports every
+    codeword as possibly in error, leaving the check to the decoder. The
+    SIMD specialisations work on all of the codewords at once.
+    */
+    template <typename Encoder, typename T, std::size_t Depth, std::size_t Parity>
+    struct interleaved_encode_op_container {
+        static void op(T *frame, std::size_t len, const std::array<split_table_t<T>, Parity> &) {
+            for (std::size_t l = 0u; l < Depth; l++) {
+                Encoder::encode_strided(&frame[l], len, Depth, &frame[len * Depth + l], Depth);
+            }
+        }
+    };
+
+    /* Returns a mask with bit l set if codeword l may contain errors. */
+    template <typename T, std::size_t Depth, std::size_t Parity>
+    struct interleaved_syndrome_op_container {
+        static uint64_t op(const T *, std::size_t, const std::array<split_table_t<T>, Parity> &) {
+            return ((uint64_t)1u << Depth) - 1u;
+        }
+    };
+
+    /* Include any specialisations. */
+#if defined(USE_SIMD_X86)
+    #include "FEC/ReedSolomonSIMD_x86.h"
+#endif
+
+    /*
+    Erasure locator polynomial, prod(1 + X_k x) for erasures at X_k =
+    alpha^p_k, where p_k is the power of the erased symbol, together with
+    the erasure powers. It depends only on the erasure positions, so when a
+    number of codewords share the same erasures (for example after the loss
+    of a packet spread across an interleaved block), it can be calculated
+    once and reused.
+    */
+    template <typename T, std::size_t MaxParity>
+    struct ErasureLocator {
+        std::array<T, MaxParity + 1u> coefficients = { 1u };
+        std::array<std::size_t, MaxParity> locations = {};
+        std::size_t count = 0u;
+    };
+
+    /*
+    Decoding algorithms shared by ReedSolomonDecoder and ReedSolomonCodec,
+    for codes with generator roots alpha^1 to alpha^parity. The number of
+    parity symbols is a run-time argument, and MaxParity only bounds the
+    working storage, which is all on the stack.
+
+    With the table backend and fields of up to 2^8 elements,
+    'root_multiply' holds a table of 2^M entries for each root, with entry
+    x of table j being x times alpha^(j + 1). It is not used otherwise.
+
+    With the table backend, powers of alpha are handled as exponents and
+    multiplied by log and antilog lookups. Other backends have no log
+    table, so the powers are held as field elements and multiplied
+    directly, and the syndromes are calculated with one multiply per
+    symbol for each root.
+    */
+    template <std::size_t M, typename Primitive, std::size_t MaxParity,
+        typename Backend = GaloisFieldBackends::Tables>
+    struct ReedSolomonDecoderImpl {
+        using gf = GaloisField<M, Primitive, Backend>;
+        using gf_t = typename gf::gf_t;
+        using erasure_locator_t = ErasureLocator<gf_t, MaxParity>;
+
+        static constexpr bool log_tables = std::is_same<Backend, GaloisFieldBackends::Tables>::value;
+
+        /* A power of alpha, as its exponent or as an element depending on the backend. */
+        using power_t = typename std::conditional<log_tables, std::size_t, gf_t>::type;
+
+        static constexpr std::size_t field_size() { return (1u << M) - 1u; }
+
+        /* alpha^e, for e < 2^M - 1. */
+        static power_t alpha_power(std::size_t e) {
+            if constexpr (log_tables) {
+                return e;
+            } else {
+                return gf::power(2u, e);
+            }
+        }
+
+        /*
+        Multiply 'x' by a power of alpha. The antilog table spans two
+        periods, so the exponent sum needs no reduction.
+        */
+        static gf_t multiply_power(gf_t x, power_t a) {
+            if constexpr (log_tables) {
+                return x ? gf::antilog(gf::log(x) + a) : 0u;
+            } else {
+                return gf::multiply(x, a);
+            }
+        }
+
+        /* Evaluate a polynomial, lowest order coefficient first, at a power of alpha. */
+        static gf_t evaluate(const gf_t *poly, std::size_t degree, power_t a) {
+            gf_t r = 0u;
+            for (std::size_t i = degree + 1u; i-- > 0u;) {
+                r = multiply_power(r, a) ^ poly[i];
+            }
+
+            return r;
+        }
+
+        /*
+        Calculate the erasure locator for 'count' erased symbols of a
+        codeword of 'len' symbols, given as indices into the codeword.
+        Returns false if there are more erasures than parity symbols or an
+        index is out of range.
+        */
+        static bool calculate_erasure_locator(const std::size_t *erasures, std::size_t count, std::size_t len,
+                std::size_t parity, erasure_locator_t &locator) {
+            locator = erasure_locator_t{};
+            if (count > parity) {
+                return false;
+            }
+
+            for (std::size_t k = 0u; k < count; k++) {
+                if (erasures[k] >= len) {
+                    return false;
+                }
+
+                /* Multiply by (1 + X_k x). */
+                power_t x = alpha_power((len - 1u - erasures[k]) % field_size());
+                for (std::size_t i = k + 1u; i > 0u; i--) {
+                    locator.coefficients[i] ^= multiply_power(locator.coefficients[i - 1u], x);
+                }
+
+                locator.locations[k] = len - 1u - erasures[k];
+            }
+
+            locator.count = count;
+            return true;
+        }
+
+        /*
+        Calculate the syndromes of a codeword of 'len' symbols, with symbol
+        i at in[i * stride]. Returns true if any syndrome is non-zero.
+        */
+        static bool calculate_syndromes(const gf_t *in, std::size_t len, std::size_t stride, std::size_t parity,
+                const gf_t *root_multiply, gf_t *syndromes) {
+            std::fill_n(syndromes, parity, 0u);
+
+            if constexpr (!log_tables) {
+                /* Horner's rule, with one multiply per symbol for each root. */
+                std::array<gf_t, MaxParity> roots = {};
+                for (std::size_t j = 0u; j < parity; j++) {
+                    roots[j] = alpha_power(j + 1u);
+                }
+
+                gf::evaluate_n(syndromes, in, len, stride, roots.data(), parity);
+            } else if (stride == 1u && syndrome_op_container<M, Primitive>::available(parity)) {
+                syndrome_op_container<M, Primitive>::op(in, len, parity, syndromes);
+            } else if constexpr (M <= 8u) {
+                /*
+                Horner's rule, with one table lookup per symbol for each
+                root. Groups of syndromes are kept in registers so that
+                their dependency chains overlap.
+                */
+                constexpr std::size_t group = 8u;
+                for (std::size_t j0 = 0u; j0 < parity; j0 += group) {
+                    gf_t acc[group] = {};
+                    const gf_t *table = &root_multiply[j0 * (1u << M)];
+                    std::size_t n = std::min(group, parity - j0);
+
+                    if (n == group) {
+                        for (std::size_t i = 0u; i < len; i++) {
+                            for (std::size_t j = 0u; j < group; j++) {
+                                acc[j] = table[j * (1u << M) + acc[j]] ^ in[i * stride];
+                            }
+                        }
+                    } else {
+                        for (std::size_t i = 0u; i < len; i++) {
+                            for (std::size_t j = 0u; j < n; j++) {
+                                acc[j] = table[j * (1u << M) + acc[j]] ^ in[i * stride];
+                            }
+                        }
+                    }
+
+                    std::copy_n(acc, n, &syndromes[j0]);
+                }
+            } else {
+                /*
+                Each non-zero symbol c at power p adds c * alpha^(j * p) to
+                syndrome j, so only one log lookup is needed per symbol and
+                the exponent is stepped by p for each successive root.
+                */
+                for (std::size_t i = 0u; i < len; i++) {
+                    gf_t c = in[i * stride];
+                    if (!c) {
+                        continue;
+                    }
+
+                    std::size_t p = (len - 1u - i) % field_size();
+                    std::size_t e = (gf::log(c) + p) % field_size();
+                    for (std::size_t j = 0u; j < parity; j++) {
+                        syndromes[j] ^= gf::antilog(e);
+                        e += p;
+                        e -= (e >= field_size()) ? field_size() : 0u;
+                    }
+                }
+            }
+
+            gf_t any = 0u;
+            for (std::size_t j = 0u; j < parity; j++) {
+                any |= syndromes[j];
+            }
+
+            return any;
+        }
+
+        /*
+        Find the errata locator polynomial, lowest order coefficient first,
+        and return its degree. The iteration is started from the erasure
+        locator, so that only the remaining parity - s syndromes are spent
+        on locating errors.
+        */
+        static std::size_t berlekamp_massey(const gf_t *syndromes, std::size_t parity,
+                const erasure_locator_t &erasures, std::array<gf_t, MaxParity + 1u> &locator) {
+            std::array<gf_t, MaxParity + 1u> prev = erasures.coefficients;
+            std::size_t degree = erasures.count;
+            std::size_t shift = 1u;
+            gf_t prev_discrepancy = 1u;
+
+            locator = erasures.coefficients;
+
+            for (std::size_t n = erasures.count; n < parity; n++) {
+                gf_t discrepancy = 0u;
+                for (std::size_t i = 0u; i <= degree; i++) {
+                    discrepancy ^= gf::multiply(locator[i], syndromes[n - i]);
+                }
+
+                if (!discrepancy) {
+                    shift++;
+                    continue;
+                }
+
+                gf_t scale = gf::divide(discrepancy, prev_discrepancy);
+                std::array<gf_t, MaxParity + 1u> temp = locator;
+                for (std::size_t i = 0u; i + shift <= parity; i++) {
+                    locator[i + shift] ^= gf::multiply(scale, prev[i]);
+                }
+
+                if (2u * degree <= n + erasures.count) {
+                    degree = n + 1u + erasures.count - degree;
+                    prev = temp;
+                    prev_discrepancy = discrepancy;
+                    shift = 1u;
+                } else {
+                    shift++;
+                }
+            }
+
+            return degree;
+        }
+
+        /*
+        Find the roots of the error locator polynomial over the 'len'
+        positions of a (possibly shortened) codeword, writing the exponent
+        of each error location into 'locations'. Returns the number of
+        roots found.
+        */
+        static std::size_t chien_search(const std::array<gf_t, MaxParity + 1u> &locator, std::size_t degree,
+                std::size_t len, std::array<std::size_t, MaxParity> &locations) {
+            /*
+            Track each non-zero term, stepping by alpha^-k per position. With
+            log tables the terms are held as exponents, otherwise as
+            elements which are multiplied by alpha^-k.
+            */
+            std::array<power_t, MaxParity + 1u> terms = {};
+            std::array<gf_t, MaxParity + 1u> steps = {};
+            for (std::size_t k = 1u; k <= degree; k++) {
+                if constexpr (log_tables) {
+                    terms[k] = locator[k] ? gf::log(locator[k]) : 0u;
+                } else {
+                    terms[k] = locator[k];
+                    steps[k] = alpha_power(field_size() - k);
+                }
+            }
+
+            std::size_t count = 0u;
+            for (std::size_t p = 0u; p < len; p++) {
+                gf_t sum = locator[0u];
+                for (std::size_t k = 1u; k <= degree; k++) {
+                    if constexpr (log_tables) {
+                        if (locator[k]) {
+                            sum ^= gf::antilog(terms[k]);
+                            terms[k] += field_size() - k;
+                            terms[k] -= (terms[k] >= field_size()) ? field_size() : 0u;
+                        }
+                    } else {
+                        sum ^= terms[k];
+                        terms[k] = gf::multiply(terms[k], steps[k]);
+                    }
+                }
+
+                if (!sum) {
+                    if (count == degree) {
+                        return count + 1u;
+                    }
+
+                    locations[count++] = p;
+                }
+            }
+
+            return count;
+        }
+
+        /*
+        Correct a codeword of 'len' symbols in place, with symbol i at
+        in[i * stride]. Returns the number of errors and erasures corrected,
+        or -1 if the codeword could not be corrected, in which case it is
+        left unmodified, or 'len' is not a valid codeword length.
+        */
+        static std::ptrdiff_t decode(gf_t *in, std::size_t len, std::size_t stride, std::size_t parity,
+                const gf_t *root_multiply, const erasure_locator_t &erasures) {
+            if (len < parity || len > field_size()) {
+                return -1;
+            }
+
+            std::array<gf_t, MaxParity> syndromes;
+            if (!calculate_syndromes(in, len, stride, parity, root_multiply, syndromes.data())) {
+                return 0;
+            }
+
+            std::array<gf_t, MaxParity + 1u> locator;
+            std::size_t degree = berlekamp_massey(syndromes.data(), parity, erasures, locator);
+            if (2u * degree > parity + erasures.count) {
+                return -1;
+            }
+
+            /*
+            If Berlekamp-Massey found no errors beyond the erasures, the
+            errata locations are already known and the Chien search can be
+            skipped.
+            */
+            std::array<std::size_t, MaxParity> locations;
+            if (degree == erasures.count) {
+                locations = erasures.locations;
+            } else if (chien_search(locator, degree, len, locations) != degree) {
+                return -1;
+            }
+
+            /* Error evaluator polynomial, omega(x) = S(x) * locator(x) mod x^parity. */
+            std::array<gf_t, MaxParity> evaluator = {};
+            for (std::size_t i = 0u; i < parity; i++) {
+                for (std::size_t j = 0u; j <= std::min(i, degree); j++) {
+                    evaluator[i] ^= gf::multiply(locator[j], syndromes[i - j]);
+                }
+            }
+
+            /* Formal derivative of the errata locator, which keeps only the odd-order terms. */
+            std::array<gf_t, MaxParity + 1u> derivative = {};
+            for (std::size_t k = 1u; k <= degree; k += 2u) {
+                derivative[k - 1u] = locator[k];
+            }
+
+            /* Forney algorithm, for X = alpha^p and evaluation at X^-1, with first root alpha^1. */
+            for (std::size_t i = 0u; i < degree; i++) {
+                std::size_t p = locations[i];
+                power_t x = alpha_power((field_size() - p % field_size()) % field_size());
+                in[(len - 1u - p) * stride] ^= gf::divide(evaluate(evaluator.data(), parity - 1u, x),
+                    evaluate(derivative.data(), degree, x));
+            }
+
+            return (std::ptrdiff_t)degree;
+        }
+    };
 }
 
 namespace ReedSolomon {
@@ -84,17 +495,189 @@ namespace ReedSolomon {
 namespace Polynomials {
     using m_8_285 = BinarySequence<1, 0, 0, 0, 1, 1, 1, 0, 1>;
     using m_8_301 = BinarySequence<1, 0, 0, 1, 0, 1, 1, 0, 1>;
+
+    /* x^16 + x^12 + x^3 + x + 1, for codewords of up to 65535 16-bit symbols. */
+    using m_16_69643 = BinarySequence<1, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0, 1, 1>;
 }
 
-template <std::size_t M, typename Primitive, std::size_t Parity>
+/*
+Reed-Solomon encoder with Parity parity symbols per codeword. The
+generator polynomial and the encoder tables are built at compile time
+with the table field. Backend selects the field arithmetic used at run
+time, when the parity is updated for changed message symbols.
+*/
+template <std::size_t M, typename Primitive, std::size_t Parity,
+    typename Backend = GaloisFieldBackends::Tables>
 class ReedSolomonEncoder {
     static_assert(Parity < (1u << M) - 1u, "Parity must be smaller than the field size");
 
-    using gf = GaloisField<M, Primitive>;
+    using gf = GaloisField<M, Primitive, Backend>;
+    using table_gf = GaloisField<M, Primitive>;
     using gf_t = typename gf::gf_t;
 
 public:
-    using generator = typename Detail::generator_polynomial<gf, Parity>::coefficients;
+    using generator = typename Detail::generator_polynomial<table_gf, Parity>::coefficients;
+
+    /* Number of parity symbols per codeword. */
+    static constexpr std::size_t parity_length() { return Parity; }
+
+private:
+    /*
+    The shift register is packed into 64-bit words, with parity symbol j
+    in symbol lane j of the words, so a step of the encoder is a shift by
+    one symbol and a table row XOR per word.
+    */
+    static constexpr std::size_t symbol_bits() { return 8u * sizeof(gf_t); }
+    static constexpr std::size_t symbols_per_word() { return 64u / symbol_bits(); }
+    static constexpr std::size_t num_words() { return (Parity + symbols_per_word() - 1u) / symbols_per_word(); }
+
+    using register_t = std::array<uint64_t, num_words()>;
+
+    /*
+    Row f of this table is the feedback symbol (f << shift) multiplied by
+    each generator coefficient, in the packed register layout. For fields
+    of more than 2^8 elements, the feedback is split into its low and high
+    bytes, each with its own table, rather than having a row for every
+    element. Each table takes Rows * 8 * num_words() bytes.
+    */
+    template <std::size_t Rows>
+    static constexpr std::array<register_t, Rows> get_feedback_table(std::size_t shift) {
+        constexpr std::array<gf_t, Parity> g = Detail::feedback_coefficients(generator{});
+        std::array<register_t, Rows> table = {};
+
+        for (std::size_t f = 0u; f < Rows; f++) {
+            for (std::size_t j = 0u; j < Parity; j++) {
+                table[f][j / symbols_per_word()] |= (uint64_t)table_gf::multiply(f << shift, g[j]) <<
+                    (symbol_bits() * (j % symbols_per_word()));
+            }
+        }
+
+        return table;
+    }
+
+    static constexpr std::size_t low_rows() { return (M <= 8u) ? (1u << M) : 256u; }
+    static constexpr std::size_t high_rows() { return (M <= 8u) ? 1u : (1u << (M - 8u)); }
+
+    static constexpr std::size_t max_message_length() { return (1u << M) - 1u - Parity; }
+
+    /*
+    Parity of the message x^k, that is x^(Parity + k) mod g(x), given the
+    parity of x^(k - 1). This is one step of the shift register with no
+    input. GF is the field to do it in, which is the table field at compile
+    time.
+    */
+    template <typename GF>
+    static constexpr std::array<gf_t, Parity> next_position_row(const std::array<gf_t, Parity> &row) {
+        constexpr std::array<gf_t, Parity> g = Detail::feedback_coefficients(generator{});
+        std::array<gf_t, Parity> next = {};
+
+        for (std::size_t j = 0u; j < Parity; j++) {
+            next[j] = ((j + 1u < Parity) ? row[j + 1u] : 0u) ^ GF::multiply(row[0u], g[j]);
+        }
+
+        return next;
+    }
+
+    /* Product of two remainders modulo g(x), highest order coefficient first. */
+    static std::array<gf_t, Parity> multiply_modulo_generator(const std::array<gf_t, Parity> &x,
+            const std::array<gf_t, Parity> &y) {
+        return gf::remainder(gf::multiply(x, y), Detail::generator_coefficients(generator{}));
+    }
+
+    /*
+    Parity of the message x^k directly, as x^Parity * x^k mod g(x). The
+    remainders x^(2^i) mod g(x) are built once on first use, so a row costs
+    one multiplication modulo g(x) per set bit of k, that is O(Parity^2 M)
+    operations rather than the O(Parity k) of stepping next_position_row.
+    */
+    static std::array<gf_t, Parity> get_position_row(std::size_t k) {
+        static const std::array<std::array<gf_t, Parity>, M> powers = [] {
+            std::array<std::array<gf_t, Parity>, M> p = {};
+
+            /* x mod g(x), which is just x unless g(x) has degree one. */
+            std::array<gf_t, Parity + 1u> x = {};
+            x[Parity - 1u] = 1u;
+            p[0u] = gf::remainder(x, Detail::generator_coefficients(generator{}));
+
+            for (std::size_t i = 1u; i < M; i++) {
+                p[i] = multiply_modulo_generator(p[i - 1u], p[i - 1u]);
+            }
+
+            return p;
+        }();
+
+        std::array<gf_t, Parity> row = Detail::feedback_coefficients(generator{});
+        for (std::size_t i = 0u; k; i++, k >>= 1u) {
+            if (k & 1u) {
+                row = multiply_modulo_generator(row, powers[i]);
+            }
+        }
+
+        return row;
+    }
+
+    /*
+    Row k of this table is the parity of a message whose only non-zero
+    symbol is a one, k symbols before the end of the message. It is only
+    used for fields of up to 2^8 elements.
+    */
+    static constexpr std::array<std::array<gf_t, Parity>, max_message_length()> get_position_table() {
+        std::array<std::array<gf_t, Parity>, max_message_length()> table = {};
+        table[0u] = Detail::feedback_coefficients(generator{});
+
+        for (std::size_t k = 1u; k < table.size(); k++) {
+            table[k] = next_position_row<table_gf>(table[k - 1u]);
+        }
+
+        return table;
+    }
+
+public:
+    /*
+    Calculate Parity symbols for 'len' message symbols from 'in', writing
+    them to 'parity'. The message is divided by the generator polynomial in
+    a linear feedback shift register holding just the parity symbols, so
+    the message is read once and never copied.
+    */
+    static void encode(const gf_t *in, std::size_t len, gf_t *parity) {
+        encode_strided(in, len, 1u, parity, 1u);
+    }
+
+    /*
+    As above, but with message symbol i at in[i * stride] and parity
+    symbol j written to parity[j * parity_stride], for codewords that are
+    interleaved with others.
+    */
+    static void encode_strided(const gf_t *in, std::size_t len, std::size_t stride, gf_t *parity,
+            std::size_t parity_stride) {
+        static constexpr std::array<register_t, low_rows()> feedback_table = get_feedback_table<low_rows()>(0u);
+        static constexpr std::array<register_t, high_rows()> feedback_table_high =
+            get_feedback_table<high_rows()>(8u);
+        constexpr uint64_t symbol_mask = ((uint64_t)1u << symbol_bits()) - 1u;
+        register_t r = {};
+
+        for (std::size_t i = 0u; i < len; i++) {
+            gf_t f = in[i * stride] ^ (gf_t)(r[0u] & symbol_mask);
+            const register_t &row = feedback_table[f & 0xffu];
+            const register_t &row_high = feedback_table_high[(M <= 8u) ? 0u : (f >> 8u)];
+
+            for (std::size_t k = 0u; k < num_words() - 1u; k++) {
+                r[k] = ((r[k] >> symbol_bits()) | (r[k + 1u] << (64u - symbol_bits()))) ^ row[k];
+                if constexpr (M > 8u) {
+                    r[k] ^= row_high[k];
+                }
+            }
+
+            r[num_words() - 1u] = (r[num_words() - 1u] >> symbol_bits()) ^ row[num_words() - 1u];
+            if constexpr (M > 8u) {
+                r[num_words() - 1u] ^= row_high[num_words() - 1u];
+            }
+        }
+
+        for (std::size_t j = 0u; j < Parity; j++) {
+            parity[j * parity_stride] = r[j / symbols_per_word()] >> (symbol_bits() * (j % symbols_per_word()));
+        }
+    }
 
     /*
     Calculate parity for up to (2^M - Parity - 1) message bytes from 'input',
@@ -104,9 +687,606 @@ public:
     static void encode(std::array<gf_t, Len + Parity> &in) {
         static_assert(Len <= (1u << M) - 1u - Parity,
             "Data length must be smaller than or equal to block size minus parity length");
-        std::array<gf_t, Parity> parity = gf::remainder(in, generator{},
-            std::make_index_sequence<Parity>{});
-        std::copy_n(parity.data(), Parity, in.begin() + Len);
+        encode(in.data(), Len, &in[Len]);
+    }
+
+    /*
+    Change 'count' message symbols, starting at 'offset', of a codeword
+    with 'len' message symbols followed by its parity, from 'old_values'
+    to 'new_values'. The code is linear, so the parity changes by the
+    parity of the difference between the messages, which is the sum of
+    the position rows of the changed symbols scaled by their differences.
+    Each changed symbol costs one region multiply-add over the parity
+    rather than a pass over the whole message.
+
+    For fields of up to 2^8 elements the position rows are precomputed.
+    Otherwise the row of the last changed symbol is calculated directly,
+    and the rows of the rest of the range are stepped from it, so a range
+    costs O(Parity^2 log len + Parity * count) wherever it is.
+    */
+    static void update(gf_t *codeword, std::size_t len, std::size_t offset,
+            const gf_t *old_values, const gf_t *new_values, std::size_t count) {
+        gf_t *parity = &codeword[len];
+
+        if constexpr (M <= 8u) {
+            static constexpr std::array<std::array<gf_t, Parity>, max_message_length()> position_table =
+                get_position_table();
+
+            for (std::size_t t = 0u; t < count; t++) {
+                gf::mul_add_region(parity, position_table[len - 1u - offset - t].data(),
+                    old_values[t] ^ new_values[t], Parity);
+                codeword[offset + t] = new_values[t];
+            }
+        } else {
+            /* Row for the last symbol of the range, then step backwards through the range. */
+            std::array<gf_t, Parity> row = get_position_row(len - offset - count);
+
+            for (std::size_t t = count; t-- > 0u;) {
+                gf::mul_add_region(parity, row.data(), old_values[t] ^ new_values[t], Parity);
+                codeword[offset + t] = new_values[t];
+                row = next_position_row<gf>(row);
+            }
+        }
+    }
+
+    static void update(gf_t *codeword, std::size_t len, std::size_t offset, gf_t old_value, gf_t new_value) {
+        update(codeword, len, offset, &old_value, &new_value, 1u);
+    }
+
+    template <std::size_t Len>
+    static void update(std::array<gf_t, Len + Parity> &codeword, std::size_t offset, gf_t old_value,
+            gf_t new_value) {
+        update(codeword.data(), Len, offset, &old_value, &new_value, 1u);
+    }
+};
+
+/*
+Reed-Solomon decoder for codewords produced by ReedSolomonEncoder, which
+uses the generator roots alpha^1 to alpha^Parity. The syndromes are
+calculated first, and if they are all zero the codeword is accepted
+without further work. Otherwise Berlekamp-Massey finds the error locator
+polynomial, a Chien search finds its roots, and the Forney algorithm
+calculates the error values. All working storage is on the stack.
+
+Backend selects the field arithmetic. With the carry-less backend there
+are no log, antilog or root multiplication tables, at the cost of a
+carry-less multiply per symbol for each syndrome.
+*/
+template <std::size_t M, typename Primitive, std::size_t Parity,
+    typename Backend = GaloisFieldBackends::Tables>
+class ReedSolomonDecoder {
+    static_assert(Parity > 0u, "Parity must be larger than zero");
+    static_assert(Parity < (1u << M) - 1u, "Parity must be smaller than the field size");
+
+    using gf = GaloisField<M, Primitive, Backend>;
+    using table_gf = GaloisField<M, Primitive>;
+    using gf_t = typename gf::gf_t;
+    using impl = Detail::ReedSolomonDecoderImpl<M, Primitive, Parity, Backend>;
+
+    static constexpr std::size_t field_size() { return (1u << M) - 1u; }
+
+    /*
+    Tables of multiplication by each generator root, for small fields with
+    the table backend.
+    */
+    static constexpr std::size_t root_multiply_size() {
+        return (M <= 8u && impl::log_tables) ? Parity * (1u << M) : 1u;
+    }
+
+    static constexpr std::array<gf_t, root_multiply_size()> get_root_multiply_table() {
+        std::array<gf_t, root_multiply_size()> table = {};
+
+        if constexpr (root_multiply_size() > 1u) {
+            for (std::size_t j = 0u; j < Parity; j++) {
+                for (std::size_t x = 1u; x < (1u << M); x++) {
+                    table[j * (1u << M) + x] = table_gf::antilog(table_gf::log(x) + 1u + j);
+                }
+            }
+        }
+
+        return table;
+    }
+
+    static constexpr std::array<gf_t, root_multiply_size()> root_multiply_table = get_root_multiply_table();
+
+public:
+    /*
+    Erasure locator polynomial and erasure positions, which can be reused
+    for codewords sharing the same erasures.
+    */
+    using ErasureLocator = typename impl::erasure_locator_t;
+
+    /*
+    Calculate the erasure locator for 'count' erased symbols of a codeword
+    of 'len' symbols, given as indices into the codeword. Returns false if
+    there are more erasures than parity symbols or an index is out of range.
+    */
+    static bool calculate_erasure_locator(const std::size_t *erasures, std::size_t count, std::size_t len,
+            ErasureLocator &locator) {
+        return impl::calculate_erasure_locator(erasures, count, len, Parity, locator);
+    }
+
+    /*
+    Calculate the syndromes of a codeword of 'len' symbols. Returns true if
+    any syndrome is non-zero.
+    */
+    static bool calculate_syndromes(const gf_t *in, std::size_t len, std::array<gf_t, Parity> &syndromes) {
+        return impl::calculate_syndromes(in, len, 1u, Parity, root_multiply_table.data(), syndromes.data());
+    }
+
+    /*
+    Check a codeword of 'len' symbols, including parity, without correcting
+    it. A valid codeword has all-zero syndromes, which is the usual case,
+    and this is the whole of the cost of decoding one.
+    */
+    static bool is_valid_codeword(const gf_t *in, std::size_t len) {
+        if (len < Parity || len > field_size()) {
+            return false;
+        }
+
+        std::array<gf_t, Parity> syndromes;
+        return !calculate_syndromes(in, len, syndromes);
+    }
+
+    /*
+    Correct a codeword of 'len' symbols in place, where 'len' includes the
+    parity symbols and may be less than 2^M - 1 for a shortened code. Up to
+    e errors and s erasures can be corrected, provided 2e + s <= Parity.
+    Returns the number of errors and erasures corrected, or -1 if the
+    codeword could not be corrected, in which case it is left unmodified, or
+    'len' is not a valid codeword length.
+    */
+    static std::ptrdiff_t decode(gf_t *in, std::size_t len, const ErasureLocator &erasures) {
+        return decode_strided(in, len, 1u, erasures);
+    }
+
+    /*
+    As above, but with symbol i at in[i * stride], so that a codeword
+    interleaved with others can be corrected where it is.
+    */
+    static std::ptrdiff_t decode_strided(gf_t *in, std::size_t len, std::size_t stride,
+            const ErasureLocator &erasures) {
+        return impl::decode(in, len, stride, Parity, root_multiply_table.data(), erasures);
+    }
+
+    static std::ptrdiff_t decode(gf_t *in, std::size_t len) {
+        return decode(in, len, ErasureLocator{});
+    }
+
+    static std::ptrdiff_t decode_strided(gf_t *in, std::size_t len, std::size_t stride) {
+        return decode_strided(in, len, stride, ErasureLocator{});
+    }
+
+    /* Correct a codeword with 'count' erased symbols at the given indices. */
+    static std::ptrdiff_t decode(gf_t *in, std::size_t len, const std::size_t *erasures, std::size_t count) {
+        ErasureLocator locator;
+        if (!calculate_erasure_locator(erasures, count, len, locator)) {
+            return -1;
+        }
+
+        return decode(in, len, locator);
+    }
+
+    template <std::size_t Len>
+    static std::ptrdiff_t decode(std::array<gf_t, Len + Parity> &in) {
+        static_assert(Len <= (1u << M) - 1u - Parity,
+            "Data length must be smaller than or equal to block size minus parity length");
+        return decode(in.data(), Len + Parity);
+    }
+
+    template <std::size_t Len>
+    static std::ptrdiff_t decode(std::array<gf_t, Len + Parity> &in, const std::size_t *erasures,
+            std::size_t count) {
+        static_assert(Len <= (1u << M) - 1u - Parity,
+            "Data length must be smaller than or equal to block size minus parity length");
+        return decode(in.data(), Len + Parity, erasures, count);
+    }
+};
+
+/*
+Reed-Solomon encoder and decoder with the number of parity symbols chosen
+at run time, for protocols which negotiate it per session. The generator
+polynomial and the tables derived from it depend only on the field and
+the number of parity symbols, so they are built once for each parity
+length and shared by every codec using it. Codewords may be shortened to
+any length, and working storage is sized for up to MaxParity parity
+symbols so that it stays on the stack.
+
+The codewords are the same as those of ReedSolomonEncoder and
+ReedSolomonDecoder with the same parameters.
+*/
+template <std::size_t M, typename Primitive, std::size_t MaxParity = 64u>
+class ReedSolomonCodec {
+    static_assert(MaxParity > 0u, "Maximum parity must be larger than zero");
+    static_assert(MaxParity < (1u << M) - 1u, "Maximum parity must be smaller than the field size");
+
+    using gf = GaloisField<M, Primitive>;
+    using gf_t = typename gf::gf_t;
+    using impl = Detail::ReedSolomonDecoderImpl<M, Primitive, MaxParity>;
+
+    static constexpr std::size_t field_size() { return (1u << M) - 1u; }
+
+    /* Packed shift register layout, as in ReedSolomonEncoder. */
+    static constexpr std::size_t symbol_bits() { return 8u * sizeof(gf_t); }
+    static constexpr std::size_t symbols_per_word() { return 64u / symbol_bits(); }
+    static constexpr std::size_t max_words() { return (MaxParity + symbols_per_word() - 1u) / symbols_per_word(); }
+    static constexpr std::size_t low_rows() { return (M <= 8u) ? (1u << M) : 256u; }
+    static constexpr std::size_t high_rows() { return (M <= 8u) ? 0u : (1u << (M - 8u)); }
+
+public:
+    /* Tables which depend only on the number of parity symbols. */
+    struct Tables {
+        std::size_t parity = 0u;
+
+        /* Generator coefficients below the leading (unity) term, highest order first. */
+        std::vector<gf_t> generator;
+
+        /*
+        Row f of the feedback table is the feedback symbol f multiplied by
+        each generator coefficient, packed into 64-bit words as in
+        ReedSolomonEncoder. For fields of more than 2^8 elements, the rows
+        for the low byte of the feedback are followed by the rows for the
+        high byte. For fields of up to 2^8 elements, row j of the root
+        table multiplies by the generator root alpha^(j + 1).
+        */
+        std::vector<uint64_t> feedback;
+        std::vector<gf_t> root_multiply;
+    };
+
+    /*
+    Get the tables for 'parity' parity symbols, building them on first use.
+    Returns null if 'parity' is zero or larger than MaxParity.
+    */
+    static std::shared_ptr<const Tables> get_tables(std::size_t parity) {
+        if (!parity || parity > MaxParity) {
+            return nullptr;
+        }
+
+        static std::mutex mutex;
+        static std::map<std::size_t, std::shared_ptr<const Tables>> cache;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::shared_ptr<const Tables> &entry = cache[parity];
+        if (!entry) {
+            entry = build_tables(parity);
+        }
+
+        return entry;
+    }
+
+private:
+    static std::shared_ptr<const Tables> build_tables(std::size_t parity) {
+        auto t = std::make_shared<Tables>();
+        t->parity = parity;
+
+        /* Multiply out (x + alpha^1)...(x + alpha^parity), highest order first. */
+        std::vector<gf_t> g(parity + 1u, 0u);
+        g[0u] = 1u;
+        for (std::size_t n = 1u; n <= parity; n++) {
+            for (std::size_t i = n; i > 0u; i--) {
+                g[i] ^= gf::multiply(g[i - 1u], gf::antilog(n));
+            }
+        }
+
+        t->generator.assign(g.begin() + 1, g.end());
+
+        std::size_t words = (parity + symbols_per_word() - 1u) / symbols_per_word();
+        t->feedback.assign((low_rows() + high_rows()) * words, 0u);
+        for (std::size_t row = 0u; row < low_rows() + high_rows(); row++) {
+            gf_t f = (row < low_rows()) ? row : ((row - low_rows()) << 8u);
+            for (std::size_t j = 0u; j < parity; j++) {
+                t->feedback[row * words + j / symbols_per_word()] |=
+                    (uint64_t)gf::multiply(f, t->generator[j]) << (symbol_bits() * (j % symbols_per_word()));
+            }
+        }
+
+        if constexpr (M <= 8u) {
+            t->root_multiply.assign(parity * (1u << M), 0u);
+            for (std::size_t j = 0u; j < parity; j++) {
+                for (std::size_t x = 1u; x < (1u << M); x++) {
+                    t->root_multiply[j * (1u << M) + x] = gf::antilog(gf::log(x) + 1u + j);
+                }
+            }
+        }
+
+        return t;
+    }
+
+    /*
+    Shift register kernels for each packed register width, so that the
+    per-symbol loop is the same as in ReedSolomonEncoder.
+    */
+    using encode_kernel_t = void (*)(const Tables &, const gf_t *, std::size_t, gf_t *);
+
+    template <std::size_t Words>
+    static void encode_packed(const Tables &t, const gf_t *in, std::size_t len, gf_t *parity) {
+        const uint64_t *feedback_table = t.feedback.data();
+        const uint64_t *feedback_table_high = &feedback_table[low_rows() * Words];
+        constexpr uint64_t symbol_mask = ((uint64_t)1u << symbol_bits()) - 1u;
+        std::array<uint64_t, Words> r = {};
+
+        for (std::size_t i = 0u; i < len; i++) {
+            gf_t f = in[i] ^ (gf_t)(r[0u] & symbol_mask);
+            const uint64_t *row = &feedback_table[(f & 0xffu) * Words];
+            const uint64_t *row_high = &feedback_table_high[((M <= 8u) ? 0u : (f >> 8u)) * Words];
+
+            for (std::size_t k = 0u; k < Words - 1u; k++) {
+                r[k] = ((r[k] >> symbol_bits()) | (r[k + 1u] << (64u - symbol_bits()))) ^ row[k];
+                if constexpr (M > 8u) {
+                    r[k] ^= row_high[k];
+                }
+            }
+
+            r[Words - 1u] = (r[Words - 1u] >> symbol_bits()) ^ row[Words - 1u];
+            if constexpr (M > 8u) {
+                r[Words - 1u] ^= row_high[Words - 1u];
+            }
+        }
+
+        for (std::size_t j = 0u; j < t.parity; j++) {
+            parity[j] = r[j / symbols_per_word()] >> (symbol_bits() * (j % symbols_per_word()));
+        }
+    }
+
+    template <std::size_t... Ws>
+    static constexpr std::array<encode_kernel_t, sizeof...(Ws)> get_encode_kernels(std::index_sequence<Ws...>) {
+        return std::array<encode_kernel_t, sizeof...(Ws)>{ &encode_packed<Ws + 1u>... };
+    }
+
+    static encode_kernel_t select_encode_kernel(std::size_t parity) {
+        static constexpr std::array<encode_kernel_t, max_words()> kernels =
+            get_encode_kernels(std::make_index_sequence<max_words()>{});
+        return kernels[(parity + symbols_per_word() - 1u) / symbols_per_word() - 1u];
+    }
+
+    std::shared_ptr<const Tables> tables;
+    encode_kernel_t encode_kernel = nullptr;
+
+public:
+    /*
+    Erasure locator polynomial and erasure positions, as for
+    ReedSolomonDecoder, which can be reused for codewords sharing the same
+    erasures.
+    */
+    using ErasureLocator = typename impl::erasure_locator_t;
+
+    /*
+    Create a codec with 'parity' parity symbols per codeword. If 'parity'
+    is zero or larger than MaxParity the codec is not valid, and every
+    operation on it fails.
+    */
+    explicit ReedSolomonCodec(std::size_t parity) : tables(get_tables(parity)) {
+        if (tables) {
+            encode_kernel = select_encode_kernel(parity);
+        }
+    }
+
+    bool valid() const { return tables != nullptr; }
+
+    std::size_t parity_length() const { return tables ? tables->parity : 0u; }
+
+    /* Longest message which can be encoded, for a full-length codeword. */
+    std::size_t max_message_length() const { return tables ? field_size() - tables->parity : 0u; }
+
+    /*
+    Calculate the parity symbols for 'len' message symbols from 'in',
+    writing them to 'parity'. Returns false if the message is too long for
+    the field or the codec is not valid.
+    */
+    bool encode(const gf_t *in, std::size_t len, gf_t *parity) const {
+        if (!tables || len > max_message_length()) {
+            return false;
+        }
+
+        encode_kernel(*tables, in, len, parity);
+        return true;
+    }
+
+    /* Encode a codeword in place, with the parity following the 'len' message symbols. */
+    bool encode(gf_t *codeword, std::size_t len) const {
+        return encode(codeword, len, &codeword[len]);
+    }
+
+    /*
+    Calculate the erasure locator for 'count' erased symbols of a codeword
+    of 'len' symbols, given as indices into the codeword. Returns false if
+    there are more erasures than parity symbols or an index is out of range.
+    */
+    bool calculate_erasure_locator(const std::size_t *erasures, std::size_t count, std::size_t len,
+            ErasureLocator &locator) const {
+        if (!tables) {
+            locator = ErasureLocator{};
+            return false;
+        }
+
+        return impl::calculate_erasure_locator(erasures, count, len, tables->parity, locator);
+    }
+
+    /*
+    Calculate the syndromes of a codeword of 'len' symbols into the first
+    parity_length() entries of 'syndromes'. Returns true if any syndrome
+    is non-zero, and false with all syndromes zero if 'len' is not a valid
+    codeword length or the codec is not valid.
+    */
+    bool calculate_syndromes(const gf_t *in, std::size_t len, std::array<gf_t, MaxParity> &syndromes) const {
+        syndromes = {};
+        if (!tables || len < tables->parity || len > field_size()) {
+            return false;
+        }
+
+        return impl::calculate_syndromes(in, len, 1u, tables->parity, tables->root_multiply.data(),
+            syndromes.data());
+    }
+
+    /* Check a codeword of 'len' symbols, including parity, without correcting it. */
+    bool is_valid_codeword(const gf_t *in, std::size_t len) const {
+        if (!tables || len < tables->parity || len > field_size()) {
+            return false;
+        }
+
+        std::array<gf_t, MaxParity> syndromes;
+        return !calculate_syndromes(in, len, syndromes);
+    }
+
+    /*
+    Correct a codeword of 'len' symbols in place, where 'len' includes the
+    parity symbols. Up to e errors and s erasures can be corrected,
+    provided 2e + s <= parity_length(). Returns the number of errors and
+    erasures corrected, or -1 if the codeword could not be corrected (in
+    which case it is left unmodified) or the codec is not valid.
+    */
+    std::ptrdiff_t decode(gf_t *in, std::size_t len, const ErasureLocator &erasures) const {
+        if (!tables) {
+            return -1;
+        }
+
+        return impl::decode(in, len, 1u, tables->parity, tables->root_multiply.data(), erasures);
+    }
+
+    std::ptrdiff_t decode(gf_t *in, std::size_t len) const {
+        return decode(in, len, ErasureLocator{});
+    }
+
+    /* Correct a codeword with 'count' erased symbols at the given indices. */
+    std::ptrdiff_t decode(gf_t *in, std::size_t len, const std::size_t *erasures, std::size_t count) const {
+        ErasureLocator locator;
+        if (!calculate_erasure_locator(erasures, count, len, locator)) {
+            return -1;
+        }
+
+        return decode(in, len, locator);
+    }
+};
+
+/*
+Reed-Solomon encoder for Depth codewords interleaved symbol by symbol, as
+with the CCSDS interleave depth I. A frame holds message symbol i of
+codeword l at position i * Depth + l, followed by the parity symbols
+interleaved in the same way, so a frame with 'len' message symbols per
+codeword is (len + Parity) * Depth symbols long, and is encoded in place
+with no de-interleaving copy.
+
+With USE_SIMD_X86 and fields of up to 2^8 elements, the shift registers of
+a group of codewords are held in the byte lanes of a set of vectors, and
+each step multiplies the feedback of the whole group by each generator
+coefficient. Where the CPU has GFNI and AVX2, a group is 32 codewords
+and each multiply is a single GF2P8AFFINEQB. Otherwise a group is 16
+codewords and each multiply is a pair of PSHUFB split-table lookups.
+Codewords left over after the groups use the scalar shift register.
+*/
+template <std::size_t M, typename Primitive, std::size_t Parity, std::size_t Depth>
+class InterleavedReedSolomonEncoder {
+    static_assert(Parity > 0u, "Parity must be larger than zero");
+    static_assert(Depth >= 1u && Depth <= 32u, "Interleave depth must be between 1 and 32");
+
+    using gf = GaloisField<M, Primitive>;
+    using gf_t = typename gf::gf_t;
+    using Encoder = ReedSolomonEncoder<M, Primitive, Parity>;
+
+    static const std::array<Detail::split_table_t<gf_t>, Parity> &feedback_tables() {
+        static const std::array<Detail::split_table_t<gf_t>, Parity> tables = [] {
+            constexpr std::array<gf_t, Parity> g = Detail::feedback_coefficients(typename Encoder::generator{});
+            std::array<Detail::split_table_t<gf_t>, Parity> t;
+            for (std::size_t j = 0u; j < Parity; j++) {
+                t[j] = gf::split_table(g[j]);
+            }
+
+            return t;
+        }();
+
+        return tables;
+    }
+
+public:
+    /*
+    Encode a frame with 'len' message symbols per codeword. Returns false,
+    leaving the frame unmodified, if the codewords would be longer than
+    the field allows.
+    */
+    static bool encode(gf_t *frame, std::size_t len) {
+        if (len > (1u << M) - 1u - Parity) {
+            return false;
+        }
+
+        Detail::interleaved_encode_op_container<Encoder, gf_t, Depth, Parity>::op(frame, len, feedback_tables());
+        return true;
+    }
+
+    template <std::size_t Len>
+    static void encode(std::array<gf_t, (Len + Parity) * Depth> &frame) {
+        static_assert(Len <= (1u << M) - 1u - Parity,
+            "Data length must be smaller than or equal to block size minus parity length");
+        encode(frame.data(), Len);
+    }
+};
+
+/*
+Decoder for frames produced by InterleavedReedSolomonEncoder. The
+syndromes of all of the codewords are checked together in the
+interleaved layout (in SIMD when available), and only codewords which
+may contain errors are corrected, in place in the frame, by
+ReedSolomonDecoder through their stride.
+*/
+template <std::size_t M, typename Primitive, std::size_t Parity, std::size_t Depth>
+class InterleavedReedSolomonDecoder {
+    static_assert(Parity > 0u, "Parity must be larger than zero");
+    static_assert(Depth >= 1u && Depth <= 32u, "Interleave depth must be between 1 and 32");
+
+    using gf = GaloisField<M, Primitive>;
+    using gf_t = typename gf::gf_t;
+    using Decoder = ReedSolomonDecoder<M, Primitive, Parity>;
+
+    static const std::array<Detail::split_table_t<gf_t>, Parity> &root_tables() {
+        static const std::array<Detail::split_table_t<gf_t>, Parity> tables = [] {
+            std::array<Detail::split_table_t<gf_t>, Parity> t;
+            for (std::size_t j = 0u; j < Parity; j++) {
+                t[j] = gf::split_table(gf::antilog(j + 1u));
+            }
+
+            return t;
+        }();
+
+        return tables;
+    }
+
+public:
+    /*
+    Correct a frame of codewords of 'len' symbols each, including parity,
+    in place. Returns the total number of symbols corrected, or -1 if any
+    codeword could not be corrected, in which case the others are still
+    corrected, or if 'len' is not a valid codeword length. Codewords that
+    may contain errors are corrected where they are, through their stride
+    in the frame.
+    */
+    static std::ptrdiff_t decode(gf_t *frame, std::size_t len) {
+        if (len < Parity || len > (1u << M) - 1u) {
+            return -1;
+        }
+
+        uint64_t suspects = Detail::interleaved_syndrome_op_container<gf_t, Depth, Parity>::op(
+            frame, len, root_tables());
+
+        std::ptrdiff_t total = 0;
+        bool failed = false;
+        for (std::size_t l = 0u; l < Depth; l++) {
+            if (!((suspects >> l) & 1u)) {
+                continue;
+            }
+
+            std::ptrdiff_t corrected = Decoder::decode_strided(&frame[l], len, Depth);
+            if (corrected < 0) {
+                failed = true;
+            } else {
+                total += corrected;
+            }
+        }
+
+        return failed ? -1 : total;
+    }
+
+    template <std::size_t Len>
+    static std::ptrdiff_t decode(std::array<gf_t, (Len + Parity) * Depth> &frame) {
+        return decode(frame.data(), Len + Parity);
     }
 };
 
@@ -0,0 +1,534 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+
+
+#pragma once
+
+#include <x86intrin.h>
+
+/*
+Load or store the 'width' codewords of a lane group, which is narrower
+than a vector when the interleave depth is not a multiple of 16.
+*/
+static inline __m128i load_lanes(const uint8_t *in, std::size_t width) {
+    if (width == 16u) {
+        return _mm_loadu_si128((const __m128i *)in);
+    }
+
+    uint8_t temp[16u] = {};
+    std::copy_n(in, width, temp);
+    return _mm_loadu_si128((const __m128i *)temp);
+}
+
+static inline void store_lanes(uint8_t *out, __m128i x, std::size_t width) {
+    if (width == 16u) {
+        _mm_storeu_si128((__m128i *)out, x);
+        return;
+    }
+
+    uint8_t temp[16u];
+    _mm_storeu_si128((__m128i *)temp, x);
+    std::copy_n(temp, width, out);
+}
+
+template <std::size_t Parity>
+static inline void load_split_tables(const std::array<split_table_t<uint8_t>, Parity> &tables,
+        __m128i (&lo_tables)[Parity], __m128i (&hi_tables)[Parity]) {
+    for (std::size_t j = 0u; j < Parity; j++) {
+        lo_tables[j] = _mm_loadu_si128((const __m128i *)tables[j][0u].data());
+        hi_tables[j] = _mm_loadu_si128((const __m128i *)tables[j][1u].data());
+    }
+}
+
+/*
+With GFNI, a multiplication by a constant is a single GF2P8AFFINEQB, so
+the kernels use 256-bit vectors holding 32 codewords.
+*/
+template <std::size_t Parity>
+static inline void load_affine_matrices(const std::array<split_table_t<uint8_t>, Parity> &tables,
+        uint64_t (&matrices)[Parity]) {
+    for (std::size_t j = 0u; j < Parity; j++) {
+        matrices[j] = affine_matrix(tables[j]);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline __m256i load_lanes_avx2(const uint8_t *in, std::size_t width) {
+    if (width == 32u) {
+        return _mm256_loadu_si256((const __m256i *)in);
+    }
+
+    uint8_t temp[32u] = {};
+    std::copy_n(in, width, temp);
+    return _mm256_loadu_si256((const __m256i *)temp);
+}
+
+__attribute__((target("avx2")))
+static inline void store_lanes_avx2(uint8_t *out, __m256i x, std::size_t width) {
+    if (width == 32u) {
+        _mm256_storeu_si256((__m256i *)out, x);
+        return;
+    }
+
+    uint8_t temp[32u];
+    _mm256_storeu_si256((__m256i *)temp, x);
+    std::copy_n(temp, width, out);
+}
+
+/*
+Encoder kernels, which hold the shift registers of a group of codewords
+in the lanes of a set of vectors and multiply the feedback of all of them
+by each generator coefficient at each step.
+*/
+template <std::size_t Parity>
+__attribute__((target("avx2,gfni")))
+static inline void interleaved_encode_gfni(uint8_t *frame, std::size_t len, std::size_t depth,
+        std::size_t width, const uint64_t (&matrices)[Parity]) {
+    __m256i r[Parity + 1u];
+    for (std::size_t j = 0u; j <= Parity; j++) {
+        r[j] = _mm256_setzero_si256();
+    }
+
+    for (std::size_t i = 0u; i < len; i++) {
+        __m256i f = _mm256_xor_si256(load_lanes_avx2(&frame[i * depth], width), r[0u]);
+        for (std::size_t j = 0u; j < Parity; j++) {
+            r[j] = _mm256_xor_si256(r[j + 1u],
+                _mm256_gf2p8affine_epi64_epi8(f, _mm256_set1_epi64x((long long)matrices[j]), 0));
+        }
+    }
+
+    for (std::size_t j = 0u; j < Parity; j++) {
+        store_lanes_avx2(&frame[(len + j) * depth], r[j], width);
+    }
+}
+
+template <std::size_t Parity>
+static inline void interleaved_encode_ssse3(uint8_t *frame, std::size_t len, std::size_t depth,
+        std::size_t width, const __m128i (&lo_tables)[Parity], const __m128i (&hi_tables)[Parity]) {
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i r[Parity + 1u];
+    for (std::size_t j = 0u; j <= Parity; j++) {
+        r[j] = _mm_setzero_si128();
+    }
+
+    for (std::size_t i = 0u; i < len; i++) {
+        __m128i f = _mm_xor_si128(load_lanes(&frame[i * depth], width), r[0u]);
+        __m128i f_lo = _mm_and_si128(f, mask);
+        __m128i f_hi = _mm_and_si128(_mm_srli_epi64(f, 4), mask);
+        for (std::size_t j = 0u; j < Parity; j++) {
+            r[j] = _mm_xor_si128(r[j + 1u], _mm_xor_si128(
+                _mm_shuffle_epi8(lo_tables[j], f_lo), _mm_shuffle_epi8(hi_tables[j], f_hi)));
+        }
+    }
+
+    for (std::size_t j = 0u; j < Parity; j++) {
+        store_lanes(&frame[(len + j) * depth], r[j], width);
+    }
+}
+
+/*
+Groups narrower than these widths are faster with the scalar kernels,
+since the cost of a SIMD step is the same however many lanes are in use.
+*/
+static constexpr std::size_t interleaved_encode_min_width_ssse3() { return 10u; }
+static constexpr std::size_t interleaved_encode_min_width_gfni() { return 8u; }
+static constexpr std::size_t interleaved_syndrome_min_width() { return 2u; }
+
+template <typename Encoder, std::size_t Depth, std::size_t Parity>
+struct interleaved_encode_op_container<Encoder, uint8_t, Depth, Parity> {
+    static void op(uint8_t *frame, std::size_t len, const std::array<split_table_t<uint8_t>, Parity> &tables) {
+        std::size_t l = 0u;
+        if (cpu_supports_gfni()) {
+            uint64_t matrices[Parity];
+            load_affine_matrices(tables, matrices);
+            for (; l < Depth && Depth - l >= interleaved_encode_min_width_gfni(); l += 32u) {
+                interleaved_encode_gfni(&frame[l], len, Depth, std::min<std::size_t>(32u, Depth - l), matrices);
+            }
+        } else {
+            __m128i lo_tables[Parity], hi_tables[Parity];
+            load_split_tables(tables, lo_tables, hi_tables);
+            for (; l < Depth && Depth - l >= interleaved_encode_min_width_ssse3(); l += 16u) {
+                interleaved_encode_ssse3(&frame[l], len, Depth, std::min<std::size_t>(16u, Depth - l),
+                    lo_tables, hi_tables);
+            }
+        }
+
+        for (; l < Depth; l++) {
+            Encoder::encode_strided(&frame[l], len, Depth, &frame[len * Depth + l], Depth);
+        }
+    }
+};
+
+/*
+Syndrome kernels, which run Horner's rule for every root on a group of
+codewords and return a mask of the codewords with a non-zero syndrome.
+*/
+template <std::size_t Parity>
+__attribute__((target("avx2,gfni")))
+static inline uint64_t interleaved_syndromes_gfni(const uint8_t *frame, std::size_t len, std::size_t depth,
+        std::size_t width, const uint64_t (&matrices)[Parity]) {
+    __m256i s[Parity];
+    for (std::size_t j = 0u; j < Parity; j++) {
+        s[j] = _mm256_setzero_si256();
+    }
+
+    for (std::size_t i = 0u; i < len; i++) {
+        __m256i x = load_lanes_avx2(&frame[i * depth], width);
+        for (std::size_t j = 0u; j < Parity; j++) {
+            s[j] = _mm256_xor_si256(x, _mm256_gf2p8affine_epi64_epi8(s[j], _mm256_set1_epi64x((long long)matrices[j]), 0));
+        }
+    }
+
+    __m256i any = _mm256_setzero_si256();
+    for (std::size_t j = 0u; j < Parity; j++) {
+        any = _mm256_or_si256(any, s[j]);
+    }
+
+    uint64_t nonzero = ~(uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(any, _mm256_setzero_si256()));
+    return nonzero & (((uint64_t)1u << width) - 1u);
+}
+
+template <std::size_t Parity>
+static inline uint64_t interleaved_syndromes_ssse3(const uint8_t *frame, std::size_t len, std::size_t depth,
+        std::size_t width, const __m128i (&lo_tables)[Parity], const __m128i (&hi_tables)[Parity]) {
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    __m128i s[Parity];
+    for (std::size_t j = 0u; j < Parity; j++) {
+        s[j] = _mm_setzero_si128();
+    }
+
+    for (std::size_t i = 0u; i < len; i++) {
+        __m128i x = load_lanes(&frame[i * depth], width);
+        for (std::size_t j = 0u; j < Parity; j++) {
+            s[j] = _mm_xor_si128(x, _mm_xor_si128(
+                _mm_shuffle_epi8(lo_tables[j], _mm_and_si128(s[j], mask)),
+                _mm_shuffle_epi8(hi_tables[j], _mm_and_si128(_mm_srli_epi64(s[j], 4), mask))));
+        }
+    }
+
+    __m128i any = _mm_setzero_si128();
+    for (std::size_t j = 0u; j < Parity; j++) {
+        any = _mm_or_si128(any, s[j]);
+    }
+
+    uint64_t nonzero = ~(uint64_t)_mm_movemask_epi8(_mm_cmpeq_epi8(any, _mm_setzero_si128()));
+    return nonzero & (((uint64_t)1u << width) - 1u);
+}
+
+template <std::size_t Depth, std::size_t Parity>
+struct interleaved_syndrome_op_container<uint8_t, Depth, Parity> {
+    static uint64_t op(const uint8_t *frame, std::size_t len, const std::array<split_table_t<uint8_t>, Parity> &tables) {
+        uint64_t suspects = 0u;
+        std::size_t l = 0u;
+        if (cpu_supports_gfni()) {
+            uint64_t matrices[Parity];
+            load_affine_matrices(tables, matrices);
+            for (; l < Depth && Depth - l >= interleaved_syndrome_min_width(); l += 32u) {
+                suspects |= interleaved_syndromes_gfni(&frame[l], len, Depth,
+                    std::min<std::size_t>(32u, Depth - l), matrices) << l;
+            }
+        } else {
+            __m128i lo_tables[Parity], hi_tables[Parity];
+            load_split_tables(tables, lo_tables, hi_tables);
+            for (; l < Depth && Depth - l >= interleaved_syndrome_min_width(); l += 16u) {
+                suspects |= interleaved_syndromes_ssse3(&frame[l], len, Depth,
+                    std::min<std::size_t>(16u, Depth - l), lo_tables, hi_tables) << l;
+            }
+        }
+
+        /* Any remaining codewords are left to the scalar decoder. */
+        return suspects | ((((uint64_t)1u << Depth) - 1u) & ~(((uint64_t)1u << l) - 1u));
+    }
+};
+
+/*
+Syndromes of a single codeword. For each root b = alpha^(j + 1), Horner's
+rule is run over chunks of a vector's width W of symbols at a time, so
+that every lane is multiplied by the same constant b^W at each step,
+with the first chunk padded with leading zeros. Lane l then holds a sum
+weighted by b^(W - 1 - l), and the lanes are folded together in halves,
+multiplying by b^(W/2), b^(W/4) ... b^1, leaving the syndrome in lane 0.
+
+Row j of the tables holds multiplication by b^32, b^16, b^8, b^4, b^2
+and b^1, with a few spare rows so that roots can be processed in groups
+of eight without a remainder loop.
+*/
+static constexpr std::size_t syndrome_group() { return 8u; }
+
+template <std::size_t M, typename Primitive>
+struct syndrome_tables {
+    using gf = GaloisField<M, Primitive>;
+    static constexpr std::size_t num_roots = (1u << M) + syndrome_group();
+
+    std::array<std::array<uint64_t, 6u>, num_roots> matrices;
+    std::array<std::array<split_table_t<uint8_t>, 5u>, num_roots> split;
+
+    static const syndrome_tables &get() {
+        static const syndrome_tables tables = [] {
+            syndrome_tables t;
+            constexpr std::size_t field_size = (1u << M) - 1u;
+            for (std::size_t j = 0u; j < num_roots; j++) {
+                for (std::size_t k = 0u; k < 6u; k++) {
+                    split_table_t<uint8_t> table = gf::split_table(
+                        gf::antilog((((j + 1u) % field_size) << (5u - k)) % field_size));
+                    t.matrices[j][k] = affine_matrix(table);
+                    if (k > 0u) {
+                        t.split[j][k - 1u] = table;
+                    }
+                }
+            }
+
+            return t;
+        }();
+
+        return tables;
+    }
+};
+
+__attribute__((target("avx2,gfni")))
+static inline void syndromes_gfni(const uint8_t *in, std::size_t len, std::size_t parity,
+        const std::array<uint64_t, 6u> *matrices, uint8_t *syndromes) {
+    constexpr std::size_t group = syndrome_group();
+
+    /* The leading partial chunk is placed in the upper lanes. */
+    std::size_t head = len % 32u;
+    uint8_t temp[32u] = {};
+    std::copy_n(in, head, &temp[32u - head]);
+
+    for (std::size_t j0 = 0u; j0 < parity; j0 += group) {
+        __m256i acc[group];
+        for (std::size_t j = 0u; j < group; j++) {
+            acc[j] = _mm256_loadu_si256((const __m256i *)temp);
+        }
+
+        for (std::size_t i = head; i < len; i += 32u) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)&in[i]);
+            for (std::size_t j = 0u; j < group; j++) {
+                acc[j] = _mm256_xor_si256(x, _mm256_gf2p8affine_epi64_epi8(acc[j],
+                    _mm256_set1_epi64x((long long)matrices[j0 + j][0u]), 0));
+            }
+        }
+
+        for (std::size_t j = 0u; j < group && j0 + j < parity; j++) {
+            const std::array<uint64_t, 6u> &m = matrices[j0 + j];
+            __m128i x = _mm_xor_si128(_mm256_extracti128_si256(acc[j], 1),
+                _mm_gf2p8affine_epi64_epi8(_mm256_castsi256_si128(acc[j]), _mm_set1_epi64x((long long)m[1u]), 0));
+            x = _mm_xor_si128(_mm_srli_si128(x, 8), _mm_gf2p8affine_epi64_epi8(x, _mm_set1_epi64x((long long)m[2u]), 0));
+            x = _mm_xor_si128(_mm_srli_si128(x, 4), _mm_gf2p8affine_epi64_epi8(x, _mm_set1_epi64x((long long)m[3u]), 0));
+            x = _mm_xor_si128(_mm_srli_si128(x, 2), _mm_gf2p8affine_epi64_epi8(x, _mm_set1_epi64x((long long)m[4u]), 0));
+            x = _mm_xor_si128(_mm_srli_si128(x, 1), _mm_gf2p8affine_epi64_epi8(x, _mm_set1_epi64x((long long)m[5u]), 0));
+            syndromes[j0 + j] = (uint8_t)_mm_cvtsi128_si32(x);
+        }
+    }
+}
+
+static inline __m128i split_multiply_ssse3(__m128i x, const split_table_t<uint8_t> &table) {
+    const __m128i mask = _mm_set1_epi8(0x0f);
+    return _mm_xor_si128(
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)table[0u].data()), _mm_and_si128(x, mask)),
+        _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)table[1u].data()),
+            _mm_and_si128(_mm_srli_epi64(x, 4), mask)));
+}
+
+static inline void syndromes_ssse3(const uint8_t *in, std::size_t len, std::size_t parity,
+        const std::array<split_table_t<uint8_t>, 5u> *split, uint8_t *syndromes) {
+    constexpr std::size_t group = syndrome_group();
+
+    std::size_t head = len % 16u;
+    uint8_t temp[16u] = {};
+    std::copy_n(in, head, &temp[16u - head]);
+
+    for (std::size_t j0 = 0u; j0 < parity; j0 += group) {
+        __m128i acc[group];
+        for (std::size_t j = 0u; j < group; j++) {
+            acc[j] = _mm_loadu_si128((const __m128i *)temp);
+        }
+
+        for (std::size_t i = head; i < len; i += 16u) {
+            __m128i x = _mm_loadu_si128((const __m128i *)&in[i]);
+            for (std::size_t j = 0u; j < group; j++) {
+                acc[j] = _mm_xor_si128(x, split_multiply_ssse3(acc[j], split[j0 + j][0u]));
+            }
+        }
+
+        for (std::size_t j = 0u; j < group && j0 + j < parity; j++) {
+            const std::array<split_table_t<uint8_t>, 5u> &t = split[j0 + j];
+            __m128i x = acc[j];
+            x = _mm_xor_si128(_mm_srli_si128(x, 8), split_multiply_ssse3(x, t[1u]));
+            x = _mm_xor_si128(_mm_srli_si128(x, 4), split_multiply_ssse3(x, t[2u]));
+            x = _mm_xor_si128(_mm_srli_si128(x, 2), split_multiply_ssse3(x, t[3u]));
+            x = _mm_xor_si128(_mm_srli_si128(x, 1), split_multiply_ssse3(x, t[4u]));
+            syndromes[j0 + j] = (uint8_t)_mm_cvtsi128_si32(x);
+        }
+    }
+}
+
+template <std::size_t M, typename Primitive>
+struct syndrome_op_container<M, Primitive, uint8_t> {
+    static constexpr bool available(std::size_t) { return true; }
+
+    static void op(const uint8_t *in, std::size_t len, std::size_t parity, uint8_t *syndromes) {
+        const syndrome_tables<M, Primitive> &tables = syndrome_tables<M, Primitive>::get();
+        if (cpu_supports_gfni()) {
+            syndromes_gfni(in, len, parity, tables.matrices.data(), syndromes);
+        } else {
+            syndromes_ssse3(in, len, parity, tables.split.data(), syndromes);
+        }
+    }
+};
+
+/*
+16-bit symbols use AVX2, with 32 symbols per step held as a vector of
+their low bytes and a vector of their high bytes, which is the layout
+the split-table multiply works in. The deinterleave leaves the lanes out
+of order, so at the end they are put back in order and folded with
+scalar arithmetic rather than with vector shifts.
+
+Each root has the low and high byte tables of its split table for b^32.
+Tables for the first few hundred roots are built once. Codes with more
+parity than that use the scalar syndrome loop instead, so that decoding
+never builds tables or allocates.
+*/
+using syndrome_table_16_t = std::array<std::array<uint8_t, 16u>, 8u>;
+
+template <std::size_t M, typename Primitive>
+static syndrome_table_16_t get_syndrome_table_16(std::size_t j) {
+    using gf = GaloisField<M, Primitive>;
+    constexpr std::size_t field_size = (1u << M) - 1u;
+    split_table_t<uint16_t> table = gf::split_table(gf::antilog(((j + 1u) % field_size) * 32u % field_size));
+    syndrome_table_16_t t;
+
+    for (std::size_t n = 0u; n < 4u; n++) {
+        for (std::size_t v = 0u; v < 16u; v++) {
+            t[n][v] = table[n][v] & 0xffu;
+            t[n + 4u][v] = table[n][v] >> 8u;
+        }
+    }
+
+    return t;
+}
+
+template <std::size_t M, typename Primitive>
+struct syndrome_tables_16 {
+    static constexpr std::size_t num_roots = 256u + syndrome_group();
+
+    std::array<syndrome_table_16_t, num_roots> roots;
+
+    static const syndrome_tables_16 &get() {
+        static const syndrome_tables_16 tables = [] {
+            syndrome_tables_16 t;
+            for (std::size_t j = 0u; j < num_roots; j++) {
+                t.roots[j] = get_syndrome_table_16<M, Primitive>(j);
+            }
+
+            return t;
+        }();
+
+        return tables;
+    }
+};
+
+/* Load 32 symbols as a vector of low bytes and a vector of high bytes. */
+__attribute__((target("avx2")))
+static inline void load_split_bytes_avx2(const uint16_t *in, __m256i &x_lo, __m256i &x_hi) {
+    const __m256i split = _mm256_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15,
+        0, 2, 4, 6, 8, 10, 12, 14, 1, 3, 5, 7, 9, 11, 13, 15);
+    __m256i a = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)in), split);
+    __m256i b = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)&in[16u]), split);
+    x_lo = _mm256_unpacklo_epi64(a, b);
+    x_hi = _mm256_unpackhi_epi64(a, b);
+}
+
+template <std::size_t M, typename Primitive>
+__attribute__((target("avx2")))
+static inline void syndromes_avx2(const uint16_t *in, std::size_t len, std::size_t parity,
+        const syndrome_table_16_t *tables, uint16_t *syndromes) {
+    using gf = GaloisField<M, Primitive>;
+    constexpr std::size_t group = syndrome_group() / 2u;
+    constexpr std::size_t field_size = (1u << M) - 1u;
+    const __m256i mask = _mm256_set1_epi8(0x0f);
+
+    std::size_t head = len % 32u;
+    uint16_t temp[32u] = {};
+    std::copy_n(in, head, &temp[32u - head]);
+
+    for (std::size_t j0 = 0u; j0 < parity; j0 += group) {
+        __m256i acc_lo[group], acc_hi[group];
+        for (std::size_t j = 0u; j < group; j++) {
+            load_split_bytes_avx2(temp, acc_lo[j], acc_hi[j]);
+        }
+
+        for (std::size_t i = head; i < len; i += 32u) {
+            __m256i x_lo, x_hi;
+            load_split_bytes_avx2(&in[i], x_lo, x_hi);
+
+            for (std::size_t j = 0u; j < group; j++) {
+                const syndrome_table_16_t &t = tables[j0 + j];
+                __m256i nibbles[4u] = {
+                    _mm256_and_si256(acc_lo[j], mask), _mm256_and_si256(_mm256_srli_epi64(acc_lo[j], 4), mask),
+                    _mm256_and_si256(acc_hi[j], mask), _mm256_and_si256(_mm256_srli_epi64(acc_hi[j], 4), mask)
+                };
+
+                __m256i r_lo = x_lo, r_hi = x_hi;
+                for (std::size_t n = 0u; n < 4u; n++) {
+                    r_lo = _mm256_xor_si256(r_lo, _mm256_shuffle_epi8(
+                        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)t[n].data())), nibbles[n]));
+                    r_hi = _mm256_xor_si256(r_hi, _mm256_shuffle_epi8(
+                        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i *)t[n + 4u].data())), nibbles[n]));
+                }
+
+                acc_lo[j] = r_lo;
+                acc_hi[j] = r_hi;
+            }
+        }
+
+        /* Fold the lanes in order with Horner's rule for the root alpha^(j + 1). */
+        for (std::size_t j = 0u; j < group && j0 + j < parity; j++) {
+            uint16_t lanes[32u];
+            _mm256_storeu_si256((__m256i *)lanes, _mm256_unpacklo_epi8(acc_lo[j], acc_hi[j]));
+            _mm256_storeu_si256((__m256i *)&lanes[16u], _mm256_unpackhi_epi8(acc_lo[j], acc_hi[j]));
+
+            std::size_t e = (j0 + j + 1u) % field_size;
+            uint16_t s = 0u;
+            for (std::size_t l = 0u; l < 32u; l++) {
+                s = (s ? gf::antilog(gf::log(s) + e) : 0u) ^ lanes[l];
+            }
+
+            syndromes[j0 + j] = s;
+        }
+    }
+}
+
+template <std::size_t M, typename Primitive>
+struct syndrome_op_container<M, Primitive, uint16_t> {
+    using tables_t = syndrome_tables_16<M, Primitive>;
+
+    static bool available(std::size_t parity) {
+        return parity + syndrome_group() <= tables_t::num_roots && cpu_supports_avx2();
+    }
+
+    static void op(const uint16_t *in, std::size_t len, std::size_t parity, uint16_t *syndromes) {
+        syndromes_avx2<M, Primitive>(in, len, parity, tables_t::get().roots.data(), syndromes);
+    }
+};
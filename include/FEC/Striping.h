@@ -0,0 +1,218 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Thiemar {
+
+namespace Striping {
+
+/*
+Fixed pool of worker threads for data-parallel loops. The calling thread
+also takes part in each loop, so a pool of N threads starts N - 1
+workers, and a pool of one thread runs everything on the caller.
+*/
+class WorkerPool {
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+
+    /* State of the current loop, protected by 'mutex' apart from 'next_task'. */
+    const std::function<void(std::size_t)> *task = nullptr;
+    std::size_t num_tasks = 0u;
+    std::atomic<std::size_t> next_task{0u};
+    std::size_t busy_workers = 0u;
+    std::size_t generation = 0u;
+    bool stopping = false;
+
+    /* Claim and run tasks until there are none left. */
+    void work(const std::function<void(std::size_t)> &f, std::size_t n) {
+        for (std::size_t i = next_task++; i < n; i = next_task++) {
+            f(i);
+        }
+    }
+
+    void worker_loop() {
+        std::size_t seen = 0u;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            start_cv.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+
+            seen = generation;
+            const std::function<void(std::size_t)> &f = *task;
+            std::size_t n = num_tasks;
+            lock.unlock();
+
+            work(f, n);
+
+            lock.lock();
+            if (!--busy_workers) {
+                done_cv.notify_one();
+            }
+        }
+    }
+
+public:
+    explicit WorkerPool(std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency())) {
+        for (std::size_t i = 1u; i < num_threads; i++) {
+            workers.emplace_back(&WorkerPool::worker_loop, this);
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+
+        start_cv.notify_all();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+
+    std::size_t num_threads() const { return workers.size() + 1u; }
+
+    /*
+    Call f(i) for each i in [0, n), spread across the pool, and return once
+    all calls have finished. Tasks are handed out one at a time, so uneven
+    task costs balance out. Only one loop may run on a pool at a time.
+    */
+    void run(std::size_t n, const std::function<void(std::size_t)> &f) {
+        if (workers.empty() || n <= 1u) {
+            for (std::size_t i = 0u; i < n; i++) {
+                f(i);
+            }
+
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            task = &f;
+            num_tasks = n;
+            next_task = 0u;
+            busy_workers = workers.size();
+            generation++;
+        }
+
+        start_cv.notify_all();
+        work(f, n);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done_cv.wait(lock, [&] { return !busy_workers; });
+    }
+};
+
+/*
+Encodes large buffers by splitting them into tiles of about 'tile_size'
+bytes, sized so that a tile and its parity stay in the L2 cache, and
+encoding the tiles in parallel on a worker pool. Parity is written
+straight into the caller's buffers and nothing is copied.
+*/
+class StripedEncoder {
+    WorkerPool pool;
+    std::size_t tile_size;
+
+public:
+    static constexpr std::size_t default_tile_size() { return 256u * 1024u; }
+
+    explicit StripedEncoder(std::size_t num_threads = std::max(1u, std::thread::hardware_concurrency()),
+            std::size_t tile_size = default_tile_size()) : pool(num_threads), tile_size(tile_size) {}
+
+    std::size_t num_threads() const { return pool.num_threads(); }
+
+    /*
+    Split 'len' symbols from 'data' into consecutive messages of MessageLen
+    symbols, the last of which may be shorter (a shortened codeword), and
+    write Encoder::parity_length() parity symbols for each message to
+    consecutive positions of 'parity'.
+    */
+    template <typename Encoder, std::size_t MessageLen, typename T>
+    void encode_codewords(const T *data, std::size_t len, T *parity) {
+        static_assert(MessageLen > 0u, "Message length must be larger than zero");
+
+        std::size_t num_codewords = (len + MessageLen - 1u) / MessageLen;
+        std::size_t codewords_per_tile = std::max<std::size_t>(1u, tile_size / (MessageLen * sizeof(T)));
+        std::size_t num_tiles = (num_codewords + codewords_per_tile - 1u) / codewords_per_tile;
+
+        pool.run(num_tiles, [&](std::size_t tile) {
+            std::size_t first = tile * codewords_per_tile;
+            std::size_t last = std::min(first + codewords_per_tile, num_codewords);
+            for (std::size_t c = first; c < last; c++) {
+                std::size_t offset = c * MessageLen;
+                Encoder::encode(&data[offset], std::min(MessageLen, len - offset),
+                    &parity[c * Encoder::parity_length()]);
+            }
+        });
+    }
+
+    /*
+    Erasure-code Coder::data_shards() buffers from 'data' into
+    Coder::parity_shards() buffers in 'parity', each of 'len' symbols. Each
+    tile is the same range of columns across all of the shards.
+    */
+    template <typename Coder, typename T>
+    void encode_shards(const T *const *data, T *const *parity, std::size_t len) {
+        /* Keep tiles a multiple of the widest SIMD vector. */
+        std::size_t tile_len = std::max<std::size_t>(64u,
+            (tile_size / ((Coder::data_shards() + Coder::parity_shards()) * sizeof(T))) & ~(std::size_t)63u);
+        std::size_t num_tiles = (len + tile_len - 1u) / tile_len;
+
+        pool.run(num_tiles, [&](std::size_t tile) {
+            std::size_t offset = tile * tile_len;
+            std::array<const T *, Coder::data_shards()> tile_data;
+            std::array<T *, Coder::parity_shards()> tile_parity;
+            for (std::size_t i = 0u; i < tile_data.size(); i++) {
+                tile_data[i] = &data[i][offset];
+            }
+
+            for (std::size_t i = 0u; i < tile_parity.size(); i++) {
+                tile_parity[i] = &parity[i][offset];
+            }
+
+            Coder::encode(tile_data.data(), tile_parity.data(), std::min(tile_len, len - offset));
+        });
+    }
+};
+
+}
+
+}
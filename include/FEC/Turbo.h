@@ -0,0 +1,523 @@
+/*
+Copyright (C) 2017 Thiemar Pty Ltd
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "FEC/Types.h"
+#include "FEC/Utilities.h"
+#include "FEC/BinarySequence.h"
+#include "FEC/Convolutional.h"
+#include "FEC/Striping.h"
+
+namespace Thiemar {
+
+namespace Turbo {
+
+/*
+Quadratic permutation polynomial interleaver, pi(i) = (F1 * i + F2 * i^2)
+mod K, as used by LTE. Bit i of the interleaved block is bit pi(i) of the
+original block.
+*/
+template <std::size_t K, std::size_t F1, std::size_t F2>
+class QPPInterleaver {
+    static_assert(K > 0u, "Interleaver size must be larger than zero");
+
+    /*
+    Calculate the permutation incrementally, using
+    pi(i + 1) = pi(i) + g(i) and g(i + 1) = g(i) + 2 * F2, to avoid
+    overflow for large block sizes.
+    */
+    static constexpr std::array<uint32_t, K> get_permutation() {
+        std::array<uint32_t, K> permutation = {};
+        std::size_t pi = 0u;
+        std::size_t g = (F1 + F2) % K;
+
+        for (std::size_t i = 0u; i < K; i++) {
+            permutation[i] = (uint32_t)pi;
+            pi = (pi + g) % K;
+            g = (g + 2u * F2) % K;
+        }
+
+        return permutation;
+    }
+
+public:
+    static constexpr std::size_t size() { return K; }
+    static constexpr std::array<uint32_t, K> permutation = get_permutation();
+};
+
+/* LTE constituent code polynomials, from 3GPP TS 36.212. */
+namespace Polynomials {
+    /* Feedback polynomial 1 + D^2 + D^3. */
+    using lte_feedback = BinarySequence<1, 1, 0, 1>;
+    /* Feedforward polynomial 1 + D + D^3. */
+    using lte_feedforward = BinarySequence<1, 0, 1, 1>;
+}
+
+/* LTE interleaver parameters for a selection of block sizes. */
+namespace Interleavers {
+    using lte_40 = QPPInterleaver<40u, 3u, 10u>;
+    using lte_1024 = QPPInterleaver<1024u, 31u, 64u>;
+    using lte_6144 = QPPInterleaver<6144u, 263u, 480u>;
+}
+
+/*
+Branch labels of the trellis of a recursive systematic convolutional code,
+as encoded by Convolutional::PuncturedRecursiveSystematicEncoder, which
+defines the code. Branch r is the register value (a << (K - 1)) | s for
+state 's' and shifted-in bit 'a'.
+*/
+template <std::size_t ConstraintLength, typename FeedbackPolynomial, typename FeedforwardPolynomial>
+class RecursiveSystematicTrellis {
+    using code = Convolutional::PuncturedRecursiveSystematicEncoder<ConstraintLength,
+        Convolutional::PuncturingMatrices::n_2_rate_1_2, FeedbackPolynomial, FeedforwardPolynomial>;
+
+public:
+    static constexpr std::size_t num_states() { return code::num_states(); }
+
+private:
+    static constexpr std::array<float, 2u * num_states()> get_systematic_signs() {
+        std::array<float, 2u * num_states()> signs = {};
+        for (std::size_t r = 0u; r < signs.size(); r++) {
+            signs[r] = ((r >= num_states()) ^ code::feedback(r % num_states())) ? -0.5f : 0.5f;
+        }
+
+        return signs;
+    }
+
+    static constexpr std::array<float, 2u * num_states()> get_parity_signs() {
+        std::array<float, 2u * num_states()> signs = {};
+        for (std::size_t r = 0u; r < signs.size(); r++) {
+            signs[r] = code::output(r, 0u) ? -0.5f : 0.5f;
+        }
+
+        return signs;
+    }
+
+public:
+    /*
+    Half the BPSK symbol for the message and parity bits of each branch, used
+    to calculate branch metrics from LLRs.
+    */
+    static constexpr std::array<float, 2u * num_states()> systematic_signs = get_systematic_signs();
+    static constexpr std::array<float, 2u * num_states()> parity_signs = get_parity_signs();
+};
+
+/*
+Parallel concatenated turbo encoder built from two identical recursive
+systematic convolutional encoders, the second of which encodes the
+interleaved message. The output is packed MSB-first: for each message bit,
+the systematic bit and the two parity bits, followed by the termination bits
+of the first encoder (systematic then parity, for each step) and then those
+of the second encoder.
+
+The constituent encoders are PuncturedRecursiveSystematicEncoder at rate
+1/2, which encodes a byte of message per table lookup. Their outputs are
+then multiplexed a byte of message at a time.
+*/
+template <std::size_t ConstraintLength, typename Interleaver, typename FeedbackPolynomial,
+    typename FeedforwardPolynomial>
+class TurboEncoder {
+    static_assert(Interleaver::size() % 8u == 0u, "Interleaver size must be a whole number of bytes");
+
+    using constituent = Convolutional::PuncturedRecursiveSystematicEncoder<ConstraintLength,
+        Convolutional::PuncturingMatrices::n_2_rate_1_2, FeedbackPolynomial, FeedforwardPolynomial>;
+
+    static constexpr std::size_t tail_bits() { return (ConstraintLength - 1u) * 2u; }
+
+    static bool get_bit(const uint8_t *in, std::size_t idx) {
+        return in[idx / 8u] & (0x80u >> (idx % 8u));
+    }
+
+    static void put_bit(uint8_t *out, std::size_t idx, bool bit) {
+        out[idx / 8u] |= bit ? (0x80u >> (idx % 8u)) : 0u;
+    }
+
+public:
+    static constexpr std::size_t message_length() { return Interleaver::size() / 8u; }
+
+    /* Number of encoded bits, including the termination bits. */
+    static constexpr std::size_t output_bits() {
+        return Interleaver::size() * 3u + tail_bits() * 2u;
+    }
+
+    /* Calculate the number of output bytes. */
+    static constexpr std::size_t calculate_output_length() {
+        return output_bits() / 8u + ((output_bits() % 8u) ? 1u : 0u);
+    }
+
+    static std::array<uint8_t, calculate_output_length()> encode(const std::array<uint8_t, message_length()> &in) {
+        std::array<uint8_t, calculate_output_length()> out = {};
+
+        std::array<uint8_t, message_length()> interleaved;
+        for (std::size_t b = 0u; b < message_length(); b++) {
+            uint8_t v = 0u;
+            for (std::size_t i = 0u; i < 8u; i++) {
+                v = (uint8_t)((v << 1u) | (get_bit(in.data(), Interleaver::permutation[b * 8u + i]) ? 1u : 0u));
+            }
+
+            interleaved[b] = v;
+        }
+
+        /* Each constituent output holds a systematic and a parity bit per step. */
+        std::array<uint8_t, constituent::calculate_output_length(message_length())> out_1, out_2;
+        constituent::encode(in.data(), message_length(), out_1.data());
+        constituent::encode(interleaved.data(), message_length(), out_2.data());
+
+        /* Eight message bits take two bytes of each constituent output and three output bytes. */
+        for (std::size_t b = 0u; b < message_length(); b++) {
+            uint32_t pairs_1 = ((uint32_t)out_1[b * 2u] << 8u) | out_1[b * 2u + 1u];
+            uint32_t pairs_2 = ((uint32_t)out_2[b * 2u] << 8u) | out_2[b * 2u + 1u];
+            uint32_t triples = 0u;
+
+            for (std::size_t i = 0u; i < 8u; i++) {
+                std::size_t shift = 14u - i * 2u;
+                triples = (triples << 3u) | (((pairs_1 >> shift) & 3u) << 1u) | ((pairs_2 >> shift) & 1u);
+            }
+
+            out[b * 3u] = (uint8_t)(triples >> 16u);
+            out[b * 3u + 1u] = (uint8_t)(triples >> 8u);
+            out[b * 3u + 2u] = (uint8_t)triples;
+        }
+
+        /* Termination bits, which follow the message in each constituent output. */
+        for (std::size_t i = 0u; i < tail_bits(); i++) {
+            put_bit(out.data(), Interleaver::size() * 3u + i, get_bit(out_1.data(), Interleaver::size() * 2u + i));
+            put_bit(out.data(), Interleaver::size() * 3u + tail_bits() + i,
+                get_bit(out_2.data(), Interleaver::size() * 2u + i));
+        }
+
+        return out;
+    }
+};
+
+/*
+Iterative turbo decoder using two Max-Log-MAP soft-in soft-out constituent
+decoders. The input is one LLR per encoded bit, with positive values
+indicating a zero bit.
+
+Each constituent trellis is split into independent sub-blocks of
+'SubBlockLength' steps. A sub-block starts its recursions from the boundary
+state metrics that its neighbours calculated in the previous iteration, so
+the sub-blocks of a half-iteration have no dependence on each other. The
+decode overloads taking a WorkerPool spread them across its threads, and
+the others run them in turn on the caller. Within a sub-block, the
+recursions use the SIMD operations of the convolutional BCJR decoder.
+
+The inputs, boundary metrics and LLRs of a block are allocated on the heap,
+since they take several times the interleaver size in floats. Each
+sub-block keeps (SubBlockLength + ConstraintLength) * 2^(ConstraintLength - 1)
+forward metrics on the stack of the thread running it.
+*/
+template <std::size_t ConstraintLength, std::size_t SubBlockLength, typename Interleaver,
+    typename FeedbackPolynomial, typename FeedforwardPolynomial>
+class TurboDecoder {
+    static_assert(SubBlockLength > 0u, "Sub-block length must be at least one");
+
+    using trellis = RecursiveSystematicTrellis<ConstraintLength, FeedbackPolynomial, FeedforwardPolynomial>;
+    using encoder = TurboEncoder<ConstraintLength, Interleaver, FeedbackPolynomial, FeedforwardPolynomial>;
+    using algorithm = Convolutional::BCJR::MaxLogMAP;
+
+    static constexpr std::size_t num_states() { return trellis::num_states(); }
+    static constexpr std::size_t num_steps() { return Interleaver::size() + ConstraintLength - 1u; }
+    static constexpr std::size_t num_sub_blocks() {
+        return Interleaver::size() / SubBlockLength + ((Interleaver::size() % SubBlockLength) ? 1u : 0u);
+    }
+
+    /* Scaling applied to extrinsic information to compensate for Max-Log-MAP overestimation. */
+    static constexpr float extrinsic_scale() { return 0.75f; }
+    static constexpr float impossible_metric() { return -1e9f; }
+
+    /* Inputs to one constituent decoder, including the termination steps. */
+    struct ConstituentInput {
+        std::array<float, num_steps()> systematic;
+        std::array<float, num_steps()> parity;
+    };
+
+    /* State metrics at the sub-block boundaries. */
+    struct BoundaryMetrics {
+        std::array<std::array<float, num_states()>, num_sub_blocks()> alpha;
+        std::array<std::array<float, num_states()>, num_sub_blocks()> beta;
+    };
+
+    static void initialise_boundaries(BoundaryMetrics &bounds) {
+        for (std::size_t p = 0u; p < num_sub_blocks(); p++) {
+            bounds.alpha[p].fill(0.0f);
+            bounds.beta[p].fill(0.0f);
+        }
+
+        /* The trellis starts and ends in the zero state. */
+        std::fill(bounds.alpha[0u].begin() + 1u, bounds.alpha[0u].end(), impossible_metric());
+        std::fill(bounds.beta[num_sub_blocks() - 1u].begin() + 1u, bounds.beta[num_sub_blocks() - 1u].end(),
+            impossible_metric());
+    }
+
+    static void calculate_branch_metrics(const ConstituentInput &in, const float *apriori, std::size_t t,
+            float *gamma) {
+        if (t < Interleaver::size()) {
+            float sys = in.systematic[t] + apriori[t];
+            for (std::size_t r = 0u; r < 2u * num_states(); r++) {
+                gamma[r] = trellis::systematic_signs[r] * sys + trellis::parity_signs[r] * in.parity[t];
+            }
+        } else {
+            /* Termination steps always shift in a zero feedback bit. */
+            for (std::size_t r = 0u; r < num_states(); r++) {
+                gamma[r] = trellis::systematic_signs[r] * in.systematic[t] + trellis::parity_signs[r] * in.parity[t];
+                gamma[num_states() + r] = impossible_metric();
+            }
+        }
+    }
+
+    static void normalise(const float *in, float *out) {
+        float ref = in[0u];
+        for (std::size_t s = 0u; s < num_states(); s++) {
+            out[s] = in[s] - ref;
+        }
+    }
+
+    /* Calculate the a posteriori LLR of the message bit for one step. */
+    static float calculate_llr(const float *alpha, const float *gamma, const float *beta) {
+        float metric_0 = -std::numeric_limits<float>::infinity();
+        float metric_1 = -std::numeric_limits<float>::infinity();
+
+        for (std::size_t r = 0u; r < 2u * num_states(); r++) {
+            float metric = alpha[r % num_states()] + gamma[r] + beta[r >> 1u];
+            if (trellis::systematic_signs[r] < 0.0f) {
+                metric_1 = std::max(metric_1, metric);
+            } else {
+                metric_0 = std::max(metric_0, metric);
+            }
+        }
+
+        return metric_0 - metric_1;
+    }
+
+    /*
+    Decode one sub-block, reading its boundary metrics from 'bounds' and
+    writing the new boundary metrics for its neighbours into 'next_bounds'.
+    */
+    static void decode_sub_block(const ConstituentInput &in, const float *apriori, std::size_t p,
+            const BoundaryMetrics &bounds, BoundaryMetrics &next_bounds, float *out) {
+        std::size_t t0 = p * SubBlockLength;
+        std::size_t t1 = (p == num_sub_blocks() - 1u) ? num_steps() : t0 + SubBlockLength;
+
+        float alphas[SubBlockLength + ConstraintLength][num_states()];
+        float alpha[num_states()], beta[num_states()], temp[num_states()];
+        float gamma[2u * num_states()];
+
+        std::copy(bounds.alpha[p].begin(), bounds.alpha[p].end(), alpha);
+        for (std::size_t t = t0; t < t1; t++) {
+            std::copy_n(alpha, num_states(), alphas[t - t0]);
+            calculate_branch_metrics(in, apriori, t, gamma);
+            Convolutional::BCJR::Operations::forward<algorithm, num_states()>(alpha, gamma, temp);
+            normalise(temp, alpha);
+        }
+
+        if (p + 1u < num_sub_blocks()) {
+            std::copy_n(alpha, num_states(), next_bounds.alpha[p + 1u].begin());
+        }
+
+        std::copy(bounds.beta[p].begin(), bounds.beta[p].end(), beta);
+        for (std::size_t t = t1; t-- > t0;) {
+            calculate_branch_metrics(in, apriori, t, gamma);
+            if (t < Interleaver::size()) {
+                out[t] = calculate_llr(alphas[t - t0], gamma, beta);
+            }
+
+            Convolutional::BCJR::Operations::backward<algorithm, num_states()>(beta, gamma, temp);
+            normalise(temp, beta);
+        }
+
+        if (p > 0u) {
+            std::copy_n(beta, num_states(), next_bounds.beta[p - 1u].begin());
+        }
+    }
+
+    /*
+    Run one constituent decoder over all of its sub-blocks, on 'pool' if
+    there is one. Each sub-block writes its own range of 'out' and its own
+    entries of 'next_bounds', so they need no synchronisation.
+    */
+    static void decode_constituent(const ConstituentInput &in, const float *apriori, BoundaryMetrics &bounds,
+            BoundaryMetrics &next_bounds, float *out, Striping::WorkerPool *pool) {
+        next_bounds = bounds;
+
+        if (pool) {
+            pool->run(num_sub_blocks(), [&](std::size_t p) {
+                decode_sub_block(in, apriori, p, bounds, next_bounds, out);
+            });
+        } else {
+            for (std::size_t p = 0u; p < num_sub_blocks(); p++) {
+                decode_sub_block(in, apriori, p, bounds, next_bounds, out);
+            }
+        }
+
+        bounds = next_bounds;
+    }
+
+    /* Working state for one block. */
+    struct Workspace {
+        ConstituentInput in_1, in_2;
+        BoundaryMetrics bounds_1, bounds_2, next_bounds;
+        std::array<float, Interleaver::size()> apriori_1, apriori_2, app_1, app_2, app_2_deinterleaved;
+    };
+
+    /*
+    Run the decoder iterations. After each iteration, 'stop' is called with
+    the hard decisions and the a posteriori LLRs of both constituent decoders
+    in message order, and decoding finishes if it returns true.
+    */
+    template <std::size_t Iterations, typename Stop>
+    static std::array<uint8_t, encoder::message_length()> decode_iterations(
+            const std::array<float, encoder::output_bits()> &in, Striping::WorkerPool *pool, Stop stop) {
+        constexpr std::size_t K = Interleaver::size();
+        const auto &pi = Interleaver::permutation;
+
+        std::unique_ptr<Workspace> workspace(new Workspace);
+        ConstituentInput &in_1 = workspace->in_1, &in_2 = workspace->in_2;
+        BoundaryMetrics &bounds_1 = workspace->bounds_1, &bounds_2 = workspace->bounds_2;
+        auto &apriori_1 = workspace->apriori_1, &apriori_2 = workspace->apriori_2;
+        auto &app_1 = workspace->app_1, &app_2 = workspace->app_2;
+        auto &app_2_deinterleaved = workspace->app_2_deinterleaved;
+
+        /* Separate the constituent decoder inputs. */
+        for (std::size_t t = 0u; t < K; t++) {
+            in_1.systematic[t] = in[t * 3u];
+            in_1.parity[t] = in[t * 3u + 1u];
+            in_2.parity[t] = in[t * 3u + 2u];
+        }
+
+        for (std::size_t t = 0u; t < K; t++) {
+            in_2.systematic[t] = in_1.systematic[pi[t]];
+        }
+
+        for (std::size_t i = 0u; i < ConstraintLength - 1u; i++) {
+            in_1.systematic[K + i] = in[K * 3u + i * 2u];
+            in_1.parity[K + i] = in[K * 3u + i * 2u + 1u];
+            in_2.systematic[K + i] = in[K * 3u + (ConstraintLength - 1u + i) * 2u];
+            in_2.parity[K + i] = in[K * 3u + (ConstraintLength - 1u + i) * 2u + 1u];
+        }
+
+        initialise_boundaries(bounds_1);
+        initialise_boundaries(bounds_2);
+
+        apriori_1.fill(0.0f);
+        std::array<uint8_t, encoder::message_length()> out = {};
+
+        for (std::size_t it = 0u; it < Iterations; it++) {
+            decode_constituent(in_1, apriori_1.data(), bounds_1, workspace->next_bounds, app_1.data(), pool);
+            for (std::size_t t = 0u; t < K; t++) {
+                apriori_2[t] = extrinsic_scale() * (app_1[pi[t]] - in_1.systematic[pi[t]] - apriori_1[pi[t]]);
+            }
+
+            decode_constituent(in_2, apriori_2.data(), bounds_2, workspace->next_bounds, app_2.data(), pool);
+            for (std::size_t t = 0u; t < K; t++) {
+                apriori_1[pi[t]] = extrinsic_scale() * (app_2[t] - in_2.systematic[t] - apriori_2[t]);
+                app_2_deinterleaved[pi[t]] = app_2[t];
+            }
+
+            out.fill(0u);
+            for (std::size_t t = 0u; t < K; t++) {
+                out[t / 8u] |= (app_2_deinterleaved[t] < 0.0f) ? (0x80u >> (t % 8u)) : 0u;
+            }
+
+            if (stop(out, app_1, app_2_deinterleaved)) {
+                break;
+            }
+        }
+
+        return out;
+    }
+
+    /* Stop once the hard decisions of both constituent decoders agree. */
+    static bool decisions_agree(const std::array<float, Interleaver::size()> &app_1,
+            const std::array<float, Interleaver::size()> &app_2) {
+        for (std::size_t t = 0u; t < app_1.size(); t++) {
+            if ((app_1[t] < 0.0f) != (app_2[t] < 0.0f)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+public:
+    /* Calculate the number of input LLRs, one per encoded bit. */
+    static constexpr std::size_t calculate_input_length() { return encoder::output_bits(); }
+
+    /*
+    Decode a block, stopping early once the hard decisions of both
+    constituent decoders agree.
+    */
+    template <std::size_t Iterations = 8u>
+    static std::array<uint8_t, encoder::message_length()> decode(
+            const std::array<float, calculate_input_length()> &in) {
+        return decode_iterations<Iterations>(in, nullptr, [](const auto &, const auto &app_1, const auto &app_2) {
+            return decisions_agree(app_1, app_2);
+        });
+    }
+
+    /*
+    Decode a block, stopping early once 'check' returns true for the hard
+    decisions, for example when the CRC of a message passes.
+    */
+    template <std::size_t Iterations = 8u, typename Check>
+    static std::array<uint8_t, encoder::message_length()> decode(
+            const std::array<float, calculate_input_length()> &in, Check check) {
+        return decode_iterations<Iterations>(in, nullptr, [&](const auto &out, const auto &, const auto &) {
+            return check(out);
+        });
+    }
+
+    /*
+    As above, but with the sub-blocks of each half-iteration spread across
+    the threads of 'pool'. The output is the same as decoding serially.
+    */
+    template <std::size_t Iterations = 8u>
+    static std::array<uint8_t, encoder::message_length()> decode(Striping::WorkerPool &pool,
+            const std::array<float, calculate_input_length()> &in) {
+        return decode_iterations<Iterations>(in, &pool, [](const auto &, const auto &app_1, const auto &app_2) {
+            return decisions_agree(app_1, app_2);
+        });
+    }
+
+    template <std::size_t Iterations = 8u, typename Check>
+    static std::array<uint8_t, encoder::message_length()> decode(Striping::WorkerPool &pool,
+            const std::array<float, calculate_input_length()> &in, Check check) {
+        return decode_iterations<Iterations>(in, &pool, [&](const auto &out, const auto &, const auto &) {
+            return check(out);
+        });
+    }
+};
+
+}
+
+}
@@ -48,17 +48,12 @@ size_t conv_get_encoded_len() {
 }
 
 void conv_encode(const uint8_t *data, uint8_t *buf) {
-    auto in = Thiemar::Detail::to_array<uint8_t, MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH>(data);
-    auto out = ConvolutionalEncoder::encode(in);
-    memcpy(buf, out.data(), out.size());
+    ConvolutionalEncoder::encode(data, MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH, buf);
 }
 
 
 void conv_decode(const uint8_t *data, uint8_t *buf) {
-    auto in = Thiemar::Detail::to_array<uint8_t, ConvolutionalEncoder::calculate_output_length(
-        MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH)>(data);
-    auto out = ConvolutionalDecoder::decode(in);
-    memcpy(buf, out.data(), out.size());
+    ConvolutionalDecoder::decode(data, conv_get_encoded_len(), buf);
 }
 
 void polar_encode(const uint8_t *data, uint8_t *buf) {
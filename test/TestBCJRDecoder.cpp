@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include "FEC/Convolutional.h"
+
+using TestEncoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+    Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+    Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+>;
+
+template <std::size_t WindowLength, typename Algorithm>
+using TestDecoder = Thiemar::Convolutional::PuncturedBCJRDecoder<
+    7u,
+    WindowLength,
+    Algorithm,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+    Thiemar::BinarySequence<1, 1, 0, 1, 1, 0, 1>,
+    Thiemar::BinarySequence<1, 0, 0, 1, 1, 1, 1>
+>;
+
+using TestEncoderPunctured = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+using TestDecoderPunctured = Thiemar::Convolutional::PuncturedBCJRDecoder<
+    7u,
+    48u,
+    Thiemar::Convolutional::BCJR::MaxLogMAP,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+/* Convert encoded bytes to LLRs for BPSK with additive Gaussian noise. */
+template <std::size_t N>
+std::array<float, N * 8u> modulate(const std::array<uint8_t, N> &in, float amplitude, float sigma) {
+    std::array<float, N * 8u> out;
+
+    for (std::size_t i = 0u; i < out.size(); i++) {
+        float u1 = ((float)std::rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+        float u2 = (float)std::rand() / (float)RAND_MAX;
+        float noise = sigma * std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318531f * u2);
+        float symbol = (in[i / 8u] & (0x80u >> (i % 8u))) ? -amplitude : amplitude;
+        out[i] = symbol + noise;
+    }
+
+    return out;
+}
+
+/* Extract hard decisions from LLRs. */
+template <std::size_t N>
+std::array<uint8_t, N / 8u> hard_decision(const std::array<float, N> &in) {
+    std::array<uint8_t, N / 8u> out = {};
+
+    for (std::size_t i = 0u; i < N; i++) {
+        out[i / 8u] |= (in[i] < 0.0f) ? (0x80u >> (i % 8u)) : 0u;
+    }
+
+    return out;
+}
+
+TEST(BCJRDecoderTest, Decode) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 128u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_llr = modulate(TestEncoder::encode(test_in), 2.0f, 0.0f);
+    auto test_out = TestDecoder<32u, Thiemar::Convolutional::BCJR::MaxLogMAP>::decode<test_in.size()>(test_llr);
+    auto test_decoded = hard_decision(test_out);
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(BCJRDecoderTest, DecodeNoisy) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 128u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    /* Channel LLRs at an Eb/N0 of 5 dB. */
+    float sigma = std::sqrt(1.0f / (2.0f * 0.5f * std::pow(10.0f, 0.5f)));
+    auto test_llr = modulate(TestEncoder::encode(test_in), 2.0f / (sigma * sigma), 2.0f / sigma);
+
+    auto test_out_max_log = TestDecoder<32u, Thiemar::Convolutional::BCJR::MaxLogMAP>::decode<test_in.size()>(test_llr);
+    auto test_out_log = TestDecoder<32u, Thiemar::Convolutional::BCJR::LogMAP>::decode<test_in.size()>(test_llr);
+    auto test_decoded_max_log = hard_decision(test_out_max_log);
+    auto test_decoded_log = hard_decision(test_out_log);
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded_max_log[i]) << "Buffers differ at index " << i;
+        EXPECT_EQ((int)test_in[i], (int)test_decoded_log[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(BCJRDecoderTest, WindowLength) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 64u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    float sigma = std::sqrt(1.0f / (2.0f * 0.5f * std::pow(10.0f, 0.3f)));
+    auto test_llr = modulate(TestEncoder::encode(test_in), 2.0f / (sigma * sigma), 2.0f / sigma);
+
+    /* A window covering the whole trellis gives the exact Max-Log-MAP result. */
+    auto test_out_full = TestDecoder<1024u, Thiemar::Convolutional::BCJR::MaxLogMAP>::decode<test_in.size()>(test_llr);
+    auto test_out_window = TestDecoder<48u, Thiemar::Convolutional::BCJR::MaxLogMAP>::decode<test_in.size()>(test_llr);
+
+    for (std::size_t i = 0u; i < test_out_full.size(); i++) {
+        EXPECT_EQ(test_out_full[i] < 0.0f, test_out_window[i] < 0.0f) << "Decisions differ at index " << i;
+    }
+}
+
+TEST(BCJRDecoderTest, DecodeApriori) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 16u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    /* With all channel LLRs erased, the output is the a priori information. */
+    std::array<float, TestDecoder<32u, Thiemar::Convolutional::BCJR::LogMAP>::calculate_input_length(
+        test_in.size())> test_llr = {};
+    std::array<float, test_in.size() * 8u> test_apriori;
+    for (std::size_t i = 0u; i < test_apriori.size(); i++) {
+        test_apriori[i] = (test_in[i / 8u] & (0x80u >> (i % 8u))) ? -3.0f : 3.0f;
+    }
+
+    auto test_out = TestDecoder<32u, Thiemar::Convolutional::BCJR::LogMAP>::decode<test_in.size()>(
+        test_llr, test_apriori);
+
+    for (std::size_t i = 0u; i < test_out.size(); i++) {
+        EXPECT_NEAR(test_apriori[i], test_out[i], 1e-3f) << "LLRs differ at index " << i;
+    }
+}
+
+TEST(PuncturedBCJRDecoderTest, Decode) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 120u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    float sigma = std::sqrt(1.0f / (2.0f * 0.75f * std::pow(10.0f, 0.7f)));
+    auto test_llr = modulate(TestEncoderPunctured::encode(test_in), 2.0f / (sigma * sigma), 2.0f / sigma);
+    auto test_out = TestDecoderPunctured::decode<test_in.size()>(test_llr);
+    auto test_decoded = hard_decision(test_out);
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include "FEC/CRC.h"
+
+TEST(CRCTest, Reference) {
+    std::array<uint8_t, 9u> test_in = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+
+    /* Check values for zero initial value and no final XOR. */
+    EXPECT_EQ(0x31c3u, Thiemar::CRCs::lte_16::calculate(test_in));
+    EXPECT_EQ(0xcde703u, Thiemar::CRCs::lte_24a::calculate(test_in));
+}
+
+TEST(CRCTest, Check) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 64u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size() - 3u; i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    uint32_t crc = Thiemar::CRCs::lte_24a::calculate(test_in.data(), test_in.size() - 3u);
+    test_in[test_in.size() - 3u] = crc >> 16u;
+    test_in[test_in.size() - 2u] = crc >> 8u;
+    test_in[test_in.size() - 1u] = crc;
+
+    EXPECT_TRUE(Thiemar::CRCs::lte_24a::check(test_in));
+
+    test_in[10u] ^= 0x10u;
+    EXPECT_FALSE(Thiemar::CRCs::lte_24a::check(test_in));
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <cstdlib>
+#include <type_traits>
+#include <vector>
+#include "FEC/GaloisField.h"
+#include "FEC/CarrylessGaloisField.h"
+#include "FEC/ReedSolomon.h"
+
+using GF32 = Thiemar::CarrylessGaloisField<32u, Thiemar::CarrylessPolynomials::m_32>;
+using GF64 = Thiemar::CarrylessGaloisField<64u, Thiemar::CarrylessPolynomials::m_64>;
+
+static uint64_t random_u64() {
+    uint64_t r = 0u;
+    for (std::size_t i = 0u; i < 4u; i++) {
+        r = (r << 16u) ^ (std::rand() & 0xffffu);
+    }
+
+    return r;
+}
+
+TEST(CarrylessGaloisFieldTest, MatchesTables) {
+    using TableField = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    using TestField = Thiemar::CarrylessGaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+
+    for (std::size_t x = 0u; x < 256u; x++) {
+        for (std::size_t y = 0u; y < 256u; y++) {
+            ASSERT_EQ((int)TableField::multiply(x, y), (int)TestField::multiply(x, y)) << x << " * " << y;
+        }
+
+        EXPECT_EQ((int)TableField::divide(1u, x), (int)TestField::inverse(x)) << "Inverse of " << x;
+    }
+}
+
+TEST(CarrylessGaloisFieldTest, MatchesTablesWideField) {
+    using TableField = Thiemar::GaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+    using TestField = Thiemar::CarrylessGaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 10000u; n++) {
+        uint16_t x = std::rand() & 0xffffu, y = std::rand() & 0xffffu;
+        ASSERT_EQ((int)TableField::multiply(x, y), (int)TestField::multiply(x, y)) << x << " * " << y;
+        ASSERT_EQ((int)TableField::divide(x, y), (int)TestField::divide(x, y)) << x << " / " << y;
+    }
+}
+
+TEST(CarrylessGaloisFieldTest, Backend) {
+    using Primitive = Thiemar::ReedSolomon::Polynomials::m_16_69643;
+    using TableField = Thiemar::GaloisField<16u, Primitive>;
+    using TestField = Thiemar::GaloisField<16u, Primitive, Thiemar::GaloisFieldBackends::Carryless>;
+    static_assert(std::is_base_of<Thiemar::CarrylessGaloisField<16u, Primitive>, TestField>::value,
+        "Carry-less backend must select CarrylessGaloisField");
+    EXPECT_EQ(TableField::field_size(), TestField::field_size());
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    std::array<uint16_t, 40u> x;
+    std::array<uint16_t, 9u> y;
+    for (uint16_t &v : x) {
+        v = std::rand() & 0xffffu;
+    }
+
+    for (uint16_t &v : y) {
+        v = std::rand() & 0xffffu;
+    }
+
+    /* The remainder is by a monic polynomial. */
+    y[0u] = 1u;
+    EXPECT_TRUE(TableField::multiply(x, y) == TestField::multiply(x, y));
+    EXPECT_TRUE(TableField::remainder(x, y) == TestField::remainder(x, y));
+    EXPECT_TRUE(TableField::add(x, y) == TestField::add(x, y));
+    EXPECT_EQ(TableField::dot(x.data(), &x[10u], 20u), TestField::dot(x.data(), &x[10u], 20u));
+    EXPECT_EQ(TableField::evaluate(x.data(), x.size(), y[3u]), TestField::evaluate(x.data(), x.size(), y[3u]));
+
+    /* Every other coefficient, at more points than make up a group. */
+    std::array<uint16_t, 9u> expected, result;
+    TableField::evaluate_n(expected.data(), x.data(), x.size() / 2u, 2u, y.data(), y.size());
+    TestField::evaluate_n(result.data(), x.data(), x.size() / 2u, 2u, y.data(), y.size());
+    EXPECT_TRUE(expected == result);
+}
+
+/*
+alpha = x generates the multiplicative group if alpha^((2^M - 1) / q) is
+not one for any prime factor q of 2^M - 1, which checks both the
+arithmetic and that the field polynomial is primitive.
+*/
+template <typename TestField>
+static void test_primitive(uint64_t order, std::initializer_list<uint64_t> factors) {
+    EXPECT_EQ(1u, (uint64_t)TestField::power(2u, order));
+    for (uint64_t q : factors) {
+        EXPECT_NE(1u, (uint64_t)TestField::power(2u, order / q)) << "Factor " << q;
+    }
+}
+
+TEST(CarrylessGaloisFieldTest, Primitive) {
+    test_primitive<GF32>(0xffffffffu, { 3u, 5u, 17u, 257u, 65537u });
+    test_primitive<GF64>(~(uint64_t)0u, { 3u, 5u, 17u, 257u, 641u, 65537u, 6700417u });
+}
+
+template <typename TestField>
+static void test_field_axioms() {
+    using gf_t = typename TestField::gf_t;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 1000u; n++) {
+        gf_t a = random_u64(), b = random_u64(), c = random_u64();
+
+        EXPECT_EQ(TestField::multiply(a, b), TestField::multiply(b, a));
+        EXPECT_EQ(TestField::multiply(TestField::multiply(a, b), c), TestField::multiply(a, TestField::multiply(b, c)));
+        EXPECT_EQ(TestField::multiply(a, b ^ c), TestField::multiply(a, b) ^ TestField::multiply(a, c));
+        EXPECT_EQ(a, TestField::multiply(a, 1u));
+        if (a) {
+            EXPECT_EQ(1u, TestField::multiply(a, TestField::inverse(a)));
+            EXPECT_EQ(b, TestField::multiply(TestField::divide(b, a), a));
+        }
+    }
+}
+
+TEST(CarrylessGaloisFieldTest, FieldAxioms) {
+    test_field_axioms<GF32>();
+    test_field_axioms<GF64>();
+}
+
+TEST(CarrylessGaloisFieldTest, Regions) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    std::vector<uint64_t> src(1000u), dst(1000u), sum(1000u);
+    for (std::size_t i = 0u; i < src.size(); i++) {
+        src[i] = random_u64();
+        sum[i] = random_u64();
+    }
+
+    std::vector<uint64_t> acc = sum;
+    uint64_t c = random_u64();
+    GF64::mul_region(dst.data(), src.data(), c, src.size());
+    GF64::mul_add_region(sum.data(), src.data(), c, src.size());
+
+    for (std::size_t i = 0u; i < src.size(); i++) {
+        EXPECT_EQ(GF64::multiply(c, src[i]), dst[i]) << "Products differ at index " << i;
+        EXPECT_EQ(acc[i] ^ dst[i], sum[i]) << "Sums differ at index " << i;
+    }
+}
+
+#if defined(USE_SIMD_X86)
+TEST(CarrylessGaloisFieldTest, PCLMULKernel) {
+    if (!Thiemar::Detail::cpu_supports_pclmul()) {
+        return;
+    }
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 1000u; n++) {
+        uint64_t a = random_u64(), b = random_u64();
+        auto expected = Thiemar::Detail::clmul_generic<64u>::op(a, b);
+        auto result = Thiemar::Detail::clmul_pclmul::op(a, b);
+        EXPECT_EQ(expected.lo, result.lo);
+        EXPECT_EQ(expected.hi, result.hi);
+    }
+}
+#endif
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ChannelInterleaver.h"
+
+/* Check a block interleaver against a direct bit-by-bit or byte-by-byte permutation. */
+template <std::size_t Rows, std::size_t Cols, typename T>
+void test_block_interleaver() {
+    using TestInterleaver = Thiemar::ChannelInterleaver::BlockInterleaver<Rows, Cols, T>;
+    constexpr bool bits = std::is_same<T, bool>::value;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, TestInterleaver::size()> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestInterleaver::interleave(test_in);
+    auto test_reconstructed = TestInterleaver::deinterleave(test_out);
+
+    for (std::size_t r = 0u; r < Rows; r++) {
+        for (std::size_t c = 0u; c < Cols; c++) {
+            std::size_t i = r * Cols + c;
+            std::size_t o = c * Rows + r;
+            if (bits) {
+                EXPECT_EQ((test_in[i / 8u] >> (7u - i % 8u)) & 1u, (test_out[o / 8u] >> (7u - o % 8u)) & 1u)
+                    << "Bits differ at row " << r << ", column " << c;
+            } else {
+                EXPECT_EQ((int)test_in[i], (int)test_out[o]) << "Bytes differ at row " << r << ", column " << c;
+            }
+        }
+    }
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_reconstructed[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(BlockInterleaverTest, Bytes) {
+    test_block_interleaver<16u, 4096u, uint8_t>();
+    test_block_interleaver<16u, 204u, uint8_t>();
+    test_block_interleaver<37u, 51u, uint8_t>();
+    test_block_interleaver<1u, 7u, uint8_t>();
+}
+
+TEST(BlockInterleaverTest, Bits) {
+    test_block_interleaver<16u, 2048u, bool>();
+    test_block_interleaver<48u, 136u, bool>();
+    test_block_interleaver<24u, 8u, bool>();
+    test_block_interleaver<12u, 34u, bool>();
+}
+
+TEST(ConvolutionalInterleaverTest, Interleave) {
+    /* Three branches with delays of 0, 1 and 2 commutator cycles. */
+    Thiemar::ChannelInterleaver::ConvolutionalInterleaver<3u, 1u> interleaver;
+    std::array<uint8_t, 12u> test_in = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+    std::array<uint8_t, 12u> expected = { 1, 0, 0, 4, 2, 0, 7, 5, 3, 10, 8, 6 };
+    std::array<uint8_t, 12u> test_out;
+
+    interleaver.process(test_in.data(), test_in.size(), test_out.data());
+
+    for (std::size_t i = 0u; i < test_out.size(); i++) {
+        EXPECT_EQ((int)expected[i], (int)test_out[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(ConvolutionalInterleaverTest, Deinterleave) {
+    constexpr std::size_t branches = 12u;
+    constexpr std::size_t delay = 17u;
+    Thiemar::ChannelInterleaver::ConvolutionalInterleaver<branches, delay> interleaver;
+    Thiemar::ChannelInterleaver::ConvolutionalDeinterleaver<branches, delay> deinterleaver;
+    constexpr std::size_t latency = decltype(deinterleaver)::latency();
+
+    /* Set up test buffers. */
+    std::vector<uint8_t> test_in(20000u);
+    std::vector<uint8_t> test_out(test_in.size());
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    /* Process the stream in uneven chunks, in place. */
+    std::copy(test_in.begin(), test_in.end(), test_out.begin());
+    for (std::size_t i = 0u, len = 1u; i < test_out.size(); i += len, len = len * 3u + 1u) {
+        std::size_t n = std::min(len, test_out.size() - i);
+        interleaver.process(&test_out[i], n, &test_out[i]);
+        deinterleaver.process(&test_out[i], n, &test_out[i]);
+    }
+
+    EXPECT_EQ(branches * (branches - 1u) * delay, latency);
+    for (std::size_t i = latency; i < test_out.size(); i++) {
+        EXPECT_EQ((int)test_in[i - latency], (int)test_out[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(ConvolutionalInterleaverTest, BurstSpreading) {
+    constexpr std::size_t branches = 8u;
+    constexpr std::size_t delay = 4u;
+    Thiemar::ChannelInterleaver::ConvolutionalInterleaver<branches, delay> interleaver;
+    Thiemar::ChannelInterleaver::ConvolutionalDeinterleaver<branches, delay> deinterleaver;
+
+    std::vector<uint8_t> test_out(2000u, 0u);
+    interleaver.process(test_out.data(), test_out.size(), test_out.data());
+
+    /* Corrupt a burst of 'branches' channel symbols. */
+    for (std::size_t i = 1000u; i < 1000u + branches; i++) {
+        test_out[i] = 1u;
+    }
+
+    deinterleaver.process(test_out.data(), test_out.size(), test_out.data());
+
+    /* After deinterleaving, corrupted symbols are at least 'branches * delay - 1' apart. */
+    std::size_t last = 0u, count = 0u;
+    for (std::size_t i = 0u; i < test_out.size(); i++) {
+        if (test_out[i]) {
+            if (count) {
+                EXPECT_GE(i - last, branches * delay - 1u) << "Burst not spread at index " << i;
+            }
+
+            last = i;
+            count++;
+        }
+    }
+
+    EXPECT_EQ(branches, count);
+}
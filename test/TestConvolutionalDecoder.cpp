@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
+#include <vector>
 #include "FEC/Convolutional.h"
 
 /* Test against fecmagic implementation. */
@@ -133,3 +134,93 @@ TEST(ConvolutionalDecoderRate3Test, Decode) {
         EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
     }
 }
+
+TEST(ConvolutionalDecoderTest, DecodeRuntimeLength) {
+    /* Packet sizes are only known at run time. */
+    for (std::size_t len : { 20u, 33u, 777u, 65536u }) {
+        /* Set up test buffers. */
+        std::vector<uint8_t> test_in(len);
+        std::vector<uint8_t> test_out(TestEncoder::calculate_output_length(len));
+        std::vector<uint8_t> test_decoded(TestDecoder::calculate_output_length(test_out.size()));
+
+        /* Seed RNG for repeatibility. */
+        std::srand(123u);
+        for (std::size_t i = 0u; i < test_in.size(); i++) {
+            test_in[i] = std::rand() & 0xffu;
+        }
+
+        TestEncoder::encode(test_in.data(), test_in.size(), test_out.data());
+
+        /* Flip a bit at each end of the encoded packet. */
+        test_out[1u] ^= 0x08u;
+        test_out[test_out.size() - 3u] ^= 0x20u;
+
+        TestDecoder::decode(test_out.data(), test_out.size(), test_decoded.data());
+
+        for (std::size_t i = 0u; i < test_in.size(); i++) {
+            EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+TEST(ConvolutionalDecoderTest, DecodeTailBiting) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 40u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoder::encode_tail_biting(test_in);
+
+    /* Flip a few well-separated bits, including at the frame edges. */
+    test_out[0] ^= 0x80u;
+    test_out[30] ^= 0x04u;
+    test_out[60] ^= 0x10u;
+    test_out[test_out.size() - 1u] ^= 0x01u;
+
+    auto test_decoded = TestDecoder::decode_tail_biting(test_out);
+
+    EXPECT_EQ(test_in.size(), test_decoded.size());
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+using TestEncoderTailBiting = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+using TestDecoderTailBiting = Thiemar::Convolutional::PuncturedHardDecisionViterbiDecoder<
+    7u,
+    48u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+TEST(PuncturedConvolutionalDecoderTest, DecodeTailBiting) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 42u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoderTailBiting::encode_tail_biting(test_in);
+    test_out[20] ^= 0x08u;
+
+    auto test_decoded = TestDecoderTailBiting::decode_tail_biting<8u>(test_out);
+
+    EXPECT_EQ(test_in.size(), test_decoded.size());
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
+#include <vector>
 #include "FEC/Convolutional.h"
+#include "FEC/Turbo.h"
 
 /* Test against fecmagic implementation. */
 #include "convolutional-encoder.h"
@@ -99,3 +101,213 @@ TEST(PuncturedConvolutionalEncoderTest, Encode) {
         EXPECT_EQ((int)test_out_fecmagic[i], (int)test_out[i]) << "Buffers differ at index " << i;
     }
 }
+
+TEST(ConvolutionalEncoderTest_k_7, EncodeTailBiting) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 40u> test_in = {};
+    std::array<uint8_t, 80u> test_in_repeated = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+        test_in_repeated[i] = test_in_repeated[i + test_in.size()] = test_in[i];
+    }
+
+    /*
+    Encoding the message twice leaves the encoder in the tail-biting
+    starting state at the beginning of the second copy.
+    */
+    auto test_out = TestEncoder_k_7::encode_tail_biting(test_in);
+    auto test_out_repeated = TestEncoder_k_7::encode(test_in_repeated);
+
+    EXPECT_EQ(80u, test_out.size());
+    for (std::size_t i = 0u; i < test_out.size(); i++) {
+        EXPECT_EQ((int)test_out_repeated[i + test_out.size()], (int)test_out[i]) << "Buffers differ at index " << i;
+    }
+}
+
+/* Check the table-driven encoder against the reference encoder. */
+template <std::size_t ConstraintLength, typename PuncturingMatrix, typename... Polynomials>
+void test_table_encoder() {
+    using Encoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+        ConstraintLength, PuncturingMatrix, Polynomials...>;
+    using TableEncoder = Thiemar::Convolutional::PuncturedTableConvolutionalEncoder<
+        ConstraintLength, PuncturingMatrix, Polynomials...>;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 1021u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = Encoder::encode(test_in);
+    auto test_out_table = TableEncoder::encode(test_in);
+
+    for (std::size_t i = 0u; i < test_out.size(); i++) {
+        EXPECT_EQ((int)test_out[i], (int)test_out_table[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(TableConvolutionalEncoderTest, Encode) {
+    using namespace Thiemar::Convolutional;
+
+    test_table_encoder<7u, PuncturingMatrices::n_2_rate_1_2, Polynomials::n_2_k_7_g11, Polynomials::n_2_k_7_g12>();
+    test_table_encoder<7u, PuncturingMatrices::n_2_rate_2_3, Polynomials::n_2_k_7_g11, Polynomials::n_2_k_7_g12>();
+    test_table_encoder<7u, PuncturingMatrices::n_2_rate_3_4, Polynomials::n_2_k_7_g11, Polynomials::n_2_k_7_g12>();
+    test_table_encoder<7u, PuncturingMatrices::n_2_rate_5_6, Polynomials::n_2_k_7_g11, Polynomials::n_2_k_7_g12>();
+    test_table_encoder<7u, PuncturingMatrices::n_2_rate_7_8, Polynomials::n_2_k_7_g11, Polynomials::n_2_k_7_g12>();
+    test_table_encoder<7u, PuncturingMatrices::n_3_rate_1_3,
+        Polynomials::n_3_k_7_g11, Polynomials::n_3_k_7_g12, Polynomials::n_3_k_7_g13>();
+    test_table_encoder<9u, PuncturingMatrices::n_2_rate_1_2, Polynomials::n_2_k_9_g11, Polynomials::n_2_k_9_g12>();
+    test_table_encoder<11u, PuncturingMatrices::n_2_rate_1_2, Polynomials::n_2_k_11_g11, Polynomials::n_2_k_11_g12>();
+}
+
+TEST(ConvolutionalEncoderTest_k_7, EncodeRuntimeLength) {
+    using TableEncoder_k_7 = Thiemar::Convolutional::PuncturedTableConvolutionalEncoder<
+        7u,
+        Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+    >;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoder_k_7::encode(test_in);
+
+    /* Encoding a prefix of the message matches the start of the full encoding. */
+    for (std::size_t len : { 1u, 7u, 20u, 21u, 257u, 1024u }) {
+        std::array<uint8_t, TestEncoder_k_7::calculate_output_length(1024u)> test_out_runtime;
+        std::array<uint8_t, TestEncoder_k_7::calculate_output_length(1024u)> test_out_table;
+        TestEncoder_k_7::encode(test_in.data(), len, test_out_runtime.data());
+        TableEncoder_k_7::encode(test_in.data(), len, test_out_table.data());
+
+        for (std::size_t i = 0u; i < len * 2u; i++) {
+            EXPECT_EQ((int)test_out[i], (int)test_out_runtime[i]) << "Buffers differ at index " << i;
+        }
+
+        for (std::size_t i = 0u; i < TestEncoder_k_7::calculate_output_length(len); i++) {
+            EXPECT_EQ((int)test_out_runtime[i], (int)test_out_table[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+/* Bit-serial reference for the RSC encoder, with the same trellis conventions. */
+template <std::size_t ConstraintLength, typename PuncturingMatrix, typename FeedbackPolynomial,
+    typename... Polynomials>
+std::vector<uint8_t> reference_rsc_encode(const uint8_t *in, std::size_t len) {
+    constexpr std::size_t num_outputs = sizeof...(Polynomials) + 1u;
+    constexpr std::size_t row_len = PuncturingMatrix::size() / num_outputs;
+    const std::size_t polys[] = { FeedbackPolynomial::to_integer(), Polynomials::to_integer()... };
+    auto parity = [](std::size_t x) { return (bool)(__builtin_popcountll(x) & 1u); };
+
+    std::vector<bool> bits;
+    std::size_t state = 0u;
+    for (std::size_t i = 0u; i < len * 8u + ConstraintLength - 1u; i++) {
+        bool fb = parity(state & polys[0]);
+        bool u = (i < len * 8u) ? (in[i / 8u] >> (7u - i % 8u)) & 1u : fb;
+        std::size_t reg = ((std::size_t)(u ^ fb) << (ConstraintLength - 1u)) | state;
+
+        for (std::size_t q = 0u; q < num_outputs; q++) {
+            if (PuncturingMatrix::test((i % row_len) * num_outputs + q)) {
+                bits.push_back(q ? parity(reg & polys[q]) : u);
+            }
+        }
+
+        state = reg >> 1u;
+    }
+
+    EXPECT_EQ(0u, state);
+
+    std::vector<uint8_t> out((bits.size() + 7u) / 8u, 0u);
+    for (std::size_t i = 0u; i < bits.size(); i++) {
+        out[i / 8u] |= bits[i] ? (0x80u >> (i % 8u)) : 0u;
+    }
+
+    return out;
+}
+
+template <std::size_t ConstraintLength, typename PuncturingMatrix, typename FeedbackPolynomial,
+    typename... Polynomials>
+void test_rsc_encoder() {
+    using Encoder = Thiemar::Convolutional::PuncturedRecursiveSystematicEncoder<
+        ConstraintLength, PuncturingMatrix, FeedbackPolynomial, Polynomials...>;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 257u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    for (std::size_t len : { 0u, 1u, 5u, 40u, 257u }) {
+        auto test_out_reference = reference_rsc_encode<ConstraintLength, PuncturingMatrix, FeedbackPolynomial,
+            Polynomials...>(test_in.data(), len);
+        std::vector<uint8_t> test_out(Encoder::calculate_output_length(len));
+        Encoder::encode(test_in.data(), len, test_out.data());
+
+        ASSERT_EQ(test_out_reference.size(), test_out.size());
+        for (std::size_t i = 0u; i < test_out.size(); i++) {
+            EXPECT_EQ((int)test_out_reference[i], (int)test_out[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+TEST(RecursiveSystematicEncoderTest, Encode) {
+    using namespace Thiemar::Convolutional;
+
+    test_rsc_encoder<4u, Thiemar::BinarySequence<1, 1>, Thiemar::Turbo::Polynomials::lte_feedback,
+        Thiemar::Turbo::Polynomials::lte_feedforward>();
+    test_rsc_encoder<7u, PuncturingMatrices::n_2_rate_3_4, Polynomials::n_2_k_7_g11,
+        Polynomials::n_2_k_7_g12>();
+    test_rsc_encoder<7u, PuncturingMatrices::n_3_rate_1_3, Polynomials::n_3_k_7_g11,
+        Polynomials::n_3_k_7_g12, Polynomials::n_3_k_7_g13>();
+    test_rsc_encoder<11u, PuncturingMatrices::n_2_rate_7_8,
+        Polynomials::n_2_k_11_g11, Polynomials::n_2_k_11_g12>();
+}
+
+TEST(RecursiveSystematicEncoderTest, TurboConstituent) {
+    /* The first constituent code of the turbo encoder is the unpunctured LTE RSC code. */
+    using Interleaver = Thiemar::Turbo::Interleavers::lte_40;
+    using TurboEncoder = Thiemar::Turbo::TurboEncoder<4u, Interleaver,
+        Thiemar::Turbo::Polynomials::lte_feedback, Thiemar::Turbo::Polynomials::lte_feedforward>;
+    using Encoder = Thiemar::Convolutional::PuncturedRecursiveSystematicEncoder<4u,
+        Thiemar::BinarySequence<1, 1>, Thiemar::Turbo::Polynomials::lte_feedback,
+        Thiemar::Turbo::Polynomials::lte_feedforward>;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, TurboEncoder::message_length()> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out_turbo = TurboEncoder::encode(test_in);
+    auto test_out = Encoder::encode(test_in);
+
+    auto get_bit = [](const uint8_t *buf, std::size_t i) { return (buf[i / 8u] >> (7u - i % 8u)) & 1u; };
+    for (std::size_t i = 0u; i < Interleaver::size(); i++) {
+        EXPECT_EQ(get_bit(test_out_turbo.data(), i * 3u), get_bit(test_out.data(), i * 2u)) << "Bits differ at step " << i;
+        EXPECT_EQ(get_bit(test_out_turbo.data(), i * 3u + 1u), get_bit(test_out.data(), i * 2u + 1u)) <<
+            "Bits differ at step " << i;
+    }
+
+    for (std::size_t i = 0u; i < 6u; i++) {
+        EXPECT_EQ(get_bit(test_out_turbo.data(), Interleaver::size() * 3u + i),
+            get_bit(test_out.data(), Interleaver::size() * 2u + i)) << "Bits differ in termination at index " << i;
+    }
+}
@@ -0,0 +1,132 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ErasureCode.h"
+#include "FEC/ReedSolomon.h"
+
+#define DATA_SHARDS 10u
+#define PARITY_SHARDS 4u
+
+using TestCoder = Thiemar::ErasureCode::CauchyErasureCoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, DATA_SHARDS, PARITY_SHARDS>;
+
+class ErasureCodeTest : public ::testing::Test {
+protected:
+    static constexpr std::size_t shard_len = 1000u;
+
+    std::vector<std::vector<uint8_t>> shards;
+    std::vector<std::vector<uint8_t>> reference;
+    std::vector<uint8_t *> pointers;
+
+    void SetUp() override {
+        shards.assign(DATA_SHARDS + PARITY_SHARDS, std::vector<uint8_t>(shard_len));
+
+        /* Seed RNG for repeatibility. */
+        std::srand(123u);
+        for (std::size_t i = 0u; i < DATA_SHARDS; i++) {
+            for (std::size_t j = 0u; j < shard_len; j++) {
+                shards[i][j] = std::rand() & 0xffu;
+            }
+        }
+
+        for (auto &shard : shards) {
+            pointers.push_back(shard.data());
+        }
+
+        TestCoder::encode(pointers.data(), &pointers[DATA_SHARDS], shard_len);
+        reference = shards;
+    }
+
+    /* Erase the given shards, reconstruct them and compare against the originals. */
+    void check_reconstruct(TestCoder &coder, std::initializer_list<std::size_t> erased) {
+        bool present[DATA_SHARDS + PARITY_SHARDS];
+        std::fill_n(present, DATA_SHARDS + PARITY_SHARDS, true);
+        for (std::size_t i : erased) {
+            std::fill(shards[i].begin(), shards[i].end(), 0xa5u);
+            present[i] = false;
+        }
+
+        EXPECT_TRUE(coder.reconstruct(pointers.data(), present, shard_len));
+        for (std::size_t i = 0u; i < shards.size(); i++) {
+            EXPECT_EQ(reference[i], shards[i]) << "Shard " << i << " differs";
+        }
+    }
+};
+
+TEST_F(ErasureCodeTest, Encode) {
+    /* Check the parity against element-wise multiplication by the Cauchy matrix. */
+    using gf = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    for (std::size_t i = 0u; i < PARITY_SHARDS; i++) {
+        for (std::size_t k = 0u; k < shard_len; k++) {
+            uint8_t sum = 0u;
+            for (std::size_t j = 0u; j < DATA_SHARDS; j++) {
+                sum ^= gf::multiply(TestCoder::coefficient(i, j), shards[j][k]);
+            }
+
+            EXPECT_EQ((int)sum, (int)shards[DATA_SHARDS + i][k]) << "Parity shard " << i << " differs at index " << k;
+        }
+    }
+}
+
+TEST_F(ErasureCodeTest, ReconstructData) {
+    TestCoder coder;
+    check_reconstruct(coder, { 0u });
+    check_reconstruct(coder, { 3u, 9u });
+    check_reconstruct(coder, { 0u, 1u, 2u, 3u });
+    check_reconstruct(coder, { 6u, 7u, 8u, 9u });
+}
+
+TEST_F(ErasureCodeTest, ReconstructParity) {
+    TestCoder coder;
+    check_reconstruct(coder, { 10u });
+    check_reconstruct(coder, { 10u, 11u, 12u, 13u });
+}
+
+TEST_F(ErasureCodeTest, ReconstructMixed) {
+    TestCoder coder;
+    check_reconstruct(coder, { 2u, 11u });
+    check_reconstruct(coder, { 0u, 5u, 10u, 13u });
+    check_reconstruct(coder, { 9u, 12u, 13u });
+}
+
+TEST_F(ErasureCodeTest, ReconstructAllPatterns) {
+    /* Every pattern of up to PARITY_SHARDS erasures, with a cache smaller than the number of patterns. */
+    TestCoder coder;
+    for (std::size_t mask = 1u; mask < (1u << (DATA_SHARDS + PARITY_SHARDS)); mask++) {
+        if (__builtin_popcount(mask) > (int)PARITY_SHARDS) {
+            continue;
+        }
+
+        bool present[DATA_SHARDS + PARITY_SHARDS];
+        for (std::size_t i = 0u; i < DATA_SHARDS + PARITY_SHARDS; i++) {
+            present[i] = !(mask & (1u << i));
+            if (!present[i]) {
+                std::fill(shards[i].begin(), shards[i].end(), 0u);
+            }
+        }
+
+        ASSERT_TRUE(coder.reconstruct(pointers.data(), present, shard_len)) << "Pattern " << mask;
+        ASSERT_EQ(reference, shards) << "Pattern " << mask;
+    }
+}
+
+TEST_F(ErasureCodeTest, ReconstructCachedPattern) {
+    /* The same erasure pattern repeatedly, as for a burst of lost packets. */
+    TestCoder coder;
+    for (std::size_t n = 0u; n < 3u; n++) {
+        check_reconstruct(coder, { 1u, 4u, 12u });
+        check_reconstruct(coder, { 5u });
+    }
+}
+
+TEST_F(ErasureCodeTest, TooManyErasures) {
+    TestCoder coder;
+    bool present[DATA_SHARDS + PARITY_SHARDS];
+    std::fill_n(present, DATA_SHARDS + PARITY_SHARDS, true);
+    for (std::size_t i : { 0u, 2u, 4u, 11u, 13u }) {
+        present[i] = false;
+    }
+
+    EXPECT_FALSE(coder.reconstruct(pointers.data(), present, shard_len));
+    EXPECT_EQ(reference, shards);
+}
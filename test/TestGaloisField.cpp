@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
+#include <vector>
 #include "FEC/GaloisField.h"
 #include "FEC/ReedSolomon.h"
 
@@ -53,6 +54,29 @@ TEST(GaloisFieldTest, Logarithm) {
     }
 }
 
+TEST(GaloisFieldTest, LargeFieldTables) {
+    using TestGaloisField = Thiemar::GaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+
+    /* A primitive polynomial generates every non-zero element exactly once. */
+    std::vector<bool> seen(1u << 16u);
+    for (std::size_t i = 0u; i < (1u << 16u) - 1u; i++) {
+        uint16_t e = TestGaloisField::antilog(i);
+        EXPECT_FALSE(seen[e]) << "Element " << e << " repeated at exponent " << i;
+        EXPECT_EQ((int)i, (int)TestGaloisField::log(e));
+        seen[e] = true;
+    }
+
+    EXPECT_FALSE(seen[0u]);
+    EXPECT_EQ(1, (int)TestGaloisField::antilog((1u << 16u) - 1u));
+
+    /* The antilog table repeats, so that sums of two logarithms can index it directly. */
+    for (std::size_t i = 0u; i < (1u << 16u) + 1u; i++) {
+        EXPECT_EQ((int)TestGaloisField::antilog(i), (int)TestGaloisField::antilog(i + (1u << 16u) - 1u)) << "Tables differ at exponent " << i;
+    }
+
+    EXPECT_EQ(1, (int)TestGaloisField::multiply(TestGaloisField::antilog(1234u), TestGaloisField::antilog(65535u - 1234u)));
+}
+
 /*
 Expected outputs from:
 http://www.ee.unb.ca/cgi-bin/tervo/calc2.pl?num=1&den=255&f=m&p=36&d=1&y=1&m=1.
@@ -131,3 +155,184 @@ TEST(GaloisFieldPolynomialTest, Remainder) {
     std::array<TestGaloisField::gf_t, 7u> p3 = TestGaloisField::remainder(p1, p2);
     (void)p3;
 }
+
+template <typename T, T... Gs>
+std::array<T, sizeof...(Gs)> sequence_to_array(std::integer_sequence<T, Gs...>) {
+    return std::array<T, sizeof...(Gs)>{ Gs... };
+}
+
+TEST(GaloisFieldPolynomialTest, RemainderSequence) {
+    using TestGaloisField = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    using Generator = Thiemar::Detail::generator_polynomial<TestGaloisField, 8u>::coefficients;
+    std::array<TestGaloisField::gf_t, 9u> g = sequence_to_array(Generator{});
+    std::array<TestGaloisField::gf_t, 80u> p1 = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < p1.size() - 8u; i++) {
+        p1[i] = std::rand() & 0xffu;
+    }
+
+    /* Both overloads compute the same remainder. */
+    auto r1 = TestGaloisField::remainder(p1, g);
+    auto r2 = TestGaloisField::remainder(p1, Generator{}, std::make_index_sequence<8u>{});
+    for (std::size_t i = 0u; i < r1.size(); i++) {
+        EXPECT_EQ((int)r1[i], (int)r2[i]) << "Remainders differ at index " << i;
+    }
+
+    /* Appending the remainder gives a multiple of the generator. */
+    std::copy(r1.begin(), r1.end(), p1.end() - 8u);
+    for (auto r : TestGaloisField::remainder(p1, g)) {
+        EXPECT_EQ(0, (int)r);
+    }
+}
+
+/* Check the batch operations against element-wise arithmetic. */
+template <typename TestGaloisField>
+void test_batch_operations(std::size_t m) {
+    using gf_t = typename TestGaloisField::gf_t;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t len : { 0u, 1u, 2u, 17u, 100u, 1000u }) {
+        std::vector<gf_t> x(len), y(len), products(len);
+        for (std::size_t i = 0u; i < len; i++) {
+            /* Include some zero elements, which have no logarithm. */
+            x[i] = (i % 7u) ? (std::rand() & ((1u << m) - 1u)) : 0u;
+            y[i] = (i % 5u) ? (std::rand() & ((1u << m) - 1u)) : 0u;
+        }
+
+        TestGaloisField::multiply_n(products.data(), x.data(), y.data(), len);
+
+        gf_t sum = 0u;
+        for (std::size_t i = 0u; i < len; i++) {
+            EXPECT_EQ((int)TestGaloisField::multiply(x[i], y[i]), (int)products[i]) << "Products differ at index " << i;
+            sum ^= products[i];
+        }
+
+        EXPECT_EQ((int)sum, (int)TestGaloisField::dot(x.data(), y.data(), len));
+
+        for (gf_t point : { 0u, 1u, 2u, (unsigned)(std::rand() & ((1u << m) - 1u)) }) {
+            /* Sum each term, highest order first, with its own power of the point. */
+            gf_t value = 0u;
+            for (std::size_t i = 0u; i < len; i++) {
+                gf_t term = x[i];
+                for (std::size_t k = i + 1u; k < len; k++) {
+                    term = TestGaloisField::multiply(term, point);
+                }
+
+                value ^= term;
+            }
+
+            EXPECT_EQ((int)value, (int)TestGaloisField::evaluate(x.data(), len, point)) << "Values differ for length " << len;
+        }
+    }
+}
+
+TEST(GaloisFieldBatchTest, Operations) {
+    using TestGaloisField = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    test_batch_operations<TestGaloisField>(8u);
+}
+
+TEST(GaloisFieldBatchTest, OperationsLargeField) {
+    using TestGaloisField = Thiemar::GaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+    test_batch_operations<TestGaloisField>(16u);
+}
+
+/* Check a region multiplication against element-wise multiplication, for a range of lengths and constants. */
+template <typename TestGaloisField, typename MulRegion, typename MulAddRegion>
+void test_region_operations(MulRegion mul_region, MulAddRegion mul_add_region, std::size_t m) {
+    using gf_t = typename TestGaloisField::gf_t;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t len : { 0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 100u, 1000u }) {
+        std::vector<gf_t> src(len), dst(len), acc(len);
+        for (std::size_t i = 0u; i < len; i++) {
+            src[i] = std::rand() & ((1u << m) - 1u);
+            acc[i] = std::rand() & ((1u << m) - 1u);
+        }
+
+        for (gf_t c : { 0u, 1u, 2u, 3u, 142u, (unsigned)(std::rand() & ((1u << m) - 1u)) }) {
+            std::vector<gf_t> sum = acc;
+            mul_region(dst.data(), src.data(), c, len);
+            mul_add_region(sum.data(), src.data(), c, len);
+
+            for (std::size_t i = 0u; i < len; i++) {
+                gf_t product = TestGaloisField::multiply(c, src[i]);
+                EXPECT_EQ((int)product, (int)dst[i]) << "Products differ at index " << i << " of " << len;
+                EXPECT_EQ((int)(acc[i] ^ product), (int)sum[i]) << "Sums differ at index " << i << " of " << len;
+            }
+        }
+    }
+}
+
+TEST(GaloisFieldRegionTest, Multiplication) {
+    using TestGaloisField = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    test_region_operations<TestGaloisField>(TestGaloisField::mul_region, TestGaloisField::mul_add_region, 8u);
+}
+
+TEST(GaloisFieldRegionTest, MultiplicationWideField) {
+    /* Elements of GF(2^10) are stored as 16-bit words. */
+    using TestGaloisField = Thiemar::GaloisField<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>>;
+    test_region_operations<TestGaloisField>(TestGaloisField::mul_region, TestGaloisField::mul_add_region, 10u);
+}
+
+TEST(GaloisFieldRegionTest, MultiplicationLargeField) {
+    using TestGaloisField = Thiemar::GaloisField<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643>;
+    test_region_operations<TestGaloisField>(TestGaloisField::mul_region, TestGaloisField::mul_add_region, 16u);
+}
+
+TEST(GaloisFieldRegionTest, InPlaceMultiplication) {
+    using TestGaloisField = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    std::array<uint8_t, 100u> buf;
+    for (std::size_t i = 0u; i < buf.size(); i++) {
+        buf[i] = i;
+    }
+
+    TestGaloisField::mul_region(buf.data(), buf.data(), 29u, buf.size());
+    for (std::size_t i = 0u; i < buf.size(); i++) {
+        EXPECT_EQ((int)TestGaloisField::multiply(29u, i), (int)buf[i]) << "Buffers differ at index " << i;
+    }
+}
+
+#if defined(USE_SIMD_X86)
+/* Check each SIMD kernel that the CPU supports, not just the one selected at run time. */
+template <typename TestGaloisField, typename Kernel>
+void test_region_kernel(Kernel kernel, std::size_t m) {
+    using gf_t = typename TestGaloisField::gf_t;
+    test_region_operations<TestGaloisField>(
+        [&](gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+            auto table = TestGaloisField::split_table(c);
+            std::size_t i = kernel(std::false_type{}, dst, src, table, len);
+            Thiemar::Detail::mul_region_generic<gf_t, false>(&dst[i], &src[i], table, len - i);
+        },
+        [&](gf_t *dst, const gf_t *src, gf_t c, std::size_t len) {
+            auto table = TestGaloisField::split_table(c);
+            std::size_t i = kernel(std::true_type{}, dst, src, table, len);
+            Thiemar::Detail::mul_region_generic<gf_t, true>(&dst[i], &src[i], table, len - i);
+        }, m);
+}
+
+TEST(GaloisFieldRegionTest, SIMDKernels) {
+    using TestGaloisField = Thiemar::GaloisField<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+    using WideGaloisField = Thiemar::GaloisField<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>>;
+
+    test_region_kernel<TestGaloisField>([](auto acc, auto... args) {
+        return Thiemar::Detail::mul_region_ssse3<decltype(acc)::value>(args...); }, 8u);
+    test_region_kernel<WideGaloisField>([](auto acc, auto... args) {
+        return Thiemar::Detail::mul_region_ssse3<decltype(acc)::value>(args...); }, 10u);
+
+    if (Thiemar::Detail::cpu_supports_avx2()) {
+        test_region_kernel<TestGaloisField>([](auto acc, auto... args) {
+            return Thiemar::Detail::mul_region_avx2<decltype(acc)::value>(args...); }, 8u);
+        test_region_kernel<WideGaloisField>([](auto acc, auto... args) {
+            return Thiemar::Detail::mul_region_avx2<decltype(acc)::value>(args...); }, 10u);
+    }
+
+    if (Thiemar::Detail::cpu_supports_gfni()) {
+        test_region_kernel<TestGaloisField>([](auto acc, auto... args) {
+            return Thiemar::Detail::mul_region_gfni<decltype(acc)::value>(args...); }, 8u);
+    }
+}
+#endif
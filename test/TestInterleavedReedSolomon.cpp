@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ReedSolomon.h"
+
+#define MESSAGE_PARITY_LENGTH 32u
+#define MESSAGE_DATA_LENGTH 223u
+
+template <std::size_t Depth>
+using TestEncoder = Thiemar::ReedSolomon::InterleavedReedSolomonEncoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH, Depth>;
+
+template <std::size_t Depth>
+using TestDecoder = Thiemar::ReedSolomon::InterleavedReedSolomonDecoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH, Depth>;
+
+using ReferenceEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+
+template <std::size_t Depth>
+static std::vector<uint8_t> make_frame(std::size_t len) {
+    std::vector<uint8_t> frame((len + MESSAGE_PARITY_LENGTH) * Depth);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < len * Depth; i++) {
+        frame[i] = std::rand() & 0xffu;
+    }
+
+    return frame;
+}
+
+/* Compare against encoding each de-interleaved codeword separately. */
+template <std::size_t Depth>
+static void test_encode(std::size_t len) {
+    auto frame = make_frame<Depth>(len);
+    TestEncoder<Depth>::encode(frame.data(), len);
+
+    for (std::size_t l = 0u; l < Depth; l++) {
+        std::vector<uint8_t> codeword(len + MESSAGE_PARITY_LENGTH);
+        for (std::size_t i = 0u; i < len; i++) {
+            codeword[i] = frame[i * Depth + l];
+        }
+
+        ReferenceEncoder::encode(codeword.data(), len, &codeword[len]);
+        for (std::size_t j = 0u; j < MESSAGE_PARITY_LENGTH; j++) {
+            EXPECT_EQ((int)codeword[len + j], (int)frame[(len + j) * Depth + l])
+                << "Parity differs for codeword " << l << " at index " << j;
+        }
+    }
+}
+
+TEST(InterleavedReedSolomonTest, Encode) {
+    test_encode<1u>(MESSAGE_DATA_LENGTH);
+    test_encode<5u>(MESSAGE_DATA_LENGTH);
+    test_encode<16u>(MESSAGE_DATA_LENGTH);
+    test_encode<20u>(100u);
+    test_encode<32u>(MESSAGE_DATA_LENGTH);
+}
+
+TEST(InterleavedReedSolomonTest, EncodeArray) {
+    std::array<uint8_t, (MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH) * 4u> frame = {};
+    auto reference = make_frame<4u>(MESSAGE_DATA_LENGTH);
+    std::copy(reference.begin(), reference.end(), frame.begin());
+
+    TestEncoder<4u>::encode<MESSAGE_DATA_LENGTH>(frame);
+    TestEncoder<4u>::encode(reference.data(), MESSAGE_DATA_LENGTH);
+    EXPECT_TRUE(std::equal(frame.begin(), frame.end(), reference.begin()));
+}
+
+template <std::size_t Depth>
+static void test_decode_burst(std::size_t len, std::size_t burst_start, std::size_t burst_len,
+        std::ptrdiff_t expected) {
+    auto frame = make_frame<Depth>(len);
+    TestEncoder<Depth>::encode(frame.data(), len);
+    auto reference = frame;
+
+    for (std::size_t i = burst_start; i < burst_start + burst_len; i++) {
+        frame[i] ^= 0x5au;
+    }
+
+    EXPECT_EQ(expected, TestDecoder<Depth>::decode(frame.data(), len + MESSAGE_PARITY_LENGTH));
+    if (expected >= 0) {
+        EXPECT_EQ(reference, frame);
+    }
+}
+
+TEST(InterleavedReedSolomonTest, Decode) {
+    /* No errors. */
+    test_decode_burst<5u>(MESSAGE_DATA_LENGTH, 0u, 0u, 0);
+
+    /* A burst of Depth * 16 symbols puts 16 errors in every codeword, which is the limit. */
+    test_decode_burst<5u>(MESSAGE_DATA_LENGTH, 300u, 5u * 16u, 5 * 16);
+    test_decode_burst<16u>(MESSAGE_DATA_LENGTH, 1000u, 16u * 16u, 16 * 16);
+    test_decode_burst<20u>(MESSAGE_DATA_LENGTH, 0u, 37u, 37);
+    test_decode_burst<32u>(100u, (100u + MESSAGE_PARITY_LENGTH) * 32u - 50u, 50u, 50);
+
+    /* Errors in a single codeword. */
+    test_decode_burst<8u>(MESSAGE_DATA_LENGTH, 1000u, 1u, 1);
+}
+
+TEST(InterleavedReedSolomonTest, DecodeTooManyErrors) {
+    /* 17 errors in each codeword. */
+    test_decode_burst<4u>(MESSAGE_DATA_LENGTH, 40u, 4u * 17u, -1);
+}
+
+TEST(InterleavedReedSolomonTest, DecodeArray) {
+    std::array<uint8_t, (MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH) * 4u> frame = {};
+    auto reference = make_frame<4u>(MESSAGE_DATA_LENGTH);
+    TestEncoder<4u>::encode(reference.data(), MESSAGE_DATA_LENGTH);
+    std::copy(reference.begin(), reference.end(), frame.begin());
+
+    frame[10u] ^= 1u;
+    frame[500u] ^= 2u;
+    EXPECT_EQ(2, TestDecoder<4u>::decode<MESSAGE_DATA_LENGTH>(frame));
+    EXPECT_TRUE(std::equal(frame.begin(), frame.end(), reference.begin()));
+}
+
+TEST(InterleavedReedSolomonTest, DecodeInvalidLength) {
+    /* A frame of 3 codewords of 300 symbols, which is longer than the field allows. */
+    std::vector<uint8_t> frame(300u * 3u, 1u);
+    auto received = frame;
+
+    EXPECT_EQ(-1, TestDecoder<3u>::decode(frame.data(), 300u));
+    EXPECT_EQ(-1, TestDecoder<3u>::decode(frame.data(), MESSAGE_PARITY_LENGTH - 1u));
+    EXPECT_TRUE(received == frame);
+}
+
+TEST(InterleavedReedSolomonTest, EncodeInvalidLength) {
+    /* Message lengths which would make the codewords longer than the field. */
+    std::vector<uint8_t> frame(256u * 3u, 1u);
+    auto original = frame;
+
+    EXPECT_FALSE(TestEncoder<3u>::encode(frame.data(), MESSAGE_DATA_LENGTH + 1u));
+    EXPECT_TRUE(original == frame);
+    EXPECT_TRUE(TestEncoder<3u>::encode(frame.data(), MESSAGE_DATA_LENGTH));
+}
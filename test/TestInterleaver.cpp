@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
 #include "FEC/Interleaver.h"
+#include "FEC/Convolutional.h"
 
 TEST(InterleaverTest, NonPuncturing) {
     using TestInterleaver = Thiemar::Convolutional::Interleaver<
@@ -217,3 +218,52 @@ TEST(DeinterleaverTest, LargeBlockSize) {
     EXPECT_EQ(0x0B58920400000000u, in_reconstructed[4]);
     EXPECT_EQ(0xA48C4B4A00000000u, in_reconstructed[5]);
 }
+
+#if defined(USE_SIMD_X86)
+/* Check the BMI2 backend against the generic shift/mask implementation. */
+template <typename PuncturingMatrix, std::size_t NumPoly, std::size_t BlockSize>
+void test_bmi2_interleaver() {
+    using TestInterleaver = Thiemar::Convolutional::Interleaver<PuncturingMatrix, NumPoly, BlockSize>;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 16u; n++) {
+        std::array<Thiemar::bool_vec_t, TestInterleaver::in_buf_len()> in;
+        std::array<uint8_t, TestInterleaver::out_buf_len()> in_bytes;
+        for (std::size_t i = 0u; i < in.size(); i++) {
+            in[i] = ((Thiemar::bool_vec_t)std::rand() << 40u) ^ ((Thiemar::bool_vec_t)std::rand() << 20u) ^ std::rand();
+        }
+        for (std::size_t i = 0u; i < in_bytes.size(); i++) {
+            in_bytes[i] = std::rand() & 0xffu;
+        }
+
+        auto out = TestInterleaver::interleave_generic(in);
+        auto out_bmi2 = TestInterleaver::interleave_bmi2(in);
+        for (std::size_t i = 0u; i < out.size(); i++) {
+            EXPECT_EQ((int)out[i], (int)out_bmi2[i]) << "Buffers differ at index " << i;
+        }
+
+        auto in_reconstructed = TestInterleaver::deinterleave_generic(in_bytes);
+        auto in_reconstructed_bmi2 = TestInterleaver::deinterleave_bmi2(in_bytes);
+        for (std::size_t i = 0u; i < in_reconstructed.size(); i++) {
+            EXPECT_EQ(in_reconstructed[i], in_reconstructed_bmi2[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+TEST(InterleaverTest, BMI2) {
+    using namespace Thiemar::Convolutional;
+
+    if (!Thiemar::Detail::cpu_supports_bmi2()) {
+        return;
+    }
+
+    test_bmi2_interleaver<PuncturingMatrices::n_2_rate_1_2, 2u, 8u>();
+    test_bmi2_interleaver<PuncturingMatrices::n_2_rate_2_3, 2u, 8u>();
+    test_bmi2_interleaver<PuncturingMatrices::n_2_rate_3_4, 2u, 6u>();
+    test_bmi2_interleaver<PuncturingMatrices::n_2_rate_5_6, 2u, 5u>();
+    test_bmi2_interleaver<PuncturingMatrices::n_2_rate_5_6, 2u, 20u>();
+    test_bmi2_interleaver<PuncturingMatrices::n_2_rate_7_8, 2u, 7u>();
+    test_bmi2_interleaver<PuncturingMatrices::n_3_rate_1_3, 3u, 8u>();
+}
+#endif
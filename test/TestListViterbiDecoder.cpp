@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include "FEC/Convolutional.h"
+#include "FEC/CRC.h"
+
+using TestEncoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_2_3,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+template <std::size_t ListSize>
+using TestDecoder = Thiemar::Convolutional::PuncturedListViterbiDecoder<
+    7u,
+    ListSize,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_2_3,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+using TestCRC = Thiemar::CRCs::lte_16;
+
+/* Convert encoded bytes to 8-bit LLRs for BPSK with additive Gaussian noise. */
+template <std::size_t Len>
+std::array<int8_t, Len * 8u> make_llrs(const std::array<uint8_t, Len> &in, float sigma) {
+    std::array<int8_t, Len * 8u> out;
+    for (std::size_t i = 0u; i < Len * 8u; i++) {
+        float symbol = (in[i / 8u] & (0x80u >> (i % 8u))) ? -1.0f : 1.0f;
+        float u1 = ((float)std::rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+        float u2 = (float)std::rand() / (float)RAND_MAX;
+        float noise = sigma * std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318531f * u2);
+
+        out[i] = (int8_t)std::max(-127.0f, std::min(127.0f, std::round(32.0f * (symbol + noise))));
+    }
+
+    return out;
+}
+
+/* Generate a random message with the CRC appended. */
+template <std::size_t Len>
+std::array<uint8_t, Len> make_message() {
+    std::array<uint8_t, Len> out;
+    for (std::size_t i = 0u; i < Len - TestCRC::size(); i++) {
+        out[i] = std::rand() & 0xffu;
+    }
+
+    TestCRC::crc_t crc = TestCRC::calculate(out.data(), Len - TestCRC::size());
+    for (std::size_t i = 0u; i < TestCRC::size(); i++) {
+        out[Len - TestCRC::size() + i] = (crc >> ((TestCRC::size() - 1u - i) * 8u)) & 0xffu;
+    }
+
+    return out;
+}
+
+TEST(ListViterbiDecoderTest, Decode) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    auto test_in = make_message<20u>();
+    auto test_out = TestEncoder::encode(test_in);
+    auto test_decoded = TestDecoder<4u>::decode<test_in.size()>(make_llrs(test_out, 0.0f),
+        [](const auto &out) { return TestCRC::check(out); });
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(ListViterbiDecoderTest, DecodeFailedCheck) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    auto test_in = make_message<20u>();
+    auto test_llrs = make_llrs(TestEncoder::encode(test_in), 0.7f);
+
+    /* With no candidate passing, the maximum likelihood path is returned. */
+    auto test_decoded_list = TestDecoder<8u>::decode<test_in.size()>(test_llrs, [](const auto &) { return false; });
+    auto test_decoded = TestDecoder<1u>::decode<test_in.size()>(test_llrs, [](const auto &) { return false; });
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_decoded[i], (int)test_decoded_list[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(ListViterbiDecoderTest, DecodeNoisy) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    /* Count frames decoded correctly at an Eb/N0 of 2.5 dB, rate 2/3. */
+    std::size_t correct_viterbi = 0u, correct_list = 0u;
+    for (std::size_t i = 0u; i < 200u; i++) {
+        auto test_in = make_message<20u>();
+        auto test_llrs = make_llrs(TestEncoder::encode(test_in), 0.6490f);
+
+        auto check = [](const auto &out) { return TestCRC::check(out); };
+        correct_viterbi += TestDecoder<1u>::decode<test_in.size()>(test_llrs, check) == test_in;
+        correct_list += TestDecoder<8u>::decode<test_in.size()>(test_llrs, check) == test_in;
+    }
+
+    EXPECT_GT(correct_list, correct_viterbi);
+    EXPECT_GT(correct_list, 180u);
+}
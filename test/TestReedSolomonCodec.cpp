@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ReedSolomon.h"
+
+using TestCodec = Thiemar::ReedSolomon::ReedSolomonCodec<8u, Thiemar::ReedSolomon::Polynomials::m_8_285>;
+
+/* Corrupt 'n' distinct symbols of 'buf' with non-zero error values, returning their positions. */
+static std::vector<std::size_t> add_errors(std::vector<uint8_t> &buf, std::size_t n) {
+    std::vector<std::size_t> positions(buf.size());
+    for (std::size_t i = 0u; i < buf.size(); i++) {
+        positions[i] = i;
+    }
+
+    for (std::size_t i = 0u; i < n; i++) {
+        std::swap(positions[i], positions[i + std::rand() % (buf.size() - i)]);
+        buf[positions[i]] ^= 1u + std::rand() % 255u;
+    }
+
+    positions.resize(n);
+    return positions;
+}
+
+template <std::size_t Parity>
+static void test_matches_encoder(std::size_t len) {
+    using Encoder = Thiemar::ReedSolomon::ReedSolomonEncoder<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, Parity>;
+    TestCodec codec(Parity);
+    std::vector<uint8_t> message(len);
+    std::array<uint8_t, Parity> expected, parity;
+
+    for (std::size_t i = 0u; i < len; i++) {
+        message[i] = std::rand() & 0xffu;
+    }
+
+    Encoder::encode(message.data(), len, expected.data());
+    ASSERT_TRUE(codec.encode(message.data(), len, parity.data()));
+    for (std::size_t j = 0u; j < Parity; j++) {
+        EXPECT_EQ((int)expected[j], (int)parity[j]) << "Parity differs at index " << j;
+    }
+}
+
+TEST(ReedSolomonCodecTest, MatchesEncoder) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    /* Cover each packed register width, including partial words. */
+    test_matches_encoder<1u>(100u);
+    test_matches_encoder<8u>(223u);
+    test_matches_encoder<16u>(10u);
+    test_matches_encoder<23u>(232u);
+    test_matches_encoder<32u>(223u);
+    test_matches_encoder<64u>(191u);
+}
+
+TEST(ReedSolomonCodecTest, DecodeRuntimeParameters) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    for (std::size_t parity : { 2u, 7u, 16u, 32u, 50u }) {
+        TestCodec codec(parity);
+        ASSERT_TRUE(codec.valid());
+        EXPECT_EQ(parity, codec.parity_length());
+
+        for (std::size_t len : std::initializer_list<std::size_t>{ 1u, 20u, 255u - parity }) {
+            std::vector<uint8_t> buf(len + parity);
+            for (std::size_t i = 0u; i < len; i++) {
+                buf[i] = std::rand() & 0xffu;
+            }
+
+            ASSERT_TRUE(codec.encode(buf.data(), len));
+            EXPECT_EQ(0, codec.decode(buf.data(), buf.size()));
+
+            for (std::size_t errors : std::initializer_list<std::size_t>{ 1u, parity / 2u }) {
+                auto corrupted = buf;
+                add_errors(corrupted, errors);
+                EXPECT_EQ((std::ptrdiff_t)errors, codec.decode(corrupted.data(), corrupted.size()));
+                EXPECT_TRUE(std::equal(buf.begin(), buf.end(), corrupted.begin()))
+                    << "parity " << parity << ", length " << len;
+            }
+        }
+    }
+}
+
+TEST(ReedSolomonCodecTest, DecodeErasures) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    TestCodec codec(20u);
+    std::vector<uint8_t> buf(150u);
+    for (std::size_t i = 0u; i < 130u; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    ASSERT_TRUE(codec.encode(buf.data(), 130u));
+
+    /* Six erasures and seven errors uses all of the parity. */
+    auto corrupted = buf;
+    auto positions = add_errors(corrupted, 13u);
+    EXPECT_EQ(13, codec.decode(corrupted.data(), corrupted.size(), positions.data(), 6u));
+    EXPECT_TRUE(std::equal(buf.begin(), buf.end(), corrupted.begin()));
+
+    /* More erasures than parity symbols can't be corrected. */
+    std::vector<std::size_t> erasures(21u);
+    for (std::size_t i = 0u; i < erasures.size(); i++) {
+        erasures[i] = i;
+    }
+
+    EXPECT_EQ(-1, codec.decode(buf.data(), buf.size(), erasures.data(), erasures.size()));
+}
+
+TEST(ReedSolomonCodecTest, SharedTables) {
+    EXPECT_EQ(TestCodec::get_tables(16u), TestCodec::get_tables(16u));
+    EXPECT_NE(TestCodec::get_tables(16u), TestCodec::get_tables(17u));
+    EXPECT_EQ(nullptr, TestCodec::get_tables(0u));
+    EXPECT_EQ(nullptr, TestCodec::get_tables(65u));
+}
+
+TEST(ReedSolomonCodecTest, InvalidParameters) {
+    TestCodec codec(65u);
+    std::vector<uint8_t> buf(100u);
+    EXPECT_FALSE(codec.valid());
+    EXPECT_FALSE(codec.encode(buf.data(), 10u));
+    EXPECT_EQ(-1, codec.decode(buf.data(), buf.size()));
+    EXPECT_FALSE(codec.is_valid_codeword(buf.data(), buf.size()));
+
+    std::array<uint8_t, 64u> syndromes;
+    syndromes.fill(1u);
+    EXPECT_FALSE(codec.calculate_syndromes(buf.data(), buf.size(), syndromes));
+    EXPECT_TRUE(std::all_of(syndromes.begin(), syndromes.end(), [](uint8_t s) { return s == 0u; }));
+
+    /* Messages longer than the field allows are rejected. */
+    TestCodec valid_codec(32u);
+    std::vector<uint8_t> long_buf(300u);
+    EXPECT_FALSE(valid_codec.encode(long_buf.data(), 224u));
+    EXPECT_TRUE(valid_codec.encode(long_buf.data(), 223u));
+
+    /* Codewords shorter than the parity or longer than the field have no syndromes. */
+    long_buf[0u] ^= 1u;
+    syndromes.fill(1u);
+    EXPECT_FALSE(valid_codec.calculate_syndromes(long_buf.data(), 31u, syndromes));
+    EXPECT_TRUE(std::all_of(syndromes.begin(), syndromes.end(), [](uint8_t s) { return s == 0u; }));
+    EXPECT_FALSE(valid_codec.calculate_syndromes(long_buf.data(), 256u, syndromes));
+    EXPECT_TRUE(valid_codec.calculate_syndromes(long_buf.data(), 255u, syndromes));
+}
+
+TEST(ReedSolomonCodecTest, DecodeLargeField) {
+    using LargeCodec = Thiemar::ReedSolomon::ReedSolomonCodec<
+        10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>>;
+    using LargeEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>, 12u>;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    LargeCodec codec(12u);
+    std::vector<uint16_t> buf(600u + 12u);
+    for (std::size_t i = 0u; i < 600u; i++) {
+        buf[i] = std::rand() & 0x3ffu;
+    }
+
+    std::array<uint16_t, 12u> expected;
+    LargeEncoder::encode(buf.data(), 600u, expected.data());
+    ASSERT_TRUE(codec.encode(buf.data(), 600u));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), buf.begin() + 600));
+
+    auto corrupted = buf;
+    corrupted[0u] ^= 0x155u;
+    corrupted[300u] ^= 0x3ffu;
+    corrupted[611u] ^= 0x001u;
+    EXPECT_EQ(3, codec.decode(corrupted.data(), corrupted.size()));
+    EXPECT_TRUE(std::equal(buf.begin(), buf.end(), corrupted.begin()));
+}
+
+TEST(ReedSolomonCodecTest, IsValidCodeword) {
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    for (std::size_t parity : { 4u, 13u, 40u }) {
+        TestCodec codec(parity);
+        std::vector<uint8_t> buf(100u + parity);
+        for (std::size_t i = 0u; i < 100u; i++) {
+            buf[i] = std::rand() & 0xffu;
+        }
+
+        ASSERT_TRUE(codec.encode(buf.data(), 100u));
+        EXPECT_TRUE(codec.is_valid_codeword(buf.data(), buf.size()));
+
+        buf[57u] ^= 0x80u;
+        EXPECT_FALSE(codec.is_valid_codeword(buf.data(), buf.size()));
+    }
+}
@@ -0,0 +1,384 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ReedSolomon.h"
+
+#define MESSAGE_PARITY_LENGTH 32u
+#define MESSAGE_DATA_LENGTH 223u
+
+using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<
+    8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+
+/* Corrupt 'n' distinct symbols of 'buf' with non-zero error values. */
+template <std::size_t N>
+static void add_errors(std::array<uint8_t, N> &buf, std::size_t n) {
+    std::array<std::size_t, N> positions;
+    for (std::size_t i = 0u; i < N; i++) {
+        positions[i] = i;
+    }
+
+    for (std::size_t i = 0u; i < n; i++) {
+        std::swap(positions[i], positions[i + std::rand() % (N - i)]);
+        buf[positions[i]] ^= 1u + std::rand() % 255u;
+    }
+}
+
+template <std::size_t DataLength>
+static void test_decode(std::size_t num_errors) {
+    std::array<uint8_t, DataLength + MESSAGE_PARITY_LENGTH> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 20u; n++) {
+        /* The encoder expects the parity symbols to be zero. */
+        buf = {};
+        for (std::size_t i = 0u; i < DataLength; i++) {
+            buf[i] = std::rand() & 0xffu;
+        }
+
+        TestEncoder::encode<DataLength>(buf);
+        auto corrupted = buf;
+        add_errors(corrupted, num_errors);
+
+        EXPECT_EQ((std::ptrdiff_t)num_errors, TestDecoder::decode<DataLength>(corrupted));
+        for (std::size_t i = 0u; i < buf.size(); i++) {
+            EXPECT_EQ((int)buf[i], (int)corrupted[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+TEST(ReedSolomonDecoderTest, NoErrors) {
+    test_decode<MESSAGE_DATA_LENGTH>(0u);
+}
+
+TEST(ReedSolomonDecoderTest, Decode) {
+    test_decode<MESSAGE_DATA_LENGTH>(1u);
+    test_decode<MESSAGE_DATA_LENGTH>(MESSAGE_PARITY_LENGTH / 4u);
+    test_decode<MESSAGE_DATA_LENGTH>(MESSAGE_PARITY_LENGTH / 2u);
+}
+
+TEST(ReedSolomonDecoderTest, DecodeShortened) {
+    test_decode<20u>(3u);
+    test_decode<100u>(MESSAGE_PARITY_LENGTH / 2u);
+}
+
+/* Check syndromes against Horner's rule with field arithmetic, for every length up to 'max_len'. */
+template <std::size_t M, typename Primitive, std::size_t Parity,
+    typename Backend = Thiemar::GaloisFieldBackends::Tables>
+static void test_syndromes(std::size_t max_len) {
+    using gf = Thiemar::GaloisField<M, Primitive>;
+    using gf_t = typename gf::gf_t;
+    using Decoder = Thiemar::ReedSolomon::ReedSolomonDecoder<M, Primitive, Parity, Backend>;
+    std::vector<gf_t> buf(max_len);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < buf.size(); i++) {
+        buf[i] = std::rand() & ((1u << M) - 1u);
+    }
+
+    /* Every length, so that each partial leading chunk is covered. */
+    for (std::size_t len = 1u; len <= buf.size(); len++) {
+        std::array<gf_t, Parity> syndromes;
+        Decoder::calculate_syndromes(buf.data(), len, syndromes);
+
+        for (std::size_t j = 0u; j < Parity; j++) {
+            gf_t expected = 0u;
+            for (std::size_t i = 0u; i < len; i++) {
+                expected = gf::multiply(expected, gf::antilog(j + 1u)) ^ buf[i];
+            }
+
+            EXPECT_EQ((int)expected, (int)syndromes[j]) << "Syndrome " << j << " differs for length " << len;
+        }
+    }
+}
+
+TEST(ReedSolomonDecoderTest, Syndromes) {
+    test_syndromes<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>(255u);
+    test_syndromes<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>, 300u>(400u);
+    test_syndromes<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 9u>(200u);
+}
+
+TEST(ReedSolomonDecoderTest, SyndromesCarryless) {
+    using Carryless = Thiemar::GaloisFieldBackends::Carryless;
+    test_syndromes<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH, Carryless>(255u);
+    test_syndromes<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>, 13u, Carryless>(400u);
+    test_syndromes<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 9u, Carryless>(200u);
+}
+
+TEST(ReedSolomonDecoderTest, IsValidCodeword) {
+    std::array<uint8_t, MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+        buf[i] = std::rand() & 0xffu;
+    }
+
+    TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+    EXPECT_TRUE(TestDecoder::is_valid_codeword(buf.data(), buf.size()));
+
+    /* A single error anywhere makes the codeword invalid. */
+    for (std::size_t i = 0u; i < buf.size(); i++) {
+        buf[i] ^= 0x01u;
+        EXPECT_FALSE(TestDecoder::is_valid_codeword(buf.data(), buf.size())) << "Error at index " << i;
+        buf[i] ^= 0x01u;
+    }
+
+    /* Shortened codewords are valid with their leading zeros dropped. */
+    std::array<uint8_t, 20u + MESSAGE_PARITY_LENGTH> shortened = {};
+    std::copy_n(buf.begin(), 20u, shortened.begin());
+    TestEncoder::encode<20u>(shortened);
+    EXPECT_TRUE(TestDecoder::is_valid_codeword(shortened.data(), shortened.size()));
+}
+
+TEST(ReedSolomonDecoderTest, DecodeFailure) {
+    std::array<uint8_t, MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 20u; n++) {
+        buf = {};
+        for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+            buf[i] = std::rand() & 0xffu;
+        }
+
+        TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+        auto corrupted = buf;
+        add_errors(corrupted, MESSAGE_PARITY_LENGTH / 2u + 1u);
+        auto received = corrupted;
+
+        /*
+        With more than t errors the decoder either fails and leaves the
+        codeword alone, or decodes to some other valid codeword.
+        */
+        std::ptrdiff_t result = TestDecoder::decode<MESSAGE_DATA_LENGTH>(corrupted);
+        if (result < 0) {
+            EXPECT_TRUE(received == corrupted);
+        } else {
+            std::array<uint8_t, MESSAGE_PARITY_LENGTH> syndromes;
+            EXPECT_FALSE(TestDecoder::calculate_syndromes(corrupted.data(), corrupted.size(), syndromes));
+            EXPECT_FALSE(buf == corrupted);
+        }
+    }
+}
+
+TEST(ReedSolomonDecoderTest, DecodeSmallField) {
+    using SmallEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<4u, Thiemar::BinarySequence<1, 0, 0, 1, 1>, 4u>;
+    using SmallDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<4u, Thiemar::BinarySequence<1, 0, 0, 1, 1>, 4u>;
+    std::array<uint8_t, 15u> buf = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 100u; n++) {
+        buf = {};
+        for (std::size_t i = 0u; i < 11u; i++) {
+            buf[i] = std::rand() & 0xfu;
+        }
+
+        SmallEncoder::encode<11u>(buf);
+        auto corrupted = buf;
+        std::size_t p1 = std::rand() % 15u, p2 = (p1 + 1u + std::rand() % 14u) % 15u;
+        corrupted[p1] ^= 1u + std::rand() % 15u;
+        corrupted[p2] ^= 1u + std::rand() % 15u;
+
+        EXPECT_EQ(2, SmallDecoder::decode<11u>(corrupted));
+        EXPECT_TRUE(buf == corrupted);
+    }
+}
+
+TEST(ReedSolomonDecoderTest, DecodeLargeField) {
+    using LargeEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 32u>;
+    using LargeDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 32u>;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+
+    /* Frames far longer than a GF(2^8) codeword, up to the full length. */
+    for (std::size_t len : { 1000u, 8000u, 65503u }) {
+        std::vector<uint16_t> buf(len + 32u);
+        for (std::size_t i = 0u; i < len; i++) {
+            buf[i] = std::rand() & 0xffffu;
+        }
+
+        LargeEncoder::encode(buf.data(), len, &buf[len]);
+        EXPECT_TRUE(LargeDecoder::is_valid_codeword(buf.data(), buf.size()));
+
+        /* Ten errors and twelve erasures. */
+        auto corrupted = buf;
+        std::array<std::size_t, 22u> positions;
+        for (std::size_t i = 0u; i < positions.size(); i++) {
+            positions[i] = (i * buf.size()) / positions.size() + std::rand() % 10u;
+            corrupted[positions[i]] ^= 1u + std::rand() % 0xffffu;
+        }
+
+        EXPECT_EQ(22, LargeDecoder::decode(corrupted.data(), corrupted.size(), &positions[10u], 12u));
+        EXPECT_TRUE(buf == corrupted) << "Length " << len;
+    }
+}
+
+/*
+The carry-less backend corrects the same codewords as the table backend,
+with the same results, for errors and erasures together.
+*/
+template <std::size_t M, typename Primitive, std::size_t Parity>
+static void test_decode_carryless(std::size_t len, std::size_t num_errors, std::size_t num_erasures) {
+    using Encoder = Thiemar::ReedSolomon::ReedSolomonEncoder<M, Primitive, Parity>;
+    using TableDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<M, Primitive, Parity>;
+    using CarrylessDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<M, Primitive, Parity,
+        Thiemar::GaloisFieldBackends::Carryless>;
+    using gf_t = typename Thiemar::GaloisField<M, Primitive>::gf_t;
+    std::vector<gf_t> buf(len + Parity);
+    std::vector<std::size_t> positions(buf.size());
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 10u; n++) {
+        for (std::size_t i = 0u; i < len; i++) {
+            buf[i] = std::rand() & ((1u << M) - 1u);
+        }
+
+        Encoder::encode(buf.data(), len, &buf[len]);
+        EXPECT_TRUE(CarrylessDecoder::is_valid_codeword(buf.data(), buf.size()));
+
+        auto corrupted = buf;
+        for (std::size_t i = 0u; i < positions.size(); i++) {
+            positions[i] = i;
+        }
+
+        for (std::size_t i = 0u; i < num_errors + num_erasures; i++) {
+            std::swap(positions[i], positions[i + std::rand() % (positions.size() - i)]);
+            corrupted[positions[i]] ^= 1u + std::rand() % ((1u << M) - 1u);
+        }
+
+        auto table_corrected = corrupted;
+        EXPECT_EQ((std::ptrdiff_t)(num_errors + num_erasures), CarrylessDecoder::decode(
+            corrupted.data(), corrupted.size(), &positions[num_errors], num_erasures));
+        EXPECT_EQ((std::ptrdiff_t)(num_errors + num_erasures), TableDecoder::decode(
+            table_corrected.data(), table_corrected.size(), &positions[num_errors], num_erasures));
+        EXPECT_TRUE(buf == corrupted);
+        EXPECT_TRUE(table_corrected == corrupted);
+    }
+}
+
+TEST(ReedSolomonDecoderTest, DecodeCarryless) {
+    using Primitive8 = Thiemar::ReedSolomon::Polynomials::m_8_285;
+    using Primitive16 = Thiemar::ReedSolomon::Polynomials::m_16_69643;
+    test_decode_carryless<8u, Primitive8, MESSAGE_PARITY_LENGTH>(MESSAGE_DATA_LENGTH, 0u, 0u);
+    test_decode_carryless<8u, Primitive8, MESSAGE_PARITY_LENGTH>(MESSAGE_DATA_LENGTH, MESSAGE_PARITY_LENGTH / 2u, 0u);
+    test_decode_carryless<8u, Primitive8, MESSAGE_PARITY_LENGTH>(100u, 5u, 21u);
+    test_decode_carryless<16u, Primitive16, 32u>(8000u, 10u, 12u);
+}
+
+/*
+Corrupt 'num_erasures' symbols at positions which are reported as erasures,
+and 'num_errors' other symbols which are not.
+*/
+template <std::size_t DataLength>
+static void test_decode_erasures(std::size_t num_errors, std::size_t num_erasures) {
+    std::array<uint8_t, DataLength + MESSAGE_PARITY_LENGTH> buf = {};
+    std::array<std::size_t, DataLength + MESSAGE_PARITY_LENGTH> positions;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 20u; n++) {
+        buf = {};
+        for (std::size_t i = 0u; i < DataLength; i++) {
+            buf[i] = std::rand() & 0xffu;
+        }
+
+        TestEncoder::encode<DataLength>(buf);
+        auto corrupted = buf;
+
+        for (std::size_t i = 0u; i < positions.size(); i++) {
+            positions[i] = i;
+        }
+
+        for (std::size_t i = 0u; i < num_errors + num_erasures; i++) {
+            std::swap(positions[i], positions[i + std::rand() % (positions.size() - i)]);
+            corrupted[positions[i]] ^= 1u + std::rand() % 255u;
+        }
+
+        EXPECT_EQ((std::ptrdiff_t)(num_errors + num_erasures),
+            TestDecoder::decode<DataLength>(corrupted, &positions[num_errors], num_erasures));
+        for (std::size_t i = 0u; i < buf.size(); i++) {
+            EXPECT_EQ((int)buf[i], (int)corrupted[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+TEST(ReedSolomonDecoderTest, DecodeErasures) {
+    test_decode_erasures<MESSAGE_DATA_LENGTH>(0u, 1u);
+    test_decode_erasures<MESSAGE_DATA_LENGTH>(0u, MESSAGE_PARITY_LENGTH);
+    test_decode_erasures<100u>(0u, MESSAGE_PARITY_LENGTH - 3u);
+}
+
+TEST(ReedSolomonDecoderTest, DecodeErrorsAndErasures) {
+    test_decode_erasures<MESSAGE_DATA_LENGTH>(1u, MESSAGE_PARITY_LENGTH - 2u);
+    test_decode_erasures<MESSAGE_DATA_LENGTH>(MESSAGE_PARITY_LENGTH / 4u, MESSAGE_PARITY_LENGTH / 2u);
+    test_decode_erasures<MESSAGE_DATA_LENGTH>(MESSAGE_PARITY_LENGTH / 2u - 1u, 2u);
+    test_decode_erasures<50u>(5u, 21u);
+}
+
+TEST(ReedSolomonDecoderTest, DecodeSharedErasureLocator) {
+    /* Several codewords lose the same symbols, so the erasure locator is calculated once. */
+    std::array<std::size_t, 12u> erasures = { 0u, 3u, 17u, 18u, 19u, 20u, 100u, 150u, 200u, 230u, 253u, 254u };
+    TestDecoder::ErasureLocator locator;
+    ASSERT_TRUE(TestDecoder::calculate_erasure_locator(erasures.data(), erasures.size(),
+        MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH, locator));
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t n = 0u; n < 8u; n++) {
+        std::array<uint8_t, MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH> buf = {};
+        for (std::size_t i = 0u; i < MESSAGE_DATA_LENGTH; i++) {
+            buf[i] = std::rand() & 0xffu;
+        }
+
+        TestEncoder::encode<MESSAGE_DATA_LENGTH>(buf);
+        auto corrupted = buf;
+        for (std::size_t e : erasures) {
+            corrupted[e] = 0u;
+        }
+
+        /* Add errors in some of the codewords too. */
+        corrupted[50u] ^= (n % 2u) ? 0x10u : 0u;
+
+        EXPECT_EQ((std::ptrdiff_t)(erasures.size() + n % 2u),
+            TestDecoder::decode(corrupted.data(), corrupted.size(), locator));
+        EXPECT_TRUE(buf == corrupted);
+    }
+}
+
+TEST(ReedSolomonDecoderTest, DecodeTooManyErasures) {
+    std::array<uint8_t, MESSAGE_DATA_LENGTH + MESSAGE_PARITY_LENGTH> buf = {};
+    std::array<std::size_t, MESSAGE_PARITY_LENGTH + 1u> erasures;
+    for (std::size_t i = 0u; i < erasures.size(); i++) {
+        erasures[i] = i;
+        buf[i] = 1u;
+    }
+
+    auto received = buf;
+    EXPECT_EQ(-1, TestDecoder::decode<MESSAGE_DATA_LENGTH>(buf, erasures.data(), erasures.size()));
+    EXPECT_TRUE(received == buf);
+}
+
+TEST(ReedSolomonDecoderTest, DecodeInvalidLength) {
+    std::vector<uint8_t> buf(300u, 1u);
+    auto received = buf;
+
+    /* Longer than the field, where error positions would alias. */
+    EXPECT_EQ(-1, TestDecoder::decode(buf.data(), 256u));
+    EXPECT_FALSE(TestDecoder::is_valid_codeword(buf.data(), 256u));
+
+    /* Shorter than the parity, so not a codeword at all. */
+    EXPECT_EQ(-1, TestDecoder::decode(buf.data(), MESSAGE_PARITY_LENGTH - 1u));
+    EXPECT_FALSE(TestDecoder::is_valid_codeword(buf.data(), MESSAGE_PARITY_LENGTH - 1u));
+
+    std::size_t erasures[] = { 0u };
+    EXPECT_EQ(-1, TestDecoder::decode(buf.data(), 256u, erasures, 1u));
+    EXPECT_TRUE(received == buf);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <cstdlib>
+#include <vector>
 #include "FEC/ReedSolomon.h"
 
 /* Test against ezpwd implementation. */
@@ -45,3 +46,90 @@ TEST(ReedSolomonEncoderTest, Encode) {
         EXPECT_EQ((int)rs_container[i], (int)buf[i]) << "Buffers differ at index " << i;
     }
 }
+
+/* Check that every codeword has all-zero syndromes, whatever was in the parity symbols beforehand. */
+template <std::size_t M, typename Primitive, std::size_t Parity>
+static void test_encode_runtime_length(std::initializer_list<std::size_t> lengths) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<M, Primitive, Parity>;
+    using TestDecoder = Thiemar::ReedSolomon::ReedSolomonDecoder<M, Primitive, Parity>;
+    using gf_t = typename Thiemar::GaloisField<M, Primitive>::gf_t;
+
+    std::srand(123u);
+    for (std::size_t len : lengths) {
+        std::vector<gf_t> buf(len + Parity);
+        for (std::size_t i = 0u; i < buf.size(); i++) {
+            buf[i] = std::rand() & ((1u << M) - 1u);
+        }
+
+        TestEncoder::encode(buf.data(), len, &buf[len]);
+
+        std::array<gf_t, Parity> syndromes;
+        EXPECT_FALSE(TestDecoder::calculate_syndromes(buf.data(), buf.size(), syndromes)) << "Length " << len;
+    }
+}
+
+TEST(ReedSolomonEncoderTest, EncodeRuntimeLength) {
+    test_encode_runtime_length<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, 32u>({ 0u, 1u, 20u, 223u });
+    test_encode_runtime_length<8u, Thiemar::ReedSolomon::Polynomials::m_8_301, 5u>({ 1u, 7u, 250u });
+    test_encode_runtime_length<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>, 12u>({ 1u, 100u, 1000u });
+    test_encode_runtime_length<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 32u>({ 1u, 255u, 4000u, 65503u });
+    test_encode_runtime_length<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 7u>({ 3u, 1000u });
+}
+
+/* Check parity updates against re-encoding the modified message. */
+template <std::size_t M, typename Primitive, std::size_t Parity,
+    typename Backend = Thiemar::GaloisFieldBackends::Tables>
+static void test_update(std::size_t len) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<M, Primitive, Parity, Backend>;
+    using gf_t = typename Thiemar::GaloisField<M, Primitive>::gf_t;
+
+    std::srand(123u);
+    std::vector<gf_t> buf(len + Parity), reference(len + Parity);
+    for (std::size_t i = 0u; i < len; i++) {
+        buf[i] = std::rand() & ((1u << M) - 1u);
+    }
+
+    TestEncoder::encode(buf.data(), len, &buf[len]);
+
+    /* Single symbols, including the first and last message symbols. */
+    for (std::size_t offset : { (std::size_t)0u, len / 3u, len - 1u }) {
+        gf_t new_value = std::rand() & ((1u << M) - 1u);
+        TestEncoder::update(buf.data(), len, offset, buf[offset], new_value);
+
+        reference = buf;
+        TestEncoder::encode(reference.data(), len, &reference[len]);
+        EXPECT_EQ(new_value, buf[offset]);
+        EXPECT_EQ(reference, buf) << "Single symbol update at " << offset << " of " << len;
+    }
+
+    /* Contiguous ranges, including one that ends at the last message symbol. */
+    for (std::size_t offset : { (std::size_t)0u, len / 2u, len - 5u }) {
+        std::vector<gf_t> old_values(&buf[offset], &buf[offset + 5u]), new_values(5u);
+        for (gf_t &value : new_values) {
+            value = std::rand() & ((1u << M) - 1u);
+        }
+
+        TestEncoder::update(buf.data(), len, offset, old_values.data(), new_values.data(), 5u);
+
+        reference = buf;
+        TestEncoder::encode(reference.data(), len, &reference[len]);
+        EXPECT_EQ(reference, buf) << "Range update at " << offset << " of " << len;
+    }
+}
+
+TEST(ReedSolomonEncoderTest, Update) {
+    test_update<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, 32u>(223u);
+    test_update<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, 32u>(40u);
+    test_update<8u, Thiemar::ReedSolomon::Polynomials::m_8_301, 1u>(100u);
+    test_update<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>, 12u>(500u);
+    test_update<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 16u>(3000u);
+    test_update<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 32u>(65503u);
+    test_update<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 1u>(1000u);
+}
+
+TEST(ReedSolomonEncoderTest, UpdateCarryless) {
+    using Carryless = Thiemar::GaloisFieldBackends::Carryless;
+    test_update<8u, Thiemar::ReedSolomon::Polynomials::m_8_285, 32u, Carryless>(223u);
+    test_update<10u, Thiemar::BinarySequence<1, 0, 0, 0, 0, 0, 0, 1, 0, 0, 1>, 12u, Carryless>(500u);
+    test_update<16u, Thiemar::ReedSolomon::Polynomials::m_16_69643, 32u, Carryless>(65503u);
+}
@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+#include "FEC/Convolutional.h"
+
+/* Convert encoded bytes to 8-bit LLRs for BPSK with additive Gaussian noise. */
+template <std::size_t Len>
+std::array<int8_t, Len * 8u> make_llrs(const std::array<uint8_t, Len> &in, float sigma) {
+    std::array<int8_t, Len * 8u> out;
+    for (std::size_t i = 0u; i < Len * 8u; i++) {
+        float symbol = (in[i / 8u] & (0x80u >> (i % 8u))) ? -1.0f : 1.0f;
+        float u1 = ((float)std::rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+        float u2 = (float)std::rand() / (float)RAND_MAX;
+        float noise = sigma * std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318531f * u2);
+
+        out[i] = (int8_t)std::max(-127.0f, std::min(127.0f, std::round(32.0f * (symbol + noise))));
+    }
+
+    return out;
+}
+
+/* Check the depuncturer against a direct implementation. */
+template <typename PuncturingMatrix>
+void test_depuncturer() {
+    using Depuncturer = Thiemar::Convolutional::Depuncturer<PuncturingMatrix, 2u>;
+
+    /* Set up test buffers. */
+    std::array<int8_t, 301u> test_in;
+    std::array<uint8_t, 301u> test_erasures;
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = (int8_t)(std::rand() & 0xffu);
+        test_erasures[i] = (std::rand() % 5u) == 0u;
+    }
+
+    for (std::size_t steps : { 7u, 64u, 203u, 400u }) {
+        std::vector<int8_t> test_out(steps * 2u);
+        Depuncturer::depuncture(test_in.data(), test_erasures.data(), test_in.size(), test_out.data(), steps);
+
+        std::size_t idx = 0u;
+        for (std::size_t i = 0u; i < test_out.size(); i++) {
+            int8_t expected = 0;
+            if (PuncturingMatrix::test(i % PuncturingMatrix::size())) {
+                if (idx < test_in.size() && !test_erasures[idx]) {
+                    expected = test_in[idx];
+                }
+
+                idx++;
+            }
+
+            EXPECT_EQ((int)expected, (int)test_out[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
+
+TEST(DepuncturerTest, Depuncture) {
+    using namespace Thiemar::Convolutional;
+
+    test_depuncturer<PuncturingMatrices::n_2_rate_1_2>();
+    test_depuncturer<PuncturingMatrices::n_2_rate_2_3>();
+    test_depuncturer<PuncturingMatrices::n_2_rate_3_4>();
+    test_depuncturer<PuncturingMatrices::n_2_rate_5_6>();
+    test_depuncturer<PuncturingMatrices::n_2_rate_7_8>();
+}
+
+/* Encode, convert to noise-free LLRs, and decode. */
+template <std::size_t TracebackLength, typename PuncturingMatrix>
+void test_soft_decoder() {
+    using Encoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+        7u,
+        PuncturingMatrix,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+    >;
+    using Decoder = Thiemar::Convolutional::PuncturedSoftDecisionViterbiDecoder<
+        7u,
+        TracebackLength,
+        PuncturingMatrix,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+    >;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = Encoder::encode(test_in);
+    auto test_decoded = Decoder::decode(make_llrs(test_out, 0.0f));
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(SoftDecisionDecoderTest, DecodePunctured) {
+    using namespace Thiemar::Convolutional;
+
+    test_soft_decoder<48u, PuncturingMatrices::n_2_rate_1_2>();
+    test_soft_decoder<48u, PuncturingMatrices::n_2_rate_2_3>();
+    test_soft_decoder<48u, PuncturingMatrices::n_2_rate_3_4>();
+    test_soft_decoder<80u, PuncturingMatrices::n_2_rate_5_6>();
+    test_soft_decoder<112u, PuncturingMatrices::n_2_rate_7_8>();
+}
+
+using TestEncoder = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+    7u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+using TestDecoder = Thiemar::Convolutional::PuncturedSoftDecisionViterbiDecoder<
+    7u,
+    48u,
+    Thiemar::Convolutional::PuncturingMatrices::n_2_rate_1_2,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+    Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+>;
+
+TEST(SoftDecisionDecoderTest, DecodeNoisy) {
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    /* Eb/N0 of 4.5 dB at rate 1/2. */
+    auto test_out = TestEncoder::encode(test_in);
+    auto test_decoded = TestDecoder::decode(make_llrs(test_out, 0.5957f));
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(SoftDecisionDecoderTest, DecodeErasures) {
+    using TestEncoderPunctured = Thiemar::Convolutional::PuncturedConvolutionalEncoder<
+        7u,
+        Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+    >;
+    using TestDecoderPunctured = Thiemar::Convolutional::PuncturedSoftDecisionViterbiDecoder<
+        7u,
+        48u,
+        Thiemar::Convolutional::PuncturingMatrices::n_2_rate_3_4,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g11,
+        Thiemar::Convolutional::Polynomials::n_2_k_7_g12
+    >;
+
+    /* Set up test buffers. */
+    std::array<uint8_t, 1024u> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoderPunctured::encode(test_in);
+    auto test_llrs = make_llrs(test_out, 0.0f);
+
+    /* Jam a burst of symbols, and flag them as erased. */
+    std::array<uint8_t, test_llrs.size()> test_erasures = {};
+    for (std::size_t i = 1000u; i < 1004u; i++) {
+        test_llrs[i] = -test_llrs[i];
+        test_erasures[i] = 1u;
+    }
+
+    /* Erase every eleventh symbol as well. */
+    for (std::size_t i = 5u; i < test_llrs.size(); i += 11u) {
+        test_llrs[i] = -test_llrs[i];
+        test_erasures[i] = 1u;
+    }
+
+    auto test_decoded = TestDecoderPunctured::decode(test_llrs, test_erasures);
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(SoftDecisionDecoderTest, DecodeRuntimeLength) {
+    /* Packet sizes are only known at run time. */
+    for (std::size_t len : { 20u, 33u, 777u }) {
+        /* Set up test buffers. */
+        std::vector<uint8_t> test_in(len);
+        std::vector<uint8_t> test_out(TestEncoder::calculate_output_length(len));
+        std::vector<int8_t> test_llrs(test_out.size() * 8u);
+        std::vector<uint8_t> test_decoded(TestDecoder::calculate_output_length(test_llrs.size()));
+
+        /* Seed RNG for repeatibility. */
+        std::srand(123u);
+        for (std::size_t i = 0u; i < test_in.size(); i++) {
+            test_in[i] = std::rand() & 0xffu;
+        }
+
+        TestEncoder::encode(test_in.data(), test_in.size(), test_out.data());
+        for (std::size_t i = 0u; i < test_llrs.size(); i++) {
+            test_llrs[i] = (test_out[i / 8u] & (0x80u >> (i % 8u))) ? -64 : 64;
+        }
+
+        TestDecoder::decode(test_llrs.data(), test_llrs.size(), test_decoded.data());
+
+        for (std::size_t i = 0u; i < test_in.size(); i++) {
+            EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+        }
+    }
+}
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+#include "FEC/ErasureCode.h"
+#include "FEC/ReedSolomon.h"
+#include "FEC/Striping.h"
+
+#define MESSAGE_PARITY_LENGTH 32u
+#define MESSAGE_DATA_LENGTH 223u
+
+TEST(WorkerPoolTest, RunsEachTaskOnce) {
+    for (std::size_t threads : { 1u, 2u, 4u }) {
+        Thiemar::Striping::WorkerPool pool(threads);
+        EXPECT_EQ(threads, pool.num_threads());
+
+        /* Run several loops on the same pool. */
+        for (std::size_t n : { 0u, 1u, 3u, 1000u }) {
+            std::vector<std::atomic<int>> counts(n);
+            pool.run(n, [&](std::size_t i) { counts[i]++; });
+
+            for (std::size_t i = 0u; i < n; i++) {
+                EXPECT_EQ(1, counts[i].load()) << "Task " << i << " of " << n << " with " << threads << " threads";
+            }
+        }
+    }
+}
+
+TEST(StripedEncoderTest, EncodeCodewords) {
+    using TestEncoder = Thiemar::ReedSolomon::ReedSolomonEncoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, MESSAGE_PARITY_LENGTH>;
+
+    /* Not a whole number of messages, so the last codeword is shortened. */
+    std::vector<uint8_t> data(MESSAGE_DATA_LENGTH * 100u + 17u);
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < data.size(); i++) {
+        data[i] = std::rand() & 0xffu;
+    }
+
+    std::size_t num_codewords = (data.size() + MESSAGE_DATA_LENGTH - 1u) / MESSAGE_DATA_LENGTH;
+    std::vector<uint8_t> reference(num_codewords * MESSAGE_PARITY_LENGTH);
+    for (std::size_t c = 0u; c < num_codewords; c++) {
+        std::size_t offset = c * MESSAGE_DATA_LENGTH;
+        TestEncoder::encode(&data[offset], std::min<std::size_t>(MESSAGE_DATA_LENGTH, data.size() - offset),
+            &reference[c * MESSAGE_PARITY_LENGTH]);
+    }
+
+    for (std::size_t threads : { 1u, 3u }) {
+        /* Small tiles, so that there are many more tiles than threads. */
+        Thiemar::Striping::StripedEncoder striper(threads, 1024u);
+        std::vector<uint8_t> parity(reference.size());
+        striper.encode_codewords<TestEncoder, MESSAGE_DATA_LENGTH>(data.data(), data.size(), parity.data());
+
+        EXPECT_EQ(reference, parity) << threads << " threads";
+    }
+}
+
+TEST(StripedEncoderTest, EncodeShards) {
+    using TestCoder = Thiemar::ErasureCode::CauchyErasureCoder<
+        8u, Thiemar::ReedSolomon::Polynomials::m_8_285, 6u, 3u>;
+    const std::size_t len = 100000u;
+
+    std::vector<std::vector<uint8_t>> data(6u, std::vector<uint8_t>(len));
+    std::vector<std::vector<uint8_t>> reference(3u, std::vector<uint8_t>(len));
+    std::vector<std::vector<uint8_t>> parity(3u, std::vector<uint8_t>(len));
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (auto &shard : data) {
+        for (std::size_t i = 0u; i < len; i++) {
+            shard[i] = std::rand() & 0xffu;
+        }
+    }
+
+    std::vector<const uint8_t *> data_ptrs;
+    std::vector<uint8_t *> reference_ptrs, parity_ptrs;
+    for (auto &shard : data) {
+        data_ptrs.push_back(shard.data());
+    }
+
+    for (std::size_t i = 0u; i < 3u; i++) {
+        reference_ptrs.push_back(reference[i].data());
+        parity_ptrs.push_back(parity[i].data());
+    }
+
+    TestCoder::encode(data_ptrs.data(), reference_ptrs.data(), len);
+
+    Thiemar::Striping::StripedEncoder striper(4u, 4096u);
+    striper.encode_shards<TestCoder>(data_ptrs.data(), parity_ptrs.data(), len);
+
+    EXPECT_EQ(reference, parity);
+}
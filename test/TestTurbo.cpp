@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdlib>
+#include "FEC/Turbo.h"
+#include "FEC/CRC.h"
+
+using TestEncoder = Thiemar::Turbo::TurboEncoder<
+    4u,
+    Thiemar::Turbo::Interleavers::lte_1024,
+    Thiemar::Turbo::Polynomials::lte_feedback,
+    Thiemar::Turbo::Polynomials::lte_feedforward
+>;
+
+using TestDecoder = Thiemar::Turbo::TurboDecoder<
+    4u,
+    128u,
+    Thiemar::Turbo::Interleavers::lte_1024,
+    Thiemar::Turbo::Polynomials::lte_feedback,
+    Thiemar::Turbo::Polynomials::lte_feedforward
+>;
+
+/* Convert encoded bytes to LLRs for BPSK with additive Gaussian noise. */
+template <std::size_t N, std::size_t Bits>
+std::array<float, Bits> modulate(const std::array<uint8_t, N> &in, float ebn0_db) {
+    std::array<float, Bits> out;
+    float rate = (float)(TestEncoder::message_length() * 8u) / (float)Bits;
+    float sigma = std::sqrt(1.0f / (2.0f * rate * std::pow(10.0f, ebn0_db / 10.0f)));
+
+    for (std::size_t i = 0u; i < out.size(); i++) {
+        float u1 = ((float)std::rand() + 1.0f) / ((float)RAND_MAX + 2.0f);
+        float u2 = (float)std::rand() / (float)RAND_MAX;
+        float noise = sigma * std::sqrt(-2.0f * std::log(u1)) * std::cos(6.28318531f * u2);
+        float symbol = (in[i / 8u] & (0x80u >> (i % 8u))) ? -1.0f : 1.0f;
+        out[i] = 2.0f * (symbol + noise) / (sigma * sigma);
+    }
+
+    return out;
+}
+
+TEST(QPPInterleaverTest, Permutation) {
+    std::array<bool, Thiemar::Turbo::Interleavers::lte_6144::size()> test_seen = {};
+
+    for (auto i : Thiemar::Turbo::Interleavers::lte_6144::permutation) {
+        EXPECT_FALSE(test_seen[i]) << "Index repeated: " << i;
+        test_seen[i] = true;
+    }
+
+    /* Check against direct evaluation of the permutation polynomial. */
+    for (std::size_t i = 0u; i < Thiemar::Turbo::Interleavers::lte_40::size(); i++) {
+        EXPECT_EQ((3u * i + 10u * i * i) % 40u, Thiemar::Turbo::Interleavers::lte_40::permutation[i]);
+    }
+}
+
+TEST(TurboEncoderTest, Encode) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_out = TestEncoder::encode(test_in);
+    auto get_bit = [](const auto &buf, std::size_t i) { return (bool)(buf[i / 8u] & (0x80u >> (i % 8u))); };
+
+    /* Reference LTE constituent encoders, using shift registers as in TS 36.212. */
+    constexpr std::size_t K = Thiemar::Turbo::Interleavers::lte_1024::size();
+    for (std::size_t e = 0u; e < 2u; e++) {
+        bool d1 = false, d2 = false, d3 = false;
+        for (std::size_t i = 0u; i < K; i++) {
+            bool u = get_bit(test_in, e ? Thiemar::Turbo::Interleavers::lte_1024::permutation[i] : i);
+            bool a = u ^ d2 ^ d3;
+            bool z = a ^ d1 ^ d3;
+
+            if (e == 0u) {
+                EXPECT_EQ(u, get_bit(test_out, i * 3u)) << "Systematic bit differs at index " << i;
+            }
+
+            EXPECT_EQ(z, get_bit(test_out, i * 3u + 1u + e)) << "Parity bit differs at index " << i;
+            d3 = d2;
+            d2 = d1;
+            d1 = a;
+        }
+
+        for (std::size_t i = 0u; i < 3u; i++) {
+            bool u = d2 ^ d3;
+            bool z = d1 ^ d3;
+
+            EXPECT_EQ(u, get_bit(test_out, K * 3u + e * 6u + i * 2u)) << "Tail bit differs at index " << i;
+            EXPECT_EQ(z, get_bit(test_out, K * 3u + e * 6u + i * 2u + 1u)) << "Tail bit differs at index " << i;
+            d3 = d2;
+            d2 = d1;
+            d1 = false;
+        }
+    }
+}
+
+TEST(TurboDecoderTest, Decode) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_llr = modulate<TestEncoder::calculate_output_length(), TestDecoder::calculate_input_length()>(
+        TestEncoder::encode(test_in), 1.5f);
+    auto test_decoded = TestDecoder::decode(test_llr);
+
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(TurboDecoderTest, DecodeCRC) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size() - 3u; i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    uint32_t crc = Thiemar::CRCs::lte_24a::calculate(test_in.data(), test_in.size() - 3u);
+    test_in[test_in.size() - 3u] = crc >> 16u;
+    test_in[test_in.size() - 2u] = crc >> 8u;
+    test_in[test_in.size() - 1u] = crc;
+
+    auto test_llr = modulate<TestEncoder::calculate_output_length(), TestDecoder::calculate_input_length()>(
+        TestEncoder::encode(test_in), 1.5f);
+
+    std::size_t test_iterations = 0u;
+    auto test_decoded = TestDecoder::decode<16u>(test_llr, [&](const auto &out) {
+        test_iterations++;
+        return Thiemar::CRCs::lte_24a::check(out);
+    });
+
+    EXPECT_LT(test_iterations, 16u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}
+
+TEST(TurboDecoderTest, DecodeWorkerPool) {
+    /* Set up test buffers. */
+    std::array<uint8_t, TestEncoder::message_length()> test_in = {};
+
+    /* Seed RNG for repeatibility. */
+    std::srand(123u);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        test_in[i] = std::rand() & 0xffu;
+    }
+
+    auto test_llr = modulate<TestEncoder::calculate_output_length(), TestDecoder::calculate_input_length()>(
+        TestEncoder::encode(test_in), 1.5f);
+
+    /* Sub-blocks are independent, so the result does not depend on the number of threads. */
+    auto test_serial = TestDecoder::decode<4u>(test_llr, [](const auto &) { return false; });
+    for (std::size_t threads : { 1u, 3u, 8u }) {
+        Thiemar::Striping::WorkerPool pool(threads);
+        auto test_parallel = TestDecoder::decode<4u>(pool, test_llr, [](const auto &) { return false; });
+        EXPECT_EQ(test_serial, test_parallel) << "Outputs differ with " << threads << " threads";
+    }
+
+    Thiemar::Striping::WorkerPool pool(4u);
+    auto test_decoded = TestDecoder::decode(pool, test_llr);
+    for (std::size_t i = 0u; i < test_in.size(); i++) {
+        EXPECT_EQ((int)test_in[i], (int)test_decoded[i]) << "Buffers differ at index " << i;
+    }
+}